@@ -1,11 +1,12 @@
 /*********************
 
-Example code for a LIN monitor without response using HardwareSerial
+Example code for a passive LIN monitor (sniffer) using HardwareSerial
 
 Note:
-  - as listener, only register master request frames to avoid a response (-> bus conflict)
+  - monitor mode captures all frames on the bus and never sends a response. No frame IDs need to be registered
+  - data length is inferred at frame end and validated via classic or enhanced checksum
   - for AVR use NeoHWSerial for BREAK detection (install via Library manager). Also only use NeoSerial in your code, not Serial
-  - act on received frame inside callback functions. Console output below is optional 
+  - monitor callback only copies frames to a buffer, output is done in loop() to keep up with full bus load
 
 Supported (=successfully tested) boards:
  - Arduino Mega 2560      https://store.arduino.cc/products/arduino-mega-2560-rev3
@@ -88,6 +89,15 @@ Supported (=successfully tested) boards:
 
 
 
+// buffer for captured frames. Is filled by monitor callback, printed in loop()
+#define NUM_FRAMES  8                               // must be power of 2
+LIN_Slave_Base::frame_record_t  bufFrame[NUM_FRAMES];
+volatile uint8_t                idxWrite = 0;       // write index (free running), only changed by callback
+volatile uint8_t                idxRead  = 0;       // read index (free running), only changed by loop()
+volatile uint16_t               numDropped = 0;     // number of frames lost due to full buffer
+
+
+
 // call once
 void setup()
 {
@@ -100,9 +110,8 @@ void setup()
   // open LIN interface
   LIN.begin(19200);
 
-  // Register callback functions for frame IDs with expected data lengths
-  LIN.registerMasterRequestHandler(0x1A, handle_frame_0x1A, 4);
-  LIN.registerMasterRequestHandler(0x1B, handle_frame_0x1B, 6);
+  // capture all frames without response. Captured frames are passed to callback
+  LIN.setMonitorMode(true, handle_frame);
 
 } // setup()
 
@@ -110,102 +119,68 @@ void setup()
 
 void loop()
 {
-  // on byte received, call LIN slave protocol handler. Alternatively use serialEvent(), Ticker(), etc.
-  if (LIN.available())
-    LIN.handler();
-
-} // loop()
+  static uint16_t   numDroppedPrev = 0;
 
+  // call LIN slave protocol handler often, also without received byte for frame end detection. Alternatively use Ticker(), etc.
+  LIN.handler();
 
-
-// Example for user-defined frame handler
-void handle_frame_0x1A(uint8_t NumData, uint8_t* Data)
-{
-  // avoid unused parameter warning
-  (void) NumData;
-  (void) Data;
-
-  //////
-  // add code to react on received data
-  //////
-  
-  // optionally print frame
+  // print one captured frame per call to keep handler() latency low
   #if defined(SERIAL_DEBUG)
-        
-    LIN_Slave_Base::error_t   error;
-      
-    // get frame data & error status
-    error = LIN.getError();
-
-    SERIAL_DEBUG.print("ID=0x1A: ");
-    if (error != LIN_Slave_Base::NO_ERROR)
-    { 
-      SERIAL_DEBUG.print(", err=0x");
-      SERIAL_DEBUG.println(error, HEX);
-    }
-    else
+    if (idxRead != idxWrite)
     {
-      SERIAL_DEBUG.print(", data=");        
-      for (uint8_t i=0; (i < NumData); i++)
+      LIN_Slave_Base::frame_record_t  *pFrame = &(bufFrame[idxRead & (NUM_FRAMES-1)]);
+
+      SERIAL_DEBUG.print((unsigned long) (pFrame->timeStart / 1000L));
+      SERIAL_DEBUG.print("ms: ID=0x");
+      SERIAL_DEBUG.print((int) pFrame->id, HEX);
+      SERIAL_DEBUG.print((pFrame->type == LIN_Slave_Base::MONITOR_CLASSIC) ? " (classic)" : " (enhanced)");
+      if (pFrame->error != LIN_Slave_Base::NO_ERROR)
+      {
+        SERIAL_DEBUG.print(", err=0x");
+        SERIAL_DEBUG.print((int) pFrame->error, HEX);
+      }
+      SERIAL_DEBUG.print(", data=");
+      for (uint8_t i=0; (i < pFrame->numData); i++)
       {
         SERIAL_DEBUG.print("0x");
-        SERIAL_DEBUG.print((int) Data[i], HEX);
+        SERIAL_DEBUG.print((int) pFrame->data[i], HEX);
         SERIAL_DEBUG.print(" ");
       }
       SERIAL_DEBUG.println();
+      idxRead = idxRead + 1;
     }
 
+    // report dropped frames
+    if (numDropped != numDroppedPrev)
+    {
+      numDroppedPrev = numDropped;
+      SERIAL_DEBUG.print("dropped frames: ");
+      SERIAL_DEBUG.println(numDroppedPrev);
+    }
+  #else
+    idxRead = idxWrite;
   #endif // SERIAL_DEBUG
 
-  // reset state machine & error
-  LIN.resetStateMachine();
-  LIN.resetError();
-
-} // handle_frame_0x1A()
+} // loop()
 
 
 
-// Example for user-defined frame handler
-void handle_frame_0x1B(uint8_t NumData, uint8_t* Data)
+// monitor callback for all captured frames. Keep short, only copy frame
+void handle_frame(const LIN_Slave_Base::frame_record_t &Frame)
 {
-  // avoid unused parameter warning
-  (void) NumData;
-  (void) Data;
+  // buffer full -> drop frame
+  if ((uint8_t) (idxWrite - idxRead) >= NUM_FRAMES)
+  {
+    numDropped = numDropped + 1;
+    return;
+  }
+
+  // store frame
+  bufFrame[idxWrite & (NUM_FRAMES-1)] = Frame;
+  idxWrite = idxWrite + 1;
 
   //////
   // add code to react on received data
   //////
-  
-  // optionally print frame
-  #if defined(SERIAL_DEBUG)
-        
-    LIN_Slave_Base::error_t   error;
-      
-    // get frame data & error status
-    error = LIN.getError();
-
-    SERIAL_DEBUG.print("ID=0x1B: ");
-    if (error != LIN_Slave_Base::NO_ERROR)
-    { 
-      SERIAL_DEBUG.print(", err=0x");
-      SERIAL_DEBUG.println(error, HEX);
-    }
-    else
-    {
-      SERIAL_DEBUG.print(", data=");        
-      for (uint8_t i=0; (i < NumData); i++)
-      {
-        SERIAL_DEBUG.print("0x");
-        SERIAL_DEBUG.print((int) Data[i], HEX);
-        SERIAL_DEBUG.print(" ");
-      }
-      SERIAL_DEBUG.println();
-    }
-
-  #endif // SERIAL_DEBUG
-
-  // reset state machine & error
-  LIN.resetStateMachine();
-  LIN.resetError();
 
-} // handle_frame_0x1B()
+} // handle_frame()
@@ -57,87 +57,83 @@ void loop()
   // indicate core load
   digitalWrite(PIN_TOGGLE, !digitalRead(PIN_TOGGLE));
 
-  // on byte received, handle it
-  if (LIN.available())
-  {
-    // call LIN slave protocol handler often
-    LIN.handler();
-
-    // indicate error status via pin
-    digitalWrite(PIN_ERROR, LIN.getError());
-
+  // call LIN slave protocol handler often, also without received byte for timeout detection
+  LIN.handler();
 
-    // if LIN frame has finished, print it
-    if (LIN.getState() == LIN_Slave_Base::STATE_DONE)
-    {
-      LIN_Slave_Base::frame_t   Type;
-      LIN_Slave_Base::error_t   error;
-      uint8_t                   Id;
-      uint8_t                   NumData;
-      uint8_t                   Data[8];
+  // indicate error status via pin
+  digitalWrite(PIN_ERROR, LIN.getError());
 
-      // get frame data & error status
-      LIN.getFrame(Type, Id, NumData, Data);
-      error = LIN.getError();
 
-      // indicate status via pin
-      digitalWrite(PIN_ERROR, error);
-
-      // print result
-      #if defined(SERIAL_DEBUG)
-        if (Type == LIN_Slave_Base::MASTER_REQUEST)
+  // if LIN frame has finished, print it
+  if (LIN.getState() == LIN_Slave_Base::STATE_DONE)
+  {
+    LIN_Slave_Base::frame_t   Type;
+    LIN_Slave_Base::error_t   error;
+    uint8_t                   Id;
+    uint8_t                   NumData;
+    uint8_t                   Data[8];
+
+    // get frame data & error status
+    LIN.getFrame(Type, Id, NumData, Data);
+    error = LIN.getError();
+
+    // indicate status via pin
+    digitalWrite(PIN_ERROR, error);
+
+    // print result
+    #if defined(SERIAL_DEBUG)
+      if (Type == LIN_Slave_Base::MASTER_REQUEST)
+      {
+        SERIAL_DEBUG.print(LIN.nameLIN);
+        SERIAL_DEBUG.print(", request, ID=0x");
+        SERIAL_DEBUG.print(Id, HEX);
+        if (error != LIN_Slave_Base::NO_ERROR)
+        { 
+          SERIAL_DEBUG.print(", err=0x");
+          SERIAL_DEBUG.println(error, HEX);
+        }
+        else
         {
-          SERIAL_DEBUG.print(LIN.nameLIN);
-          SERIAL_DEBUG.print(", request, ID=0x");
-          SERIAL_DEBUG.print(Id, HEX);
-          if (error != LIN_Slave_Base::NO_ERROR)
-          { 
-            SERIAL_DEBUG.print(", err=0x");
-            SERIAL_DEBUG.println(error, HEX);
-          }
-          else
+          SERIAL_DEBUG.print(", data=");        
+          for (uint8_t i=0; (i < NumData); i++)
           {
-            SERIAL_DEBUG.print(", data=");        
-            for (uint8_t i=0; (i < NumData); i++)
-            {
-              SERIAL_DEBUG.print("0x");
-              SERIAL_DEBUG.print((int) Data[i], HEX);
-              SERIAL_DEBUG.print(" ");
-            }
-            SERIAL_DEBUG.println();
+            SERIAL_DEBUG.print("0x");
+            SERIAL_DEBUG.print((int) Data[i], HEX);
+            SERIAL_DEBUG.print(" ");
           }
+          SERIAL_DEBUG.println();
+        }
+      }
+      else
+      {
+        SERIAL_DEBUG.print(LIN.nameLIN);
+        SERIAL_DEBUG.print(", response, ID=0x");
+        SERIAL_DEBUG.print(Id, HEX);
+        if (error != LIN_Slave_Base::NO_ERROR)
+        { 
+          SERIAL_DEBUG.print(", err=0x");
+          SERIAL_DEBUG.println(error, HEX);
         }
         else
         {
-          SERIAL_DEBUG.print(LIN.nameLIN);
-          SERIAL_DEBUG.print(", response, ID=0x");
-          SERIAL_DEBUG.print(Id, HEX);
-          if (error != LIN_Slave_Base::NO_ERROR)
-          { 
-            SERIAL_DEBUG.print(", err=0x");
-            SERIAL_DEBUG.println(error, HEX);
-          }
-          else
+          SERIAL_DEBUG.print(", data=");        
+          for (uint8_t i=0; (i < NumData); i++)
           {
-            SERIAL_DEBUG.print(", data=");        
-            for (uint8_t i=0; (i < NumData); i++)
-            {
-              SERIAL_DEBUG.print("0x");
-              SERIAL_DEBUG.print((int) Data[i], HEX);
-              SERIAL_DEBUG.print(" ");
-            }
-            SERIAL_DEBUG.println();
+            SERIAL_DEBUG.print("0x");
+            SERIAL_DEBUG.print((int) Data[i], HEX);
+            SERIAL_DEBUG.print(" ");
           }
+          SERIAL_DEBUG.println();
         }
-      #endif // SERIAL_DEBUG
+      }
+    #endif // SERIAL_DEBUG
 
-      // reset state machine & error
-      LIN.resetStateMachine();
-      LIN.resetError();
+    // reset state machine & error
+    LIN.resetStateMachine();
+    LIN.resetError();
 
-    } // if LIN frame finished
+  } // if LIN frame finished
 
-  } // if pending byte in Rx buffer 
 
 } // loop()
 
@@ -0,0 +1,264 @@
+/**
+  \file     LIN_slave_Bench.h
+  \brief    LIN slave backends and frame driver for micro-benchmarks of the per-byte path
+  \details  Backends with a RAM buffer as serial interface, i.e. without UART and interrupts, so that only the library code
+            is measured. LIN_Slave_Bench binds the serial interface statically via LIN_Slave_Static (like all library backends),
+            LIN_Slave_BenchVirtual uses the virtual methods of LIN_Slave_Base (binding before LIN_Slave_Static), for comparison.
+            benchFrame() feeds one frame byte by byte to several nodes and reports the duration of handler() by state at call entry.
+            Is used by the host benchmark lin_bench.cpp
+  \author   Georg Icking-Konert
+*/
+
+/*-----------------------------------------------------------------------------
+  MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _LIN_SLAVE_BENCH_H_
+#define _LIN_SLAVE_BENCH_H_
+
+
+/*-----------------------------------------------------------------------------
+  INCLUDE FILES
+-----------------------------------------------------------------------------*/
+
+#include <LIN_slave_Static.h>
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL DEFINES
+-----------------------------------------------------------------------------*/
+
+/// measured phases of a frame, by state at entry of handler()
+#define LIN_BENCH_BREAK     0             //!< BREAK is pending
+#define LIN_BENCH_SYNC      1             //!< SYNC byte in STATE_SYNC
+#define LIN_BENCH_PID       2             //!< PID byte in STATE_PID, for slave response incl. callback and sending
+#define LIN_BENCH_DATA      3             //!< data byte of master request in STATE_RECEIVING_DATA
+#define LIN_BENCH_CHK       4             //!< checksum byte of master request in STATE_WAIT_FOR_CHK, incl. callback
+#define LIN_BENCH_ECHO      5             //!< echo byte of slave response in STATE_RECEIVING_ECHO
+#define LIN_BENCH_NUM       6             //!< number of measured phases
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL CLASSES
+-----------------------------------------------------------------------------*/
+
+/**
+  \brief  RAM buffer as serial interface of benchmark backends
+*/
+class LIN_Bench_Serial
+{
+  public:
+
+    uint8_t       bufRx[16];                //!< received bytes
+    uint8_t       idxRead;                  //!< read index
+    uint8_t       numRx;                    //!< number of received bytes
+    uint8_t       bufTx[16];                //!< sent bytes, i.e. slave response
+    uint8_t       numTx;                    //!< number of sent bytes
+
+    /// @brief Constructor
+    LIN_Bench_Serial(void) : idxRead(0), numRx(0), numTx(0) {}
+
+    /// @brief Receive one byte, i.e. store in empty Rx buffer
+    inline void receive(uint8_t Byte) { this->bufRx[0] = Byte; this->idxRead = 0; this->numRx = 1; }
+
+    /// @brief Check for received byte
+    inline bool available(void) { return (this->idxRead < this->numRx); }
+
+    /// @brief Read received byte
+    inline uint8_t read(void) { return this->bufRx[(this->idxRead)++]; }
+
+    /// @brief Send bytes, i.e. store in Tx buffer
+    inline void write(uint8_t Buf[], uint8_t Num)
+    {
+      for (uint8_t i = 0; (i < Num) && (this->numTx < sizeof(this->bufTx)); i++)
+        this->bufTx[(this->numTx)++] = Buf[i];
+    }
+
+}; // class LIN_Bench_Serial
+
+
+
+/**
+  \brief  Benchmark backend with static binding of serial interface
+*/
+class LIN_Slave_Bench : public LIN_Slave_Static<LIN_Slave_Bench>
+{
+  // static binding of serial interface methods in handler()
+  friend class LIN_Slave_Static<LIN_Slave_Bench>;
+
+  // PROTECTED VARIABLES
+  protected:
+
+    LIN_Bench_Serial      *pSerial;                         //!< RAM serial interface
+
+
+  // PROTECTED METHODS
+  protected:
+
+    /// @brief Get break detection flag
+    inline bool _getBreakFlag(void) { return this->flagBreak; }
+
+    /// @brief Clear break detection flag
+    inline void _resetBreakFlag(void) { this->flagBreak = false; }
+
+    /// @brief read next byte from Rx buffer
+    inline uint8_t _serialRead(void) { return this->pSerial->read(); }
+
+    /// @brief write bytes to Tx buffer
+    inline void _serialWrite(uint8_t buf[], uint8_t num) { this->pSerial->write(buf, num); }
+
+
+  // PUBLIC METHODS
+  public:
+
+    /// @brief Class constructor
+    LIN_Slave_Bench(LIN_Bench_Serial &Interface) : LIN_Slave_Static<LIN_Slave_Bench>(LIN_Slave_Base::LIN_V2, "Static") { this->pSerial = &Interface; }
+
+    /// @brief check if a byte is available in Rx buffer
+    inline bool available(void) { return this->pSerial->available(); }
+
+    /// @brief Receive BREAK, i.e. set BREAK flag like an Rx ISR
+    inline void receiveBreak(void) { this->timeBreak = micros(); this->flagBreak = true; }
+
+    /// @brief Benchmark access to PID calculation
+    inline uint8_t benchPID(uint8_t ID) { return this->_calculatePID(ID); }
+
+    /// @brief Benchmark access to checksum calculation
+    inline uint8_t benchChecksum(uint8_t NumData, uint8_t Data[], uint8_t PID) { return this->_calculateChecksum(NumData, Data, PID); }
+
+    /// @brief Benchmark access to callback lookup and call
+    inline void benchDispatch(uint8_t ID, uint8_t Data[])
+    {
+      LIN_Slave_Base::callback_t *pCallback = this->_findCallback(ID);
+      if ((pCallback != nullptr) && (pCallback->fct != nullptr))
+        pCallback->fct(8, Data);
+    }
+
+}; // class LIN_Slave_Bench
+
+
+
+/**
+  \brief  Benchmark backend with virtual serial interface methods of LIN_Slave_Base
+*/
+class LIN_Slave_BenchVirtual : public LIN_Slave_Base
+{
+  // PROTECTED VARIABLES
+  protected:
+
+    LIN_Bench_Serial      *pSerial;                         //!< RAM serial interface
+
+
+  // PROTECTED METHODS
+  protected:
+
+    /// @brief Get break detection flag
+    virtual bool _getBreakFlag(void) { return this->flagBreak; }
+
+    /// @brief Clear break detection flag
+    virtual void _resetBreakFlag(void) { this->flagBreak = false; }
+
+    /// @brief read next byte from Rx buffer
+    virtual uint8_t _serialRead(void) { return this->pSerial->read(); }
+
+    /// @brief write bytes to Tx buffer
+    virtual void _serialWrite(uint8_t buf[], uint8_t num) { this->pSerial->write(buf, num); }
+
+
+  // PUBLIC METHODS
+  public:
+
+    /// @brief Class constructor
+    LIN_Slave_BenchVirtual(LIN_Bench_Serial &Interface) : LIN_Slave_Base(LIN_Slave_Base::LIN_V2, "Virtual") { this->pSerial = &Interface; }
+
+    /// @brief check if a byte is available in Rx buffer
+    virtual bool available(void) { return this->pSerial->available(); }
+
+    /// @brief Receive BREAK, i.e. set BREAK flag like an Rx ISR
+    inline void receiveBreak(void) { this->timeBreak = micros(); this->flagBreak = true; }
+
+}; // class LIN_Slave_BenchVirtual
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL FUNCTIONS
+-----------------------------------------------------------------------------*/
+
+/**
+  \brief      Receive a frame on several nodes and measure handler() calls
+  \details    Feed BREAK, SYNC, PID and data + checksum (master request) or echo of sent response (slave response) byte by byte
+              to Num nodes in parallel. Per byte, handler() of all nodes is called in a loop, and the duration of this loop is
+              measured via Timer::now() and passed to Record(phase, duration, Num). Like this the overhead of the timer readout
+              is shared by Num calls. Nodes must be opened and have a master request or slave response handler for ID
+  \param[in]  LIN       LIN slave nodes, LIN_Slave_Bench or LIN_Slave_BenchVirtual
+  \param[in]  Interface RAM serial interfaces of nodes
+  \param[in]  Num       number of nodes
+  \param[in]  ID        frame ID (unprotected)
+  \param[in]  Request   true: master request, false: slave response
+  \param[in]  Data      data of master request incl. checksum (NumData+1 bytes)
+  \param[in]  NumData   number of data bytes
+  \param[in]  Record    functor Record(uint8_t Phase, uint32_t Duration, uint8_t Num)
+  \return     true if frame was received by all nodes without error
+*/
+template <class T, class Timer, class Recorder> bool benchFrame(T *LIN[], LIN_Bench_Serial Interface[], uint8_t Num, uint8_t ID,
+  bool Request, const uint8_t Data[], uint8_t NumData, Recorder Record)
+{
+  uint32_t  start;
+  uint8_t   phase, numBytes;
+  bool      flagOk = true;
+
+  // BREAK
+  for (uint8_t k = 0; k < Num; k++)
+    LIN[k]->receiveBreak();
+  start = Timer::now();
+  for (uint8_t k = 0; k < Num; k++)
+    LIN[k]->handler();
+  Record(LIN_BENCH_BREAK, Timer::now() - start, Num);
+
+  // SYNC
+  for (uint8_t k = 0; k < Num; k++)
+    Interface[k].receive(0x55);
+  start = Timer::now();
+  for (uint8_t k = 0; k < Num; k++)
+    LIN[k]->handler();
+  Record(LIN_BENCH_SYNC, Timer::now() - start, Num);
+
+  // PID. For slave response this sends the response
+  for (uint8_t k = 0; k < Num; k++)
+  {
+    Interface[k].numTx = 0;
+    Interface[k].receive(LIN_Slave_Protocol::getPID(ID));
+  }
+  start = Timer::now();
+  for (uint8_t k = 0; k < Num; k++)
+    LIN[k]->handler();
+  Record(LIN_BENCH_PID, Timer::now() - start, Num);
+
+  // master request: data and checksum. Slave response: echo of sent bytes
+  numBytes = Request ? (NumData + 1) : Interface[0].numTx;
+  for (uint8_t i = 0; i < numBytes; i++)
+  {
+    for (uint8_t k = 0; k < Num; k++)
+      Interface[k].receive(Request ? Data[i] : Interface[k].bufTx[i]);
+    phase = Request ? ((i < NumData) ? LIN_BENCH_DATA : LIN_BENCH_CHK) : LIN_BENCH_ECHO;
+    start = Timer::now();
+    for (uint8_t k = 0; k < Num; k++)
+      LIN[k]->handler();
+    Record(phase, Timer::now() - start, Num);
+  }
+
+  // check frames
+  for (uint8_t k = 0; k < Num; k++)
+    flagOk &= (LIN[k]->getState() == LIN_Slave_Base::STATE_DONE) && (LIN[k]->getError() == LIN_Slave_Base::NO_ERROR);
+  return flagOk;
+
+} // benchFrame()
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _LIN_SLAVE_BENCH_H_
+
+/*-----------------------------------------------------------------------------
+    END OF FILE
+-----------------------------------------------------------------------------*/
@@ -0,0 +1,544 @@
+/**
+  \file     lin_bench.cpp
+  \brief    Host micro-benchmark of the per-byte path of the LIN slave library
+  \details  Measures duration [ns] of handler() calls by state for master requests and slave responses with 1..8 data bytes,
+            both with static (LIN_Slave_Static) and virtual (LIN_Slave_Base) binding of the serial interface. Further
+            handlerDrain() per byte, idle handler() calls, PID and checksum calculation, getFrame() and callback dispatch.
+            Slave responses are measured both via callback and pre-published via publishResponse() (handler/.../published/...),
+            i.e. the PID phase compares the time from PID reception to sending the first response byte.
+            Time is virtual (see extras/host), i.e. micros() does not call the OS. Each sample is the duration of one
+            handler() call on each of LIN_BENCH_NODES nodes in the same state, corrected by the overhead of the clock readout.
+            Each benchmark reports the median and mean of its samples. The suite is repeated and the minimum over repeats is
+            reported, which suppresses disturbances by other processes.
+            Usage: lin_bench [--iterations N] [--repeat N] [--format csv|json] [--compare baseline.csv] [--thresholds file]
+            With --compare the medians are checked against a baseline from the same machine (output of --format csv), using
+            the max. increase per benchmark name prefix from the thresholds file (default extras/benchmark/thresholds.csv).
+            On regression the suite is repeated once more before reporting, and exit code is 1 on regression.
+            Only for host builds via CMake
+  \author   Georg Icking-Konert
+*/
+
+// include files
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+#include "LIN_slave_Bench.h"
+
+
+/**************************
+ * LOCAL DEFINES
+**************************/
+
+// number of nodes per measured loop of handler() calls, shares overhead of clock readout
+#define LIN_BENCH_NODES   16
+
+
+/**************************
+ * LOCAL TYPES
+**************************/
+
+// benchmark result
+typedef struct
+{
+  std::string   name;                       // benchmark name, e.g. handler/static/request/4/DATA
+  double        median;                     // median [ns]
+  double        mean;                       // mean [ns]
+  uint32_t      samples;                    // number of samples
+} result_t;
+
+// threshold for --compare
+typedef struct
+{
+  std::string   prefix;                     // benchmark name prefix, "*" = all
+  double        percent;                    // max. increase of median [%]
+  double        slack;                      // additional absolute increase [ns], for very short benchmarks
+} threshold_t;
+
+// host clock in ns
+struct TimerNs
+{
+  static inline uint32_t now(void)
+  {
+    return (uint32_t) std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+  }
+};
+
+
+/**************************
+ * LOCAL VARIABLES
+**************************/
+
+static const char           *namePhase[LIN_BENCH_NUM] = { "BREAK", "SYNC", "PID", "DATA", "CHK", "ECHO" };
+static std::vector<result_t> results;
+static double               overheadClock = 0.0;
+static volatile uint8_t     sink;
+
+
+/**************************
+ * LOCAL FUNCTIONS
+**************************/
+
+// frame callbacks: master request sums data, slave response fills data
+static void callbackRequest(uint8_t numData, uint8_t* data)
+{
+  uint8_t sum = 0;
+  for (uint8_t i = 0; i < numData; i++)
+    sum += data[i];
+  sink = sum;
+}
+
+static void callbackResponse(uint8_t numData, uint8_t* data)
+{
+  for (uint8_t i = 0; i < numData; i++)
+    data[i] = (uint8_t) (0x10 + i);
+}
+
+
+// store median and mean of samples [ns per call]
+static void addResult(const std::string &Name, std::vector<double> &Samples)
+{
+  result_t  result;
+  double    sum = 0.0;
+
+  if (Samples.empty())
+    return;
+  std::sort(Samples.begin(), Samples.end());
+  for (size_t i = 0; i < Samples.size(); i++)
+    sum += Samples[i];
+  result.name    = Name;
+  result.median  = Samples[Samples.size() / 2];
+  result.mean    = sum / Samples.size();
+  result.samples = (uint32_t) Samples.size();
+  results.push_back(result);
+}
+
+
+// store duration of a loop of Num calls as one result per call
+static void addLoop(const std::string &Name, uint32_t Duration, uint32_t Num)
+{
+  result_t  result;
+
+  result.name    = Name;
+  result.median  = (double) Duration / Num;
+  result.mean    = result.median;
+  result.samples = Num;
+  results.push_back(result);
+}
+
+
+// duration [ns] per call of a measured loop of Num calls, corrected by clock overhead
+static inline double perCall(uint32_t Duration, uint32_t Num)
+{
+  return std::max(0.0, ((double) Duration - overheadClock) / Num);
+}
+
+
+// calibrate overhead of clock readout: median of back-to-back readouts
+static double calibrateClock(uint32_t Iterations)
+{
+  std::vector<uint32_t> samples(Iterations);
+
+  for (uint32_t i = 0; i < Iterations; i++)
+  {
+    uint32_t start = TimerNs::now();
+    samples[i] = TimerNs::now() - start;
+  }
+  std::sort(samples.begin(), samples.end());
+  return (double) samples[Iterations / 2];
+}
+
+
+// handler() by state for master requests and slave responses with 1..8 bytes
+template <class T> static void benchHandler(const char *Binding, uint32_t Iterations)
+{
+  LIN_Bench_Serial        serial[LIN_BENCH_NODES];
+  T                       *LIN[LIN_BENCH_NODES];
+  std::vector<double>     samples[LIN_BENCH_NUM];
+  uint8_t                 data[9];
+  uint8_t                 numBytes;
+  uint32_t                start, duration;
+  char                    name[64];
+
+  // open nodes. Register master request 0x10+n and slave response 0x20+n with n data bytes
+  for (uint8_t k = 0; k < LIN_BENCH_NODES; k++)
+  {
+    LIN[k] = new T(serial[k]);
+    LIN[k]->begin(19200);
+    for (uint8_t n = 1; n <= 8; n++)
+    {
+      LIN[k]->registerMasterRequestHandler(0x10 + n, callbackRequest, n);
+      LIN[k]->registerSlaveResponseHandler(0x20 + n, callbackResponse, n);
+    }
+  }
+
+  // idle handler() call, i.e. no byte pending
+  for (uint32_t i = 0; i < Iterations; i++)
+  {
+    start = TimerNs::now();
+    for (uint8_t k = 0; k < LIN_BENCH_NODES; k++)
+      LIN[k]->handler();
+    samples[0].push_back(perCall(TimerNs::now() - start, LIN_BENCH_NODES));
+  }
+  snprintf(name, sizeof(name), "handler/%s/idle", Binding);
+  addResult(name, samples[0]);
+
+  // frames with 1..8 data bytes
+  for (int8_t request = 1; request >= 0; request--)
+  {
+    for (uint8_t n = 1; n <= 8; n++)
+    {
+      uint8_t id = request ? (0x10 + n) : (0x20 + n);
+
+      // master request data and checksum
+      for (uint8_t i = 0; i < n; i++)
+        data[i] = (uint8_t) (0xA0 + i);
+      data[n] = LIN_Slave_Protocol::checksum(LIN_Slave_Protocol::getSeed(id, true), data, n);
+
+      // measure frames
+      for (uint8_t k = 0; k < LIN_BENCH_NUM; k++)
+        samples[k].clear();
+      for (uint32_t i = 0; i < Iterations; i++)
+      {
+        if (!benchFrame<T, TimerNs>(LIN, serial, LIN_BENCH_NODES, id, request, data, n,
+          [&](uint8_t Phase, uint32_t Duration, uint8_t Num) { samples[Phase].push_back(perCall(Duration, Num)); }))
+        {
+          fprintf(stderr, "error: frame 0x%02X not received correctly\n", id);
+          exit(2);
+        }
+      }
+
+      // store results per phase
+      for (uint8_t k = 0; k < LIN_BENCH_NUM; k++)
+      {
+        snprintf(name, sizeof(name), "handler/%s/%s/%u/%s", Binding, request ? "request" : "response", (unsigned) n, namePhase[k]);
+        addResult(name, samples[k]);
+      }
+    }
+  }
+
+  // slave responses with 1..8 bytes published via publishResponse(), i.e. PID sends prepared data and checksum without callback
+  #if (LIN_SLAVE_NUM_RESPONSES >= 8)
+    for (uint8_t n = 1; n <= 8; n++)
+    {
+      uint8_t id = 0x20 + n;
+
+      // publish same data as callbackResponse()
+      for (uint8_t i = 0; i < n; i++)
+        data[i] = (uint8_t) (0x10 + i);
+      for (uint8_t k = 0; k < LIN_BENCH_NODES; k++)
+        LIN[k]->publishResponse(id, data, n);
+
+      // measure frames
+      for (uint8_t k = 0; k < LIN_BENCH_NUM; k++)
+        samples[k].clear();
+      for (uint32_t i = 0; i < Iterations; i++)
+      {
+        if (!benchFrame<T, TimerNs>(LIN, serial, LIN_BENCH_NODES, id, false, data, n,
+          [&](uint8_t Phase, uint32_t Duration, uint8_t Num) { samples[Phase].push_back(perCall(Duration, Num)); }))
+        {
+          fprintf(stderr, "error: published frame 0x%02X not sent correctly\n", id);
+          exit(2);
+        }
+      }
+
+      // store results per phase
+      for (uint8_t k = 0; k < LIN_BENCH_NUM; k++)
+      {
+        snprintf(name, sizeof(name), "handler/%s/published/%u/%s", Binding, (unsigned) n, namePhase[k]);
+        addResult(name, samples[k]);
+      }
+    }
+  #endif
+
+  // handlerDrain(): complete master request with 8 bytes in Rx buffer, per byte
+  samples[0].clear();
+  for (uint32_t i = 0; i < Iterations; i++)
+  {
+    // handle BREAK first, then fill Rx buffer with SYNC, PID, data and checksum
+    for (uint8_t k = 0; k < LIN_BENCH_NODES; k++)
+    {
+      LIN[k]->receiveBreak();
+      LIN[k]->handler();
+      serial[k].bufRx[0] = 0x55;
+      serial[k].bufRx[1] = LIN_Slave_Protocol::getPID(0x18);
+      for (uint8_t m = 0; m < 8; m++)
+        serial[k].bufRx[2 + m] = (uint8_t) (0xA0 + m);
+      serial[k].bufRx[10] = LIN_Slave_Protocol::checksum(LIN_Slave_Protocol::getSeed(0x18, true), serial[k].bufRx + 2, 8);
+      serial[k].idxRead = 0;
+      serial[k].numRx   = 11;
+    }
+    numBytes = 0;
+    start = TimerNs::now();
+    for (uint8_t k = 0; k < LIN_BENCH_NODES; k++)
+      numBytes += LIN[k]->handlerDrain();
+    duration = TimerNs::now() - start;
+    if (numBytes != 11 * LIN_BENCH_NODES)
+    {
+      fprintf(stderr, "error: handlerDrain() handled %u bytes\n", (unsigned) numBytes);
+      exit(2);
+    }
+    samples[0].push_back(perCall(duration, numBytes));
+  }
+  snprintf(name, sizeof(name), "handlerDrain/%s/request/8/byte", Binding);
+  addResult(name, samples[0]);
+
+  // close nodes
+  for (uint8_t k = 0; k < LIN_BENCH_NODES; k++)
+  {
+    LIN[k]->end();
+    delete LIN[k];
+  }
+}
+
+
+// PID, checksum, getFrame() and callback dispatch. Loops of calls with varying input
+static void benchFunctions(uint32_t Iterations)
+{
+  LIN_Bench_Serial        serial;
+  LIN_Slave_Bench         LIN(serial);
+  uint8_t                 data[9] = { 0xA0, 0xA1, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6, 0xA7, 0x00 };
+  uint32_t                num = Iterations * 16;
+  uint32_t                start, duration;
+  uint8_t                 sum = 0;
+  char                    name[64];
+
+  LIN.begin(19200);
+  LIN.registerMasterRequestHandler(0x18, callbackRequest, 8);
+
+  // PID of all IDs
+  start = TimerNs::now();
+  for (uint32_t i = 0; i < num; i++)
+    sum += LIN.benchPID((uint8_t) (i & 0x3F));
+  duration = TimerNs::now() - start;
+  addLoop("pid", duration, num);
+
+  // checksum with 1..8 data bytes
+  for (uint8_t n = 1; n <= 8; n++)
+  {
+    start = TimerNs::now();
+    for (uint32_t i = 0; i < num; i++)
+    {
+      data[0] = (uint8_t) i;
+      sum += LIN.benchChecksum(n, data, 0x80 | (uint8_t) (i & 0x3F));
+    }
+    duration = TimerNs::now() - start;
+    snprintf(name, sizeof(name), "checksum/%u", (unsigned) n);
+    addLoop(name, duration, num);
+  }
+
+  // callback lookup and call
+  start = TimerNs::now();
+  for (uint32_t i = 0; i < num; i++)
+  {
+    data[0] = (uint8_t) i;
+    LIN.benchDispatch(0x18, data);
+  }
+  duration = TimerNs::now() - start;
+  addLoop("dispatch", duration, num);
+
+  // getFrame() of a received master request with 8 bytes
+  for (uint8_t i = 0; i < 8; i++)
+    data[i] = (uint8_t) (0xA0 + i);
+  data[8] = LIN_Slave_Protocol::checksum(LIN_Slave_Protocol::getSeed(0x18, true), data, 8);
+  LIN_Slave_Bench *pLIN = &LIN;
+  benchFrame<LIN_Slave_Bench, TimerNs>(&pLIN, &serial, 1, 0x18, true, data, 8, [](uint8_t Phase, uint32_t Duration, uint8_t Num) { (void) Phase; (void) Duration; (void) Num; });
+  start = TimerNs::now();
+  for (uint32_t i = 0; i < num; i++)
+  {
+    LIN_Slave_Base::frame_t type;
+    uint8_t                 id, numData, buf[8];
+    LIN.getFrame(type, id, numData, buf);
+    sum += buf[i & 0x07] + id;
+  }
+  duration = TimerNs::now() - start;
+  addLoop("getFrame", duration, num);
+
+  sink = sum;
+  LIN.end();
+}
+
+
+// print results as CSV or JSON
+static void printResults(bool Json)
+{
+  if (Json)
+  {
+    printf("{\n  \"unit\": \"ns\",\n  \"results\": [\n");
+    for (size_t i = 0; i < results.size(); i++)
+      printf("    { \"name\": \"%s\", \"median\": %.1f, \"mean\": %.1f, \"samples\": %u }%s\n", results[i].name.c_str(), results[i].median,
+        results[i].mean, (unsigned) results[i].samples, (i + 1 < results.size()) ? "," : "");
+    printf("  ]\n}\n");
+  }
+  else
+  {
+    printf("name,median_ns,mean_ns,samples\n");
+    for (size_t i = 0; i < results.size(); i++)
+      printf("%s,%.1f,%.1f,%u\n", results[i].name.c_str(), results[i].median, results[i].mean, (unsigned) results[i].samples);
+  }
+}
+
+
+// read thresholds file: lines "prefix,percent,slack_ns", '#' starts a comment
+static bool readThresholds(const char *File, std::vector<threshold_t> &Thresholds)
+{
+  FILE        *fp = fopen(File, "r");
+  char        line[256], prefix[128];
+  threshold_t threshold;
+
+  if (fp == NULL)
+    return false;
+  while (fgets(line, sizeof(line), fp) != NULL)
+  {
+    if ((line[0] == '#') || (sscanf(line, "%127[^,],%lf,%lf", prefix, &threshold.percent, &threshold.slack) != 3))
+      continue;
+    threshold.prefix = prefix;
+    Thresholds.push_back(threshold);
+  }
+  fclose(fp);
+  return true;
+}
+
+
+// compare medians with baseline CSV. Longest matching prefix selects threshold. Returns number of regressions, prints them if Report
+static int compareResults(const char *File, const std::vector<threshold_t> &Thresholds, bool Report)
+{
+  FILE        *fp = fopen(File, "r");
+  char        line[256], name[128];
+  double      median, mean;
+  unsigned    samples;
+  int         numRegress = 0, numCompared = 0;
+
+  if (fp == NULL)
+  {
+    fprintf(stderr, "error: cannot open baseline %s\n", File);
+    return -1;
+  }
+  while (fgets(line, sizeof(line), fp) != NULL)
+  {
+    if (sscanf(line, "%127[^,],%lf,%lf,%u", name, &median, &mean, &samples) != 4)
+      continue;
+    for (size_t i = 0; i < results.size(); i++)
+    {
+      if (results[i].name != name)
+        continue;
+
+      // find threshold with longest matching prefix
+      const threshold_t *pThreshold = NULL;
+      for (size_t k = 0; k < Thresholds.size(); k++)
+      {
+        const threshold_t &t = Thresholds[k];
+        if (((t.prefix == "*") || (results[i].name.compare(0, t.prefix.size(), t.prefix) == 0)) &&
+          ((pThreshold == NULL) || (pThreshold->prefix == "*") || (t.prefix.size() > pThreshold->prefix.size())))
+          pThreshold = &t;
+      }
+      if (pThreshold == NULL)
+        continue;
+
+      // check increase of median
+      numCompared++;
+      double limit = median * (1.0 + pThreshold->percent / 100.0) + pThreshold->slack;
+      if (results[i].median > limit)
+      {
+        numRegress++;
+        if (Report)
+          fprintf(stderr, "REGRESSION %s: %.1f ns > %.1f ns (baseline %.1f ns, +%.0f%% +%.1f ns)\n", name, results[i].median, limit, median,
+            pThreshold->percent, pThreshold->slack);
+      }
+    }
+  }
+  fclose(fp);
+  if (Report)
+    fprintf(stderr, "compared %d benchmarks, %d regressions\n", numCompared, numRegress);
+  return numRegress;
+}
+
+
+// keep minimum per benchmark over repeats of the suite
+static void mergeResults(std::vector<result_t> &Best)
+{
+  if (Best.empty())
+    Best = results;
+  for (size_t i = 0; (i < Best.size()) && (i < results.size()); i++)
+  {
+    Best[i].median = std::min(Best[i].median, results[i].median);
+    Best[i].mean   = std::min(Best[i].mean, results[i].mean);
+  }
+  results.clear();
+}
+
+
+// run benchmark suite Repeat times and keep minimum per benchmark in results
+static void runSuite(uint32_t Iterations, uint32_t Repeat, std::vector<result_t> &Best)
+{
+  for (uint32_t i = 0; i < Repeat; i++)
+  {
+    overheadClock = calibrateClock(Iterations);
+    benchHandler<LIN_Slave_Bench>("static", Iterations);
+    benchHandler<LIN_Slave_BenchVirtual>("virtual", Iterations);
+    benchFunctions(Iterations);
+    mergeResults(Best);
+  }
+  results = Best;
+}
+
+
+int main(int argc, char *argv[])
+{
+  uint32_t                  iterations = 10000;
+  uint32_t                  repeat = 5;
+  bool                      json = false, flagUsage = false;
+  std::vector<result_t>     best;
+  const char                *fileBaseline = NULL;
+  const char                *fileThresholds = LIN_BENCH_THRESHOLDS;
+  std::vector<threshold_t>  thresholds;
+
+  // parse options
+  for (int i = 1; i + 1 < argc; i += 2)
+  {
+    if (strcmp(argv[i], "--iterations") == 0)
+      iterations = (uint32_t) strtoul(argv[i + 1], NULL, 0);
+    else if (strcmp(argv[i], "--repeat") == 0)
+      repeat = (uint32_t) strtoul(argv[i + 1], NULL, 0);
+    else if (strcmp(argv[i], "--format") == 0)
+      json = (strcmp(argv[i + 1], "json") == 0);
+    else if (strcmp(argv[i], "--compare") == 0)
+      fileBaseline = argv[i + 1];
+    else if (strcmp(argv[i], "--thresholds") == 0)
+      fileThresholds = argv[i + 1];
+    else
+      flagUsage = true;
+  }
+  if (flagUsage || (argc % 2 == 0) || (iterations < 1) || (repeat < 1))
+  {
+    fprintf(stderr, "usage: %s [--iterations N] [--repeat N] [--format csv|json] [--compare baseline.csv] [--thresholds file]\n", argv[0]);
+    return 1;
+  }
+
+  // virtual time, i.e. micros() is constant and does not call the OS
+  ArduinoHost::useVirtualTime(true);
+  ArduinoHost::setMicros(1000000);
+
+  if ((fileBaseline != NULL) && !readThresholds(fileThresholds, thresholds))
+  {
+    fprintf(stderr, "error: cannot open thresholds %s\n", fileThresholds);
+    return 1;
+  }
+
+  // run benchmarks
+  runSuite(iterations, repeat, best);
+
+  // on regression vs. baseline repeat suite, i.e. only report regressions which persist over a longer time than a disturbance
+  if ((fileBaseline != NULL) && (compareResults(fileBaseline, thresholds, false) != 0))
+    runSuite(iterations, repeat, best);
+
+  // print results and optionally compare with baseline
+  printResults(json);
+  if (fileBaseline != NULL)
+    return (compareResults(fileBaseline, thresholds, true) == 0) ? 0 : 1;
+
+  return 0;
+}
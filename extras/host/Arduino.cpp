@@ -0,0 +1,312 @@
+/**
+  \file     Arduino.cpp
+  \brief    Minimal Arduino core shim for building the library on a host PC (Linux)
+  \details  Implementation of Arduino.h. Only for host builds via CMake
+  \author   Georg Icking-Konert
+*/
+
+// include files
+#include <Arduino.h>
+#include <stdio.h>
+#include <time.h>
+
+
+/*-----------------------------------------------------------------------------
+  MODULE VARIABLES
+-----------------------------------------------------------------------------*/
+
+// virtual clock of current thread
+static thread_local bool      flagVirtualTime = false;
+static thread_local uint64_t  timeVirtual = 0;
+
+// emulated pin states of current thread
+static thread_local uint8_t   statePins[ARDUINO_HOST_NUM_PINS];
+
+// serial interfaces. Serial forwards output to stdout
+HardwareSerial Serial(true);
+HardwareSerial Serial1;
+HardwareSerial Serial2;
+
+
+
+/*-----------------------------------------------------------------------------
+  HOST EXTENSIONS
+-----------------------------------------------------------------------------*/
+
+/**
+  \brief      Read monotonic system clock
+  \details    Read monotonic system clock in [us]
+  \return     system time [us]
+*/
+static uint64_t _monotonicMicros(void)
+{
+  struct timespec   ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t) ts.tv_sec * 1000000ULL + (uint64_t) ts.tv_nsec / 1000ULL;
+
+} // _monotonicMicros()
+
+
+
+/**
+  \brief      Use virtual or real clock
+  \details    Use virtual clock (true) or real monotonic clock (false, default) for micros() and millis() of calling thread
+  \param[in]  Enable    use virtual clock
+*/
+void ArduinoHost::useVirtualTime(bool Enable)
+{
+  flagVirtualTime = Enable;
+
+} // ArduinoHost::useVirtualTime()
+
+
+
+/**
+  \brief      Set virtual time
+  \details    Set virtual time [us] of calling thread
+  \param[in]  Time    new virtual time [us]
+*/
+void ArduinoHost::setMicros(uint64_t Time)
+{
+  timeVirtual = Time;
+
+} // ArduinoHost::setMicros()
+
+
+
+/**
+  \brief      Advance virtual time
+  \details    Advance virtual time [us] of calling thread
+  \param[in]  Delta    time increment [us]
+*/
+void ArduinoHost::advanceMicros(uint64_t Delta)
+{
+  timeVirtual += Delta;
+
+} // ArduinoHost::advanceMicros()
+
+
+
+/**
+  \brief      Get current time
+  \details    Get current time [us] of calling thread without 32-bit wrap-around. Real clock starts at first call
+  \return     current time [us]
+*/
+uint64_t ArduinoHost::getMicros(void)
+{
+  // virtual clock
+  if (flagVirtualTime)
+    return timeVirtual;
+
+  // real monotonic clock relative to first call. Note: static initialization is thread-safe
+  static const uint64_t timeStart = _monotonicMicros();
+  return _monotonicMicros() - timeStart;
+
+} // ArduinoHost::getMicros()
+
+
+
+/*-----------------------------------------------------------------------------
+  ARDUINO FUNCTIONS
+-----------------------------------------------------------------------------*/
+
+unsigned long micros(void)
+{
+  // wrap around after 2^32us like on Arduino
+  return (unsigned long) (uint32_t) ArduinoHost::getMicros();
+}
+
+unsigned long millis(void)
+{
+  return (unsigned long) (uint32_t) (ArduinoHost::getMicros() / 1000ULL);
+}
+
+void delay(unsigned long ms)
+{
+  delayMicroseconds(ms * 1000UL);
+}
+
+void delayMicroseconds(unsigned int us)
+{
+  // advance virtual clock
+  if (flagVirtualTime)
+  {
+    timeVirtual += us;
+    return;
+  }
+
+  // busy wait on real clock
+  uint64_t timeStart = ArduinoHost::getMicros();
+  while (ArduinoHost::getMicros() - timeStart < us);
+}
+
+void pinMode(uint8_t pin, uint8_t mode)
+{
+  (void) pin;
+  (void) mode;
+}
+
+void digitalWrite(uint8_t pin, uint8_t val)
+{
+  if (pin < ARDUINO_HOST_NUM_PINS)
+    statePins[pin] = (val != LOW) ? HIGH : LOW;
+}
+
+int digitalRead(uint8_t pin)
+{
+  return (pin < ARDUINO_HOST_NUM_PINS) ? statePins[pin] : LOW;
+}
+
+
+
+/*-----------------------------------------------------------------------------
+  CLASS PRINT
+-----------------------------------------------------------------------------*/
+
+size_t Print::_printNumber(unsigned long num, int base)
+{
+  char  buf[8 * sizeof(unsigned long) + 1];
+  char  *str = &buf[sizeof(buf) - 1];
+
+  // convert from least significant digit
+  *str = '\0';
+  if (base < 2)
+    base = 10;
+  do
+  {
+    char digit = (char) (num % base);
+    num /= base;
+    *--str = (digit < 10) ? (char) (digit + '0') : (char) (digit + 'A' - 10);
+  } while (num);
+
+  return this->print(str);
+}
+
+size_t Print::print(const char str[])         { return this->write((const uint8_t*) str, strlen(str)); }
+size_t Print::print(char c)                   { return this->write((uint8_t) c); }
+size_t Print::print(unsigned char num, int base) { return this->_printNumber(num, base); }
+size_t Print::print(unsigned int num, int base)  { return this->_printNumber(num, base); }
+size_t Print::print(unsigned long num, int base) { return this->_printNumber(num, base); }
+size_t Print::print(int num, int base)        { return this->print((long) num, base); }
+size_t Print::print(long num, int base)
+{
+  // only decimal numbers are signed
+  if ((base == DEC) && (num < 0))
+    return this->print('-') + this->_printNumber((unsigned long) (-num), DEC);
+  return this->_printNumber((unsigned long) num, base);
+}
+
+size_t Print::println(void)                   { return this->print("\r\n"); }
+size_t Print::println(const char str[])       { return this->print(str) + this->println(); }
+size_t Print::println(char c)                 { return this->print(c) + this->println(); }
+size_t Print::println(unsigned char num, int base) { return this->print(num, base) + this->println(); }
+size_t Print::println(int num, int base)      { return this->print(num, base) + this->println(); }
+size_t Print::println(unsigned int num, int base)  { return this->print(num, base) + this->println(); }
+size_t Print::println(long num, int base)     { return this->print(num, base) + this->println(); }
+size_t Print::println(unsigned long num, int base) { return this->print(num, base) + this->println(); }
+
+
+
+/*-----------------------------------------------------------------------------
+  CLASS HARDWARESERIAL
+-----------------------------------------------------------------------------*/
+
+HardwareSerial::HardwareSerial(bool ToStdout)
+{
+  this->headRx      = 0;
+  this->tailRx      = 0;
+  this->headTx      = 0;
+  this->tailTx      = 0;
+  this->baudrate    = 0;
+  this->numOverflow = 0;
+  this->flagStdout  = ToStdout;
+}
+
+void HardwareSerial::begin(unsigned long Baudrate, uint8_t Config)
+{
+  (void) Config;
+  this->baudrate = (uint32_t) Baudrate;
+}
+
+void HardwareSerial::end(void)
+{
+  // discard pending data like a closed UART
+  this->baudrate = 0;
+  this->tailRx   = this->headRx;
+}
+
+int HardwareSerial::available(void)
+{
+  return (int) (uint16_t) (this->headRx - this->tailRx);
+}
+
+int HardwareSerial::peek(void)
+{
+  if (this->headRx == this->tailRx)
+    return -1;
+  return this->bufRx[this->tailRx % BUFLEN];
+}
+
+int HardwareSerial::read(void)
+{
+  if (this->headRx == this->tailRx)
+    return -1;
+  return this->bufRx[(this->tailRx++) % BUFLEN];
+}
+
+size_t HardwareSerial::write(uint8_t c)
+{
+  // optionally forward to stdout, e.g. debug output
+  if (this->flagStdout)
+  {
+    putchar(c);
+    return 1;
+  }
+
+  // store in Tx buffer, drop oldest byte if full
+  if ((uint16_t) (this->headTx - this->tailTx) >= BUFLEN)
+    this->tailTx++;
+  this->bufTx[(this->headTx++) % BUFLEN] = c;
+  return 1;
+}
+
+bool HardwareSerial::hostReceive(uint8_t Byte, bool FrameError, uint32_t Time)
+{
+  // buffer full -> drop byte like a UART overrun
+  if ((uint16_t) (this->headRx - this->tailRx) >= BUFLEN)
+  {
+    this->numOverflow++;
+    return false;
+  }
+
+  // store byte with error flag and time
+  this->bufRx[this->headRx % BUFLEN]  = Byte;
+  this->errRx[this->headRx % BUFLEN]  = FrameError;
+  this->timeRx[this->headRx % BUFLEN] = Time;
+  this->headRx++;
+  return true;
+}
+
+bool HardwareSerial::hostFrameError(void)
+{
+  return (this->headRx != this->tailRx) && this->errRx[this->tailRx % BUFLEN];
+}
+
+uint32_t HardwareSerial::hostReceiveTime(void)
+{
+  return (this->headRx != this->tailRx) ? this->timeRx[this->tailRx % BUFLEN] : 0;
+}
+
+uint16_t HardwareSerial::hostTransmit(uint8_t Buf[], uint16_t Max)
+{
+  uint16_t  num = 0;
+
+  while ((num < Max) && (this->headTx != this->tailTx))
+    Buf[num++] = this->bufTx[(this->tailTx++) % BUFLEN];
+  return num;
+}
+
+/*-----------------------------------------------------------------------------
+    END OF FILE
+-----------------------------------------------------------------------------*/
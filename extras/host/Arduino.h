@@ -0,0 +1,258 @@
+/**
+  \file     Arduino.h
+  \brief    Minimal Arduino core shim for building the library on a host PC (Linux)
+  \details  Provides the subset of the Arduino API used by this library, i.e. time, pins, interrupt lock, Print/Stream and
+            HardwareSerial. Time is either the real monotonic clock or a virtual clock, see namespace ArduinoHost.
+            Virtual clock and pin states are thread-local, i.e. independent simulations can run in parallel threads.
+            Only for host builds via CMake, see CMakeLists.txt in the root folder. Not used by the Arduino IDE
+  \author   Georg Icking-Konert
+*/
+
+/*-----------------------------------------------------------------------------
+  MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _ARDUINO_HOST_H_
+#define _ARDUINO_HOST_H_
+
+
+/*-----------------------------------------------------------------------------
+  INCLUDE FILES
+-----------------------------------------------------------------------------*/
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdlib.h>
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL DEFINES
+-----------------------------------------------------------------------------*/
+
+// pin levels and modes
+#define LOW             0x0
+#define HIGH            0x1
+#define INPUT           0x0
+#define OUTPUT          0x1
+#define INPUT_PULLUP    0x2
+
+// number formats for Print
+#define DEC             10
+#define HEX             16
+#define BIN             2
+
+// serial configurations (only 8N1 is supported)
+#define SERIAL_8N1      0x06
+
+// no flash memory on host
+#define PROGMEM
+#define F(str)          (str)
+
+/// number of emulated digital pins
+#define ARDUINO_HOST_NUM_PINS   64
+
+// Arduino types
+typedef bool      boolean;
+typedef uint8_t   byte;
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL FUNCTIONS
+-----------------------------------------------------------------------------*/
+
+/// @brief Time [us] since start, wraps around after 71 minutes like on 32-bit Arduino cores
+unsigned long micros(void);
+
+/// @brief Time [ms] since start
+unsigned long millis(void);
+
+/// @brief Wait [ms]. Advances virtual clock, if active
+void delay(unsigned long ms);
+
+/// @brief Wait [us]. Advances virtual clock, if active
+void delayMicroseconds(unsigned int us);
+
+/// @brief Set pin mode. Only stored
+void pinMode(uint8_t pin, uint8_t mode);
+
+/// @brief Set pin level. Only stored, see digitalRead()
+void digitalWrite(uint8_t pin, uint8_t val);
+
+/// @brief Read last written pin level
+int digitalRead(uint8_t pin);
+
+/// @brief Disable interrupts. Dummy, as host has no ISRs
+inline void noInterrupts(void) { }
+
+/// @brief Enable interrupts. Dummy, as host has no ISRs
+inline void interrupts(void) { }
+
+/// @brief Yield to other tasks. Dummy
+inline void yield(void) { }
+
+
+/**
+  \brief  Host specific extensions, e.g. virtual clock for deterministic tests and simulation
+*/
+namespace ArduinoHost
+{
+  /// @brief Use virtual clock (true) or real monotonic clock (false, default) for micros() and millis() of calling thread
+  void useVirtualTime(bool Enable);
+
+  /// @brief Set virtual time [us] of calling thread
+  void setMicros(uint64_t Time);
+
+  /// @brief Advance virtual time [us] of calling thread
+  void advanceMicros(uint64_t Delta);
+
+  /// @brief Get current time [us] of calling thread without 32-bit wrap-around
+  uint64_t getMicros(void);
+
+} // namespace ArduinoHost
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL CLASSES
+-----------------------------------------------------------------------------*/
+
+/**
+  \brief  Output stream, subset of Arduino Print class
+*/
+class Print
+{
+  public:
+
+    /// @brief Write one byte
+    virtual size_t write(uint8_t c) = 0;
+
+    /// @brief Write bytes
+    virtual size_t write(const uint8_t *buf, size_t num)
+    {
+      size_t n = 0;
+      while (num--)
+        n += this->write(*buf++);
+      return n;
+    }
+
+    /// @brief Virtual destructor
+    virtual ~Print(void) { }
+
+    size_t print(const char str[]);
+    size_t print(char c);
+    size_t print(unsigned char num, int base = DEC);
+    size_t print(int num, int base = DEC);
+    size_t print(unsigned int num, int base = DEC);
+    size_t print(long num, int base = DEC);
+    size_t print(unsigned long num, int base = DEC);
+    size_t println(void);
+    size_t println(const char str[]);
+    size_t println(char c);
+    size_t println(unsigned char num, int base = DEC);
+    size_t println(int num, int base = DEC);
+    size_t println(unsigned int num, int base = DEC);
+    size_t println(long num, int base = DEC);
+    size_t println(unsigned long num, int base = DEC);
+
+  private:
+
+    /// @brief Print unsigned number in given base
+    size_t _printNumber(unsigned long num, int base);
+
+}; // class Print
+
+
+
+/**
+  \brief  Input/output stream, subset of Arduino Stream class
+*/
+class Stream : public Print
+{
+  public:
+    virtual int available(void) = 0;
+    virtual int read(void) = 0;
+    virtual int peek(void) = 0;
+    virtual void flush(void) { }
+
+}; // class Stream
+
+
+
+/**
+  \brief  Host serial interface
+
+  \details Host serial interface without hardware. Received bytes are injected via hostReceive() incl. framing error and
+           receive time, sent bytes are fetched via hostTransmit(). Optionally output is forwarded to stdout, e.g. for debug output.
+           Only one thread may access an instance
+*/
+class HardwareSerial : public Stream
+{
+  public:
+
+    /// size of receive and transmit buffers
+    static const uint16_t   BUFLEN = 256;
+
+  protected:
+
+    uint8_t         bufRx[BUFLEN];      //!< receive buffer (ring)
+    bool            errRx[BUFLEN];      //!< framing error flag per received byte
+    uint32_t        timeRx[BUFLEN];     //!< receive time [us] per byte
+    uint16_t        headRx, tailRx;     //!< receive ring indices (free running)
+    uint8_t         bufTx[BUFLEN];      //!< transmit buffer (ring)
+    uint16_t        headTx, tailTx;     //!< transmit ring indices (free running)
+    uint32_t        baudrate;           //!< configured baudrate [Baud], 0 = closed
+    uint32_t        numOverflow;        //!< number of receive bytes lost due to full buffer
+    bool            flagStdout;         //!< forward sent bytes to stdout
+
+  public:
+
+    /// @brief Constructor. Optionally forward sent bytes to stdout
+    HardwareSerial(bool ToStdout = false);
+
+    void begin(unsigned long Baudrate, uint8_t Config = SERIAL_8N1);
+    void end(void);
+    operator bool(void) { return true; }
+    int available(void);
+    int peek(void);
+    int read(void);
+    void flush(void) { }
+    size_t write(uint8_t c);
+    using Print::write;
+
+    /// @brief Host: inject a received byte, optionally with framing error (e.g. BREAK). Returns false on buffer overflow
+    bool hostReceive(uint8_t Byte, bool FrameError = false, uint32_t Time = micros());
+
+    /// @brief Host: framing error flag of next received byte (false if none)
+    bool hostFrameError(void);
+
+    /// @brief Host: receive time [us] of next received byte (0 if none)
+    uint32_t hostReceiveTime(void);
+
+    /// @brief Host: fetch sent bytes. Returns number of bytes copied
+    uint16_t hostTransmit(uint8_t Buf[], uint16_t Max);
+
+    /// @brief Host: number of sent bytes not yet fetched via hostTransmit()
+    uint16_t hostTransmitPending(void) { return (uint16_t) (this->headTx - this->tailTx); }
+
+    /// @brief Host: configured baudrate [Baud], 0 = closed
+    uint32_t hostBaudrate(void) { return this->baudrate; }
+
+    /// @brief Host: number of received bytes lost due to full buffer
+    uint32_t hostOverflow(void) { return this->numOverflow; }
+
+}; // class HardwareSerial
+
+
+// serial interfaces. Serial forwards output to stdout
+extern HardwareSerial Serial;
+extern HardwareSerial Serial1;
+extern HardwareSerial Serial2;
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _ARDUINO_HOST_H_
+
+/*-----------------------------------------------------------------------------
+    END OF FILE
+-----------------------------------------------------------------------------*/
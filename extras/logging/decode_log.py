@@ -0,0 +1,110 @@
+#!/usr/bin/env python3
+"""
+  \file     decode_log.py
+  \brief    Decoder for binary event log of LIN slave library
+  \details  Decode binary records written by LIN_Slave_Base::drainLog() to readable text.
+            Input is either a file with the raw serial output, or a serial port (requires pyserial).
+            Record format (8 bytes): marker 0xA5, event, ID, data, time [us] (32-bit little endian).
+            Decoder re-synchronizes on the marker, e.g. if the log is mixed with other output.
+            Event codes must be kept in sync with LIN_Slave_Base::log_event_t
+  \author   Georg Icking-Konert
+
+  Usage:
+    python3 decode_log.py log.bin
+    python3 decode_log.py -p /dev/ttyUSB0 -b 115200
+"""
+
+import argparse
+import struct
+import sys
+
+
+# record marker and size, see LIN_SLAVE_LOG_MARKER
+LOG_MARKER = 0xA5
+LOG_SIZE   = 8
+
+# event codes and meaning of data byte, see LIN_Slave_Base::log_event_t
+LOG_EVENTS = {
+    0x01: ("BREAK",      ""),
+    0x02: ("SYNC_ERROR", "rx"),
+    0x03: ("PID_ERROR",  "pid"),
+    0x04: ("IGNORE",     "pid"),
+    0x05: ("REQUEST",    "len"),
+    0x06: ("RESPONSE",   "len"),
+    0x07: ("ECHO_ERROR", "rx"),
+    0x08: ("CHK_ERROR",  "chk"),
+    0x09: ("FRAME_OK",   "len"),
+    0x0A: ("TIMEOUT",    "state"),
+    0x0B: ("LOST",       "num"),
+    0x0C: ("RESYNC",     "score"),
+}
+
+
+def decode(stream, out=sys.stdout):
+    """ Decode records from a byte stream and print them. Returns number of decoded records """
+    buf = bytearray()
+    time_prev = None
+    num = 0
+
+    while True:
+        chunk = stream.read(64)
+        if not chunk:
+            break
+        buf.extend(chunk)
+
+        # decode all complete records in buffer
+        while len(buf) >= LOG_SIZE:
+
+            # no valid record -> skip one byte and re-sync on marker
+            if (buf[0] != LOG_MARKER) or (buf[1] not in LOG_EVENTS):
+                del buf[0]
+                continue
+
+            # decode record
+            _, event, ident, data, time = struct.unpack("<BBBBI", bytes(buf[:LOG_SIZE]))
+            del buf[:LOG_SIZE]
+            name, label = LOG_EVENTS[event]
+
+            # time difference to previous record, handle micros() wrap-around. LOST time is time of drain -> ignore
+            if event == 0x0B:
+                delta = 0
+            else:
+                delta = 0 if time_prev is None else (time - time_prev) & 0xFFFFFFFF
+                time_prev = time
+
+            # print record
+            text = "%10u us  +%8u us  %-10s  ID 0x%02X" % (time, delta, name, ident)
+            if label:
+                text += "  %s 0x%02X" % (label, data)
+            print(text, file=out)
+            num += 1
+
+    return num
+
+
+def main():
+    parser = argparse.ArgumentParser(description="decode binary event log of LIN slave library")
+    parser.add_argument("file", nargs="?", help="file with raw log output (default: stdin)")
+    parser.add_argument("-p", "--port", help="read from serial port instead of file")
+    parser.add_argument("-b", "--baud", type=int, default=115200, help="baudrate of serial port (default: 115200)")
+    args = parser.parse_args()
+
+    # read from serial port until Ctrl-C
+    if args.port:
+        import serial
+        with serial.Serial(args.port, args.baud, timeout=None) as port:
+            try:
+                decode(port)
+            except KeyboardInterrupt:
+                pass
+
+    # read from file or stdin
+    elif args.file:
+        with open(args.file, "rb") as f:
+            decode(f)
+    else:
+        decode(sys.stdin.buffer)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,749 @@
+/**
+  \file     LIN_bus_sim.cpp
+  \brief    Discrete-event LIN bus simulator for host builds
+  \details  Implementation of LIN_bus_sim.h. Only for host builds via CMake
+  \author   Georg Icking-Konert
+*/
+
+// include files
+#include <math.h>
+#include <LIN_slave_Protocol.h>
+#include "LIN_bus_sim.h"
+
+
+/**************************
+ * PROTECTED METHODS
+**************************/
+
+/**
+  \brief      Random number
+  \details    Random number via xorshift64. Deterministic for a given seed, independent of C library
+  \return     random number 0..2^64-1
+*/
+uint64_t LIN_Bus_Sim::_random(void)
+{
+  // xorshift64 step
+  this->stateRandom ^= this->stateRandom << 13;
+  this->stateRandom ^= this->stateRandom >> 7;
+  this->stateRandom ^= this->stateRandom << 17;
+  return this->stateRandom;
+
+} // LIN_Bus_Sim::_random()
+
+
+
+/**
+  \brief      Draw bit time of next noise glitch
+  \details    Draw index of bit time with next dominant glitch. Distance is geometrically distributed, i.e. each bit time
+              is disturbed with probability config.noise. Glitches are events, i.e. also disturb skipped idle bit times
+*/
+void LIN_Bus_Sim::_nextNoise(void)
+{
+  double  u;
+
+  // no noise -> never
+  if (this->config.noise <= 0.0)
+  {
+    this->tickNoise = UINT64_MAX;
+    return;
+  }
+
+  // uniform random number in (0,1] -> geometric distance >= 1
+  u = ((double) (this->_random() >> 11) + 1.0) / 9007199254740992.0;
+  this->tickNoise = this->tick + 1 + (uint64_t) (log(u) / log(1.0 - this->config.noise));
+
+} // LIN_Bus_Sim::_nextNoise()
+
+
+
+/**
+  \brief      Add a UART byte to a transmitter
+  \details    Add start bit, 8 data bits (LSB first), stop bit and optional space (recessive) to transmit queue
+  \param[in]  Tx          transmitter
+  \param[in]  Byte        byte to send
+  \param[in]  BitsSpace   number of recessive bits after stop bit (max. 22)
+*/
+void LIN_Bus_Sim::_sendByte(LIN_Bus_Sim::transmitter_t &Tx, uint8_t Byte, uint8_t BitsSpace)
+{
+  LIN_Bus_Sim::symbol_t   symbol;
+
+  // start bit = 0, data, stop bit and space = 1
+  symbol.num  = 10 + BitsSpace;
+  symbol.bits = ((uint32_t) Byte << 1) | (((1UL << (1 + BitsSpace)) - 1) << 9);
+  Tx.queue.push_back(symbol);
+
+} // LIN_Bus_Sim::_sendByte()
+
+
+
+/**
+  \brief      Get bus level driven by a transmitter
+  \details    Get bus level driven by a transmitter in current bit time and advance to next bit. Idle transmitter is recessive
+  \param[in]  Tx    transmitter
+  \return     driven level (0 = dominant, 1 = recessive)
+*/
+uint8_t LIN_Bus_Sim::_transmitBit(LIN_Bus_Sim::transmitter_t &Tx)
+{
+  uint8_t   level;
+
+  // idle -> recessive
+  if (Tx.queue.empty())
+    return 1;
+
+  // next bit of current symbol, LSB first
+  level = (uint8_t) ((Tx.queue.front().bits >> Tx.idxBit) & 0x01);
+  if (++(Tx.idxBit) >= Tx.queue.front().num)
+  {
+    Tx.queue.pop_front();
+    Tx.idxBit = 0;
+  }
+  return level;
+
+} // LIN_Bus_Sim::_transmitBit()
+
+
+
+/**
+  \brief      Sample bus level by a receiver
+  \details    Sample bus level in current bit time by a UART receiver (8N1). A falling edge starts a byte. A dominant stop bit
+              is a framing error, e.g. BREAK. After a framing error the receiver waits for a recessive level before the next start bit
+  \param[in]  Rx          receiver
+  \param[in]  Level       bus level (0 = dominant, 1 = recessive)
+  \param[out] Byte        received byte
+  \param[out] FrameError  byte has framing error
+  \return     true if a byte was received in this bit time
+*/
+bool LIN_Bus_Sim::_receiveBit(LIN_Bus_Sim::receiver_t &Rx, uint8_t Level, uint8_t &Byte, bool &FrameError)
+{
+  // after framing error wait for recessive level
+  if (Rx.flagWaitIdle)
+  {
+    Rx.flagWaitIdle = (Level == 0);
+    return false;
+  }
+
+  // idle: dominant level is start bit
+  if (Rx.idxBit == 0)
+  {
+    if (Level == 0)
+    {
+      Rx.idxBit    = 1;
+      Rx.shift     = 0x00;
+      Rx.tickStart = this->tick;
+    }
+    return false;
+  }
+
+  // data bits, LSB first
+  if (Rx.idxBit <= 8)
+  {
+    Rx.shift |= (uint8_t) (Level << (Rx.idxBit - 1));
+    Rx.idxBit++;
+    return false;
+  }
+
+  // stop bit: dominant is framing error
+  Rx.idxBit = 0;
+  Byte = Rx.shift;
+  FrameError = (Level == 0);
+  Rx.flagWaitIdle = FrameError;
+  return true;
+
+} // LIN_Bus_Sim::_receiveBit()
+
+
+
+/**
+  \brief      Sample bus level by a slave receiver
+  \details    Sample bus level in current bit time by the UART receiver (8N1) of a slave at the baudrate of its serial interface,
+              i.e. bits are sampled in the middle of the slave bit times, which may differ from the bus bit grid. A falling edge
+              at the start of a bus bit time starts a byte. Received bytes are passed to the serial interface with the time of the
+              stop bit sample, like a UART receive interrupt. Closed interface (baudrate 0) receives nothing
+  \param[in]  Node    slave node
+  \param[in]  Level   bus level in current bit time (0 = dominant, 1 = recessive)
+*/
+void LIN_Bus_Sim::_receiveSlave(LIN_Bus_Sim::node_t &Node, uint8_t Level)
+{
+  LIN_Bus_Sim::receiver_t  &rx = Node.rx;
+  uint64_t  baudrate = Node.pSerial->hostBaudrate();
+  uint64_t  timeBit = this->_tickToTime(this->tick);
+  uint64_t  timeBitEnd = this->_tickToTime(this->tick + 1);
+  uint64_t  timeSample;
+
+  // closed interface -> receiver is idle
+  if (baudrate == 0)
+  {
+    rx.idxBit = 0;
+    rx.flagWaitIdle = false;
+    return;
+  }
+
+  // after framing error wait for recessive level
+  if (rx.flagWaitIdle)
+  {
+    rx.flagWaitIdle = (Level == 0);
+    return;
+  }
+
+  // idle: dominant level is start bit
+  if (rx.idxBit == 0)
+  {
+    if (Level != 0)
+      return;
+    rx.idxBit    = 1;
+    rx.shift     = 0x00;
+    rx.timeStart = timeBit;
+  }
+
+  // sample all slave bit times whose middle lies within this bus bit time
+  while (true)
+  {
+    timeSample = rx.timeStart + (uint64_t) (2 * rx.idxBit + 1) * 1000000000ULL / (2 * baudrate);
+    if (timeSample >= timeBitEnd)
+      return;
+
+    // data bits, LSB first
+    if (rx.idxBit <= 8)
+    {
+      rx.shift |= (uint8_t) (Level << (rx.idxBit - 1));
+      rx.idxBit++;
+      continue;
+    }
+
+    // stop bit: dominant is framing error. Receive time is stop bit sample
+    rx.idxBit = 0;
+    rx.flagWaitIdle = (Level == 0);
+    Node.pSerial->hostReceive(rx.shift, rx.flagWaitIdle, (uint32_t) (timeSample / 1000ULL));
+    return;
+  }
+
+} // LIN_Bus_Sim::_receiveSlave()
+
+
+
+/**
+  \brief      Check for bus activity
+  \details    Check if a transmitter is sending or a receiver is receiving. Else bit times can be skipped until next event
+  \return     true if bit times must be simulated
+*/
+bool LIN_Bus_Sim::_isActive(void)
+{
+  // master is sending or receiving
+  if ((!this->txMaster.queue.empty()) || (this->rxMaster.idxBit != 0) || (this->rxMaster.flagWaitIdle))
+    return true;
+
+  // a slave is sending or receiving
+  for (size_t i = 0; i < this->nodes.size(); i++)
+  {
+    if ((!this->nodes[i].tx.queue.empty()) || (this->nodes[i].rx.idxBit != 0) || (this->nodes[i].rx.flagWaitIdle))
+      return true;
+  }
+
+  // bus is idle
+  return false;
+
+} // LIN_Bus_Sim::_isActive()
+
+
+
+/**
+  \brief      Simulate one bit time
+  \details    Combine levels of all transmitters and noise via wired-AND, and pass resulting bus level to all receivers
+*/
+void LIN_Bus_Sim::_simulateBit(void)
+{
+  uint8_t   level, byteRx;
+  bool      flagFE;
+
+  // wired-AND of all transmitters
+  level = LIN_Bus_Sim::_transmitBit(this->txMaster);
+  for (size_t i = 0; i < this->nodes.size(); i++)
+    level &= LIN_Bus_Sim::_transmitBit(this->nodes[i].tx);
+
+  // noise glitch pulls bus dominant
+  if (this->tick == this->tickNoise)
+  {
+    level = 0;
+    this->result.glitches++;
+    this->_nextNoise();
+  }
+
+  // master receiver. Store response bytes after header (BREAK, SYNC, PID)
+  if (this->_receiveBit(this->rxMaster, level, byteRx, flagFE))
+  {
+    if ((this->numRx >= 3) && (this->numRx < 3 + sizeof(this->bufRx)))
+    {
+      if (this->numRx == 3)
+        this->tickResponse = this->rxMaster.tickStart;
+      this->bufRx[this->numRx - 3] = byteRx;
+    }
+    if (this->numRx < 0xFF)
+      this->numRx++;
+  }
+
+  // slave receivers at their own baudrate, incl. echo of own response
+  for (size_t i = 0; i < this->nodes.size(); i++)
+    this->_receiveSlave(this->nodes[i], level);
+
+  // next bit time
+  this->tick++;
+  this->result.bits++;
+
+} // LIN_Bus_Sim::_simulateBit()
+
+
+
+/**
+  \brief      Call handler() of a slave
+  \details    Call handler() of a slave like from loop(), and like an application reset state machine after a finished frame.
+              Bytes sent by the slave are passed to its transmitter, starting at the next bit time
+  \param[in]  Node    slave node
+*/
+void LIN_Bus_Sim::_pollNode(LIN_Bus_Sim::node_t &Node)
+{
+  uint8_t   buf[16];
+  uint16_t  num;
+
+  // call handler at current virtual time
+  ArduinoHost::setMicros(this->timeNow / 1000ULL);
+  Node.pSlave->handler();
+
+  // finished frame -> count errors and reset state machine
+  if (Node.pSlave->getState() == LIN_Slave_Base::STATE_DONE)
+  {
+    this->result.slaveFrames++;
+    for (uint8_t i = 0; i < 8; i++)
+      this->result.slaveErrors[i] += (Node.pSlave->getError() >> i) & 0x01;
+    Node.pSlave->resetError();
+    Node.pSlave->resetStateMachine();
+  }
+
+  // send bytes written by slave back-to-back
+  while ((num = Node.pSerial->hostTransmit(buf, sizeof(buf))) > 0)
+  {
+    for (uint16_t i = 0; i < num; i++)
+      LIN_Bus_Sim::_sendByte(Node.tx, buf[i], 0);
+  }
+
+  // next call after loop() duration plus random jitter
+  Node.timePoll = this->timeNow + 1000ULL * this->config.timePoll;
+  if (this->config.timeJitter > 0)
+    Node.timePoll += 1000ULL * (this->_random() % (this->config.timeJitter + 1));
+
+} // LIN_Bus_Sim::_pollNode()
+
+
+
+/**
+  \brief      Start next frame of master schedule
+  \details    Send BREAK, delimiter, SYNC and PID, and for a master request also data and checksum. For a slave
+              response the received bytes are evaluated after the max. frame time, see LIN spec (TFrame_Max = 1.4*TFrame_Nominal)
+*/
+void LIN_Bus_Sim::_startFrame(void)
+{
+  LIN_Bus_Sim::symbol_t   symbol;
+  const LIN_Bus_Sim::schedule_t &frame = this->schedule[this->idxSchedule];
+  uint8_t                 pid = LIN_Slave_Protocol::getPID(frame.id);
+  uint8_t                 bitsHeader;
+
+  // evaluate pending response of previous frame, if slot time is too short
+  if (this->timeEval != 0)
+    this->_evaluateResponse();
+
+  // BREAK and delimiter
+  symbol.num  = this->config.bitsBreak + this->config.bitsDelimiter;
+  symbol.bits = ((1UL << this->config.bitsDelimiter) - 1) << this->config.bitsBreak;
+  this->txMaster.queue.push_back(symbol);
+
+  // SYNC and PID. Bit time after PID is reference for response space
+  LIN_Bus_Sim::_sendByte(this->txMaster, 0x55, this->config.bitsInterByte);
+  LIN_Bus_Sim::_sendByte(this->txMaster, pid, 0);
+  bitsHeader = this->config.bitsBreak + this->config.bitsDelimiter + 20 + this->config.bitsInterByte;
+  this->tickPID = this->tick + bitsHeader;
+  this->numRx   = 0;
+  this->result.frames++;
+
+  // master request: data and checksum with inter-byte space
+  if (frame.request)
+  {
+    for (uint8_t i = 0; i < frame.numData; i++)
+      LIN_Bus_Sim::_sendByte(this->txMaster, frame.data[i], this->config.bitsInterByte);
+    LIN_Bus_Sim::_sendByte(this->txMaster,
+      LIN_Slave_Protocol::checksum(LIN_Slave_Protocol::getSeed(frame.id, this->config.enhanced), frame.data, frame.numData), 0);
+  }
+
+  // slave response: evaluate after max. frame time
+  else
+    this->timeEval = this->timeNow + this->_tickToTime((uint64_t) (bitsHeader + 10 * (frame.numData + 1)) * 14 / 10);
+
+  // next frame after slot time. Frames start on bit grid
+  this->timeFrame = this->timeNow + 1000ULL * frame.timeSlot;
+  this->idxSchedule = (uint16_t) ((this->idxSchedule + 1) % this->schedule.size());
+
+} // LIN_Bus_Sim::_startFrame()
+
+
+
+/**
+  \brief      Evaluate slave response
+  \details    Check number of response bytes and checksum received by master, and record response space
+*/
+void LIN_Bus_Sim::_evaluateResponse(void)
+{
+  const LIN_Bus_Sim::schedule_t &frame = this->schedule[(this->idxSchedule + this->schedule.size() - 1) % this->schedule.size()];
+  uint8_t   numResponse = (this->numRx > 3) ? (uint8_t) (this->numRx - 3) : 0;
+  uint32_t  latency;
+
+  // evaluation done
+  this->timeEval = 0;
+
+  // no response
+  if (numResponse == 0)
+  {
+    this->result.responsesMissing++;
+    return;
+  }
+
+  // wrong length or checksum
+  if ((numResponse != frame.numData + 1) || (this->bufRx[frame.numData] !=
+    LIN_Slave_Protocol::checksum(LIN_Slave_Protocol::getSeed(frame.id, this->config.enhanced), this->bufRx, frame.numData)))
+  {
+    this->result.responsesError++;
+    return;
+  }
+
+  // valid response -> record response space [us]
+  latency = (this->tickResponse > this->tickPID) ? (uint32_t) (this->_tickToTime(this->tickResponse - this->tickPID) / 1000ULL) : 0;
+  this->result.responsesOk++;
+  this->result.latencySum += latency;
+  if (latency < this->result.latencyMin)
+    this->result.latencyMin = latency;
+  if (latency > this->result.latencyMax)
+    this->result.latencyMax = latency;
+  this->result.latencyHist[(latency / LIN_BUS_SIM_HIST_BIN < LIN_BUS_SIM_HIST) ? latency / LIN_BUS_SIM_HIST_BIN : LIN_BUS_SIM_HIST-1]++;
+
+} // LIN_Bus_Sim::_evaluateResponse()
+
+
+
+/**************************
+ * PUBLIC METHODS
+**************************/
+
+/**
+  \brief      Default simulation parameters
+  \details    Default simulation parameters: 19200 Baud, BREAK 13 bits, delimiter 1 bit, no inter-byte space, handler() every 100us,
+              no jitter, no noise, enhanced checksum
+  \return     default parameters
+*/
+LIN_Bus_Sim::config_t LIN_Bus_Sim::defaultConfig(void)
+{
+  LIN_Bus_Sim::config_t   config;
+
+  config.baudrate       = 19200;
+  config.bitsBreak      = 13;
+  config.bitsDelimiter  = 1;
+  config.bitsInterByte  = 0;
+  config.timePoll       = 100;
+  config.timeJitter     = 0;
+  config.noise          = 0.0;
+  config.seed           = 1;
+  config.enhanced       = true;
+  return config;
+
+} // LIN_Bus_Sim::defaultConfig()
+
+
+
+/**
+  \brief      Constructor for LIN bus simulator
+  \details    Constructor for LIN bus simulator. Master starts first frame at time 10ms
+  \param[in]  Config    simulation parameters
+*/
+LIN_Bus_Sim::LIN_Bus_Sim(const LIN_Bus_Sim::config_t &Config)
+{
+  // store parameters
+  this->config = Config;
+  if (this->config.baudrate < LIN_SLAVE_MIN_BAUDRATE)
+    this->config.baudrate = LIN_SLAVE_MIN_BAUDRATE;
+  if (this->config.bitsBreak < 10)
+    this->config.bitsBreak = 10;
+  if (this->config.bitsDelimiter < 1)
+    this->config.bitsDelimiter = 1;
+  if (this->config.bitsBreak + this->config.bitsDelimiter > 32)
+    this->config.bitsBreak = 32 - this->config.bitsDelimiter;
+  if (this->config.bitsInterByte > 22)
+    this->config.bitsInterByte = 22;
+
+  // initialize simulation
+  this->timeNow     = 0;
+  this->tick        = 0;
+  this->stateRandom = 0x9E3779B97F4A7C15ULL ^ (uint64_t) this->config.seed;
+  this->_nextNoise();
+  this->txMaster.idxBit = 0;
+  this->rxMaster.idxBit = 0;
+  this->rxMaster.flagWaitIdle = false;
+  this->idxSchedule = 0;
+  this->timeFrame   = 10000000ULL;
+  this->timeEval    = 0;
+  this->tickPID     = 0;
+  this->numRx       = 0;
+  this->tickResponse = 0;
+  this->clearResult();
+
+} // LIN_Bus_Sim::LIN_Bus_Sim()
+
+
+
+/**
+  \brief      Add a slave node
+  \details    Add a slave node. Slave must be opened via begin() before, and its serial interface must be the host HardwareSerial
+  \param[in]  Slave       LIN slave instance
+  \param[in]  Interface   serial interface of slave
+*/
+void LIN_Bus_Sim::addSlave(LIN_Slave_Base &Slave, HardwareSerial &Interface)
+{
+  LIN_Bus_Sim::node_t   node;
+
+  // initialize node. First handler() call is distributed within loop() duration
+  node.pSlave = &Slave;
+  node.pSerial = &Interface;
+  node.tx.idxBit = 0;
+  node.rx.idxBit = 0;
+  node.rx.flagWaitIdle = false;
+  node.rx.timeStart = 0;
+  node.timePoll = this->timeNow + 1000ULL * (this->_random() % (this->config.timePoll + 1));
+  this->nodes.push_back(node);
+
+} // LIN_Bus_Sim::addSlave()
+
+
+
+/**
+  \brief      Set master schedule
+  \details    Set master schedule. Frames are sent cyclically
+  \param[in]  Table   frames of schedule
+  \param[in]  Num     number of frames
+*/
+void LIN_Bus_Sim::setSchedule(const LIN_Bus_Sim::schedule_t Table[], uint16_t Num)
+{
+  // copy schedule and start with first frame
+  this->schedule.assign(Table, Table + Num);
+  this->idxSchedule = 0;
+
+} // LIN_Bus_Sim::setSchedule()
+
+
+
+/**
+  \brief      Change master baudrate
+  \details    Change baudrate of master and bus bit grid between runs, e.g. to simulate a master with other baudrate or clock
+              deviation. A pending response is evaluated first. Must be called while the bus is idle, i.e. between frames
+  \param[in]  Baudrate    new bus baudrate [Baud]
+*/
+void LIN_Bus_Sim::setBaudrate(uint32_t Baudrate)
+{
+  // evaluate pending response at old bit grid
+  if (this->timeEval != 0)
+    this->_evaluateResponse();
+
+  // continue at current time on new bit grid
+  this->config.baudrate = (Baudrate < LIN_SLAVE_MIN_BAUDRATE) ? LIN_SLAVE_MIN_BAUDRATE : Baudrate;
+  this->tick = this->_timeToTick(this->timeNow);
+  this->_nextNoise();
+
+} // LIN_Bus_Sim::setBaudrate()
+
+
+
+/**
+  \brief      Run simulation
+  \details    Run simulation for given time. Events are processed in order: bit times with bus activity or noise glitch,
+              handler() calls of slaves and frame start / response evaluation of master. Idle bit times are skipped.
+              Bus levels are sampled in the middle of a bit time, and transmitters start at the next bit time
+  \param[in]  Duration    time to simulate [us]
+*/
+void LIN_Bus_Sim::run(uint64_t Duration)
+{
+  uint64_t  timeEnd = this->timeNow + 1000ULL * Duration;
+  uint64_t  timeTick, timeNode, timeMaster, timeNext;
+  size_t    idxNode = 0;
+  bool      flagActive;
+
+  // virtual clock of this thread
+  ArduinoHost::useVirtualTime(true);
+
+  // process events in order of time
+  while (true)
+  {
+    // next bit time to simulate: with bus activity or noise glitch. Bus is sampled in middle of bit time
+    timeTick = UINT64_MAX;
+    flagActive = this->_isActive();
+    if (flagActive)
+      timeTick = this->_tickToTime(this->tick) + this->_tickToTime(1) / 2;
+    else if (this->tickNoise != UINT64_MAX)
+      timeTick = this->_tickToTime(this->tickNoise) + this->_tickToTime(1) / 2;
+
+    // next handler() call of a slave
+    timeNode = UINT64_MAX;
+    for (size_t i = 0; i < this->nodes.size(); i++)
+    {
+      if (this->nodes[i].timePoll < timeNode)
+      {
+        timeNode = this->nodes[i].timePoll;
+        idxNode  = i;
+      }
+    }
+
+    // next action of master
+    timeMaster = UINT64_MAX;
+    if (!this->schedule.empty())
+      timeMaster = this->timeFrame;
+    if ((this->timeEval != 0) && (this->timeEval < timeMaster))
+      timeMaster = this->timeEval;
+
+    // end of simulation
+    timeNext = timeTick;
+    if (timeNode < timeNext)
+      timeNext = timeNode;
+    if (timeMaster < timeNext)
+      timeNext = timeMaster;
+    if (timeNext >= timeEnd)
+      break;
+    this->timeNow = timeNext;
+
+    // simulate bit time. Skipped idle bit times are recessive
+    if (timeNext == timeTick)
+    {
+      if (!flagActive)
+        this->tick = this->tickNoise;
+      this->_simulateBit();
+      continue;
+    }
+
+    // skip idle bit times, i.e. transmitters start at next bit time
+    if ((!flagActive) && (this->tick < this->_timeToTick(this->timeNow)))
+      this->tick = this->_timeToTick(this->timeNow);
+
+    // call handler() of slave
+    if (timeNext == timeNode)
+      this->_pollNode(this->nodes[idxNode]);
+
+    // evaluate response or start next frame
+    else if (timeNext == this->timeEval)
+      this->_evaluateResponse();
+    else
+      this->_startFrame();
+
+  } // while events
+
+  // end of simulation
+  this->timeNow = timeEnd;
+  this->result.timeSim = timeEnd / 1000ULL;
+
+} // LIN_Bus_Sim::run()
+
+
+
+/**
+  \brief      Clear simulation results
+  \details    Clear simulation results, e.g. after a settling time
+*/
+void LIN_Bus_Sim::clearResult(void)
+{
+  memset(&(this->result), 0, sizeof(this->result));
+  this->result.latencyMin = UINT32_MAX;
+
+} // LIN_Bus_Sim::clearResult()
+
+
+
+/**
+  \brief      Add results
+  \details    Add results of a simulation to a sum, e.g. of several simulations in parallel
+  \param[in,out]  Sum     sum of results. Initialize with clearResult() values, i.e. latencyMin = UINT32_MAX
+  \param[in]      Result  results to add
+*/
+void LIN_Bus_Sim::addResult(LIN_Bus_Sim::result_t &Sum, const LIN_Bus_Sim::result_t &Result)
+{
+  // add counters
+  Sum.timeSim          += Result.timeSim;
+  Sum.bits             += Result.bits;
+  Sum.frames           += Result.frames;
+  Sum.responsesOk      += Result.responsesOk;
+  Sum.responsesMissing += Result.responsesMissing;
+  Sum.responsesError   += Result.responsesError;
+  Sum.latencySum       += Result.latencySum;
+  Sum.slaveFrames      += Result.slaveFrames;
+  Sum.glitches         += Result.glitches;
+  for (uint16_t i = 0; i < LIN_BUS_SIM_HIST; i++)
+    Sum.latencyHist[i] += Result.latencyHist[i];
+  for (uint8_t i = 0; i < 8; i++)
+    Sum.slaveErrors[i] += Result.slaveErrors[i];
+
+  // min/max of response space
+  if (Result.latencyMin < Sum.latencyMin)
+    Sum.latencyMin = Result.latencyMin;
+  if (Result.latencyMax > Sum.latencyMax)
+    Sum.latencyMax = Result.latencyMax;
+
+} // LIN_Bus_Sim::addResult()
+
+
+
+/**
+  \brief      Get percentile of response space
+  \details    Get percentile of response space from histogram, i.e. with resolution LIN_BUS_SIM_HIST_BIN
+  \param[in]  Result    simulation results
+  \param[in]  Percent   percentile (0..100)
+  \return     upper limit of histogram bin [us] which contains the percentile (0 if no response)
+*/
+uint32_t LIN_Bus_Sim::getPercentile(const LIN_Bus_Sim::result_t &Result, uint8_t Percent)
+{
+  uint64_t  sum = 0;
+  uint64_t  limit = ((uint64_t) Result.responsesOk * Percent + 99) / 100;
+
+  // no valid responses
+  if (Result.responsesOk == 0)
+    return 0;
+
+  // find bin which reaches limit
+  for (uint16_t i = 0; i < LIN_BUS_SIM_HIST; i++)
+  {
+    sum += Result.latencyHist[i];
+    if ((sum >= limit) && (sum > 0))
+      return (uint32_t) (i + 1) * LIN_BUS_SIM_HIST_BIN;
+  }
+  return LIN_BUS_SIM_HIST * LIN_BUS_SIM_HIST_BIN;
+
+} // LIN_Bus_Sim::getPercentile()
+
+
+
+/**
+  \brief      Print results
+  \details    Print results as text
+  \param[in]  Result    simulation results
+  \param[in]  Out       output stream, e.g. stdout
+*/
+void LIN_Bus_Sim::printResult(const LIN_Bus_Sim::result_t &Result, FILE *Out)
+{
+  static const char *nameError[6] = { "state", "echo", "timeout", "checksum", "sync", "pid" };
+
+  fprintf(Out, "simulated time   %.3f s (%llu bit times simulated)\n", (double) Result.timeSim / 1e6, (unsigned long long) Result.bits);
+  fprintf(Out, "master frames    %u (noise glitches %u)\n", (unsigned) Result.frames, (unsigned) Result.glitches);
+  fprintf(Out, "responses        ok %u, missing %u, error %u\n", (unsigned) Result.responsesOk, (unsigned) Result.responsesMissing,
+    (unsigned) Result.responsesError);
+  if (Result.responsesOk > 0)
+    fprintf(Out, "response space   min %u us, mean %u us, p99 <%u us, max %u us\n", (unsigned) Result.latencyMin,
+      (unsigned) (Result.latencySum / Result.responsesOk), (unsigned) LIN_Bus_Sim::getPercentile(Result, 99), (unsigned) Result.latencyMax);
+  fprintf(Out, "slave frames     %u, errors:", (unsigned) Result.slaveFrames);
+  for (uint8_t i = 0; i < 6; i++)
+    fprintf(Out, " %s %u", nameError[i], (unsigned) Result.slaveErrors[i]);
+  fprintf(Out, "\n");
+
+} // LIN_Bus_Sim::printResult()
+
+/*-----------------------------------------------------------------------------
+    END OF FILE
+-----------------------------------------------------------------------------*/
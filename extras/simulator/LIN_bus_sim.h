@@ -0,0 +1,259 @@
+/**
+  \file     LIN_bus_sim.h
+  \brief    Discrete-event LIN bus simulator for host builds
+  \details  Simulates a LIN bus at bit level with wired-AND semantics, i.e. a bit is dominant (0) if any node drives it dominant.
+            A master sends frames according to a schedule incl. BREAK, delimiter and inter-byte space, and checks slave responses.
+            Slaves are instances of any backend class which uses the host HardwareSerial (see extras/host). Each node has its
+            own UART receiver which samples the bus, i.e. slaves receive their own response as echo and a BREAK as 0x00 with
+            framing error. Slave receivers sample at the baudrate configured in their serial interface, e.g. by auto-baud or clock
+            trim, while the master and all transmitters use the bus bit grid. handler() of each slave is called periodically like from loop().
+            Time is virtual (see ArduinoHost::useVirtualTime()), and bit times without bus activity are skipped. Therefore a
+            simulation runs much faster than real time and is deterministic for a given seed.
+            Only for host builds via CMake, see CMakeLists.txt in the root folder
+  \note     Clock deviation of the master is simulated via config.baudrate vs. the slave baudrate. Slave transmitters use the bus bit grid,
+            i.e. the master always receives responses at its own baudrate
+  \author   Georg Icking-Konert
+*/
+
+/*-----------------------------------------------------------------------------
+  MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _LIN_BUS_SIM_H_
+#define _LIN_BUS_SIM_H_
+
+
+/*-----------------------------------------------------------------------------
+  INCLUDE FILES
+-----------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <vector>
+#include <deque>
+#include <Arduino.h>
+#include <LIN_slave_Base.h>
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL DEFINES
+-----------------------------------------------------------------------------*/
+
+/// number of bins of latency histogram. Last bin counts all larger latencies
+#define LIN_BUS_SIM_HIST        256
+
+/// width [us] of a bin of latency histogram
+#define LIN_BUS_SIM_HIST_BIN    10
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL CLASS
+-----------------------------------------------------------------------------*/
+
+/**
+  \brief  Discrete-event LIN bus simulator with one master and several slave nodes
+
+  \details Discrete-event LIN bus simulator with one master and several slave nodes. Slaves are added via addSlave() and must
+           be opened via begin() before. Only one simulator may run per thread, as the virtual clock is thread-local.
+*/
+class LIN_Bus_Sim
+{
+  // PUBLIC TYPES
+  public:
+
+    /// Frame in master schedule
+    typedef struct
+    {
+      uint8_t                 id;               //!< frame ID (unprotected)
+      bool                    request;          //!< true: master request with data[], false: slave response is expected
+      uint8_t                 numData;          //!< number of data bytes (1..8)
+      uint8_t                 data[8];          //!< data bytes of master request
+      uint32_t                timeSlot;         //!< slot time [us] from start of BREAK to start of next BREAK
+    } schedule_t;
+
+
+    /// Simulation parameters
+    typedef struct
+    {
+      uint32_t                baudrate;         //!< bus baudrate [Baud]
+      uint8_t                 bitsBreak;        //!< length of BREAK [bit times], min. 13 acc. to LIN spec
+      uint8_t                 bitsDelimiter;    //!< length of BREAK delimiter [bit times], min. 1 acc. to LIN spec
+      uint8_t                 bitsInterByte;    //!< inter-byte space of master [bit times]
+      uint32_t                timePoll;         //!< period [us] of handler() calls of slaves, i.e. duration of loop()
+      uint32_t                timeJitter;       //!< max. random additional delay [us] of handler() calls
+      double                  noise;            //!< probability of a dominant glitch per bit time (0 = no noise)
+      uint32_t                seed;             //!< seed of random generator. Same seed gives same results
+      bool                    enhanced;         //!< master uses LIN2.x enhanced checksum
+    } config_t;
+
+
+    /// Simulation results
+    typedef struct
+    {
+      uint64_t                timeSim;          //!< simulated time [us]
+      uint64_t                bits;             //!< simulated bit times with bus activity, i.e. not skipped
+      uint32_t                frames;           //!< frames started by master
+      uint32_t                responsesOk;      //!< slave responses received by master with correct length and checksum
+      uint32_t                responsesMissing; //!< slave response frames without any response byte
+      uint32_t                responsesError;   //!< slave responses with wrong length or checksum error
+      uint32_t                latencyMin;       //!< min. response space [us] from PID stop bit to first response start bit
+      uint32_t                latencyMax;       //!< max. response space [us]
+      uint64_t                latencySum;       //!< sum of response spaces [us] of responsesOk, for mean value
+      uint32_t                latencyHist[LIN_BUS_SIM_HIST];  //!< histogram of response space, see LIN_BUS_SIM_HIST_BIN
+      uint32_t                slaveFrames;      //!< frames finished by slaves (STATE_DONE), sum of all slaves
+      uint32_t                slaveErrors[8];   //!< finished frames with error bit i of LIN_Slave_Base::error_t, sum of all slaves
+      uint32_t                glitches;         //!< injected noise glitches
+    } result_t;
+
+
+  // PROTECTED TYPES
+  protected:
+
+    /// UART symbol on bus, sent LSB first, e.g. start bit + 8 data bits + stop bit
+    typedef struct
+    {
+      uint32_t                bits;             //!< bit levels, bit 0 is sent first
+      uint8_t                 num;              //!< number of bits (1..32)
+    } symbol_t;
+
+    /// UART transmitter of a node
+    typedef struct
+    {
+      std::deque<symbol_t>    queue;            //!< symbols to send
+      uint8_t                 idxBit;           //!< next bit of first symbol
+    } transmitter_t;
+
+    /// UART receiver of a node
+    typedef struct
+    {
+      uint8_t                 idxBit;           //!< 0 = idle, 1..8 = data bit, 9 = stop bit
+      uint8_t                 shift;            //!< received data bits
+      bool                    flagWaitIdle;     //!< after framing error wait for recessive level before next start bit
+      uint64_t                tickStart;        //!< bit time of start bit
+      uint64_t                timeStart;        //!< time [ns] of falling edge of start bit (slave receivers)
+    } receiver_t;
+
+    /// Slave node
+    typedef struct
+    {
+      LIN_Slave_Base          *pSlave;          //!< LIN slave instance
+      HardwareSerial          *pSerial;         //!< serial interface of slave
+      transmitter_t           tx;               //!< UART transmitter
+      receiver_t              rx;               //!< UART receiver
+      uint64_t                timePoll;         //!< time [ns] of next handler() call
+    } node_t;
+
+
+  // PROTECTED VARIABLES
+  protected:
+
+    LIN_Bus_Sim::config_t     config;           //!< simulation parameters
+    LIN_Bus_Sim::result_t     result;           //!< simulation results
+    std::vector<LIN_Bus_Sim::schedule_t>  schedule;   //!< master schedule
+    std::vector<LIN_Bus_Sim::node_t>      nodes;      //!< slave nodes
+
+    uint64_t                  timeNow;          //!< current time [ns]
+    uint64_t                  tick;             //!< index of next bit time to simulate
+    uint64_t                  tickNoise;        //!< index of bit time with next noise glitch
+    uint64_t                  stateRandom;      //!< state of random generator (xorshift64)
+
+    // master
+    LIN_Bus_Sim::transmitter_t  txMaster;       //!< UART transmitter of master
+    LIN_Bus_Sim::receiver_t   rxMaster;         //!< UART receiver of master
+    uint16_t                  idxSchedule;      //!< index of current frame in schedule
+    uint64_t                  timeFrame;        //!< time [ns] of next frame start
+    uint64_t                  timeEval;         //!< time [ns] to evaluate slave response (0 = none pending)
+    uint64_t                  tickPID;          //!< bit time after stop bit of PID of current frame
+    uint8_t                   numRx;            //!< number of bytes received by master in current frame incl. header
+    uint8_t                   bufRx[16];        //!< slave response received by master
+    uint64_t                  tickResponse;     //!< bit time of start bit of first response byte
+
+
+  // PROTECTED METHODS
+  protected:
+
+    /// @brief Convert bit time index to time [ns]
+    inline uint64_t _tickToTime(uint64_t Tick) { return Tick * 1000000000ULL / this->config.baudrate; }
+
+    /// @brief Convert time [ns] to index of next bit time
+    inline uint64_t _timeToTick(uint64_t Time) { return (Time * this->config.baudrate + 999999999ULL) / 1000000000ULL; }
+
+    /// @brief Random number 0..2^64-1
+    uint64_t _random(void);
+
+    /// @brief Draw bit time of next noise glitch
+    void _nextNoise(void);
+
+    /// @brief Add a UART byte to a transmitter
+    static void _sendByte(LIN_Bus_Sim::transmitter_t &Tx, uint8_t Byte, uint8_t BitsSpace);
+
+    /// @brief Get bus level driven by a transmitter and advance to next bit
+    static uint8_t _transmitBit(LIN_Bus_Sim::transmitter_t &Tx);
+
+    /// @brief Sample bus level by a receiver. Returns true if a byte was received
+    bool _receiveBit(LIN_Bus_Sim::receiver_t &Rx, uint8_t Level, uint8_t &Byte, bool &FrameError);
+
+    /// @brief Sample bus level by a slave receiver at the baudrate of its serial interface, and pass received bytes to it
+    void _receiveSlave(LIN_Bus_Sim::node_t &Node, uint8_t Level);
+
+    /// @brief Check for bus activity, i.e. bit times must be simulated
+    bool _isActive(void);
+
+    /// @brief Simulate one bit time
+    void _simulateBit(void);
+
+    /// @brief Call handler() of a slave like from loop()
+    void _pollNode(LIN_Bus_Sim::node_t &Node);
+
+    /// @brief Start next frame of master schedule
+    void _startFrame(void);
+
+    /// @brief Evaluate slave response received by master
+    void _evaluateResponse(void);
+
+
+  // PUBLIC METHODS
+  public:
+
+    /// @brief Default simulation parameters
+    static LIN_Bus_Sim::config_t defaultConfig(void);
+
+    /// @brief Class constructor
+    LIN_Bus_Sim(const LIN_Bus_Sim::config_t &Config);
+
+    /// @brief Add a slave node. Slave must be opened via begin() before
+    void addSlave(LIN_Slave_Base &Slave, HardwareSerial &Interface);
+
+    /// @brief Set master schedule, is repeated cyclically
+    void setSchedule(const LIN_Bus_Sim::schedule_t Table[], uint16_t Num);
+
+    /// @brief Change master baudrate between runs, e.g. to simulate a master with other baudrate or clock. Bus must be idle
+    void setBaudrate(uint32_t Baudrate);
+
+    /// @brief Simulate for given time [us]. Can be called repeatedly
+    void run(uint64_t Duration);
+
+    /// @brief Get simulation results
+    inline const LIN_Bus_Sim::result_t &getResult(void) { return this->result; }
+
+    /// @brief Clear simulation results
+    void clearResult(void);
+
+    /// @brief Add results, e.g. of several simulations
+    static void addResult(LIN_Bus_Sim::result_t &Sum, const LIN_Bus_Sim::result_t &Result);
+
+    /// @brief Get percentile of response space [us] from histogram
+    static uint32_t getPercentile(const LIN_Bus_Sim::result_t &Result, uint8_t Percent);
+
+    /// @brief Print results as text
+    static void printResult(const LIN_Bus_Sim::result_t &Result, FILE *Out);
+
+}; // class LIN_Bus_Sim
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _LIN_BUS_SIM_H_
+
+/*-----------------------------------------------------------------------------
+    END OF FILE
+-----------------------------------------------------------------------------*/
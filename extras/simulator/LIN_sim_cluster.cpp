@@ -0,0 +1,132 @@
+/**
+  \file     LIN_sim_cluster.cpp
+  \brief    Simulated LIN cluster with a standard schedule for the bus simulator
+  \details  Implementation of LIN_sim_cluster.h. Only for host builds via CMake
+  \author   Georg Icking-Konert
+*/
+
+// include files
+#include <LIN_slave_HardwareSerial.h>
+#include "LIN_slave_Sim.h"
+#include "LIN_sim_cluster.h"
+
+
+/**************************
+ * LOCAL FUNCTIONS
+**************************/
+
+// master request callback: data is ignored
+static void _masterRequest(uint8_t numData, uint8_t* data)
+{
+  (void) numData;
+  (void) data;
+}
+
+// slave response callback: data depends only on length, i.e. is the same for all slaves
+static void _slaveResponse(uint8_t numData, uint8_t* data)
+{
+  for (uint8_t i = 0; i < numData; i++)
+    data[i] = (uint8_t) (0xA0 + numData + i);
+}
+
+
+
+/**************************
+ * PUBLIC METHODS
+**************************/
+
+/**
+  \brief      Constructor for simulated LIN cluster
+  \details    Create and open slaves with own serial interfaces, register frames and set master schedule. Slot time of each
+              frame is its max. frame time (TFrame_Max = 1.4*TFrame_Nominal, 8 data bytes) plus 1ms, rounded to 1ms
+  \param[in]  Config      simulation parameters
+  \param[in]  NumSlaves   number of slaves (1..16)
+  \param[in]  Backend     backend class of slaves
+  \param[in]  Collision   add a slave which also responds to ID 0x20, i.e. responses collide
+*/
+LIN_Sim_Cluster::LIN_Sim_Cluster(const LIN_Bus_Sim::config_t &Config, uint8_t NumSlaves, LIN_Sim_Cluster::backend_t Backend, bool Collision) :
+  bus(Config)
+{
+  std::vector<LIN_Bus_Sim::schedule_t>  schedule;
+  LIN_Bus_Sim::schedule_t               frame;
+  uint32_t                              timeSlot;
+  uint8_t                               numNodes;
+
+  // slot time [us] for max. frame length, rounded up to 1ms
+  timeSlot = (uint32_t) ((uint64_t) (34 + 10 * 9) * 1400000ULL / Config.baudrate);
+  timeSlot = (timeSlot / 1000 + 2) * 1000;
+
+  // limit number of slaves to IDs 0x10..0x1F and 0x20..0x2F
+  if (NumSlaves < 1)
+    NumSlaves = 1;
+  if (NumSlaves > 16)
+    NumSlaves = 16;
+  numNodes = NumSlaves + (Collision ? 1 : 0);
+
+  // create, open and attach slaves
+  for (uint8_t i = 0; i < numNodes; i++)
+  {
+    uint8_t idxFrame = (i < NumSlaves) ? i : 0;
+
+    this->serials.emplace_back(new HardwareSerial());
+    if (Backend == LIN_Sim_Cluster::BACKEND_PAUSE)
+      this->slaves.emplace_back(new LIN_Slave_HardwareSerial(*(this->serials[i]), 1000, LIN_Slave_Base::LIN_V2, "Pause"));
+    else
+      this->slaves.emplace_back(new LIN_Slave_Sim(*(this->serials[i]), LIN_Slave_Base::LIN_V2, "FE"));
+    this->slaves[i]->begin(Config.baudrate);
+    this->slaves[i]->registerMasterRequestHandler(0x10 + idxFrame, _masterRequest, 4);
+    this->slaves[i]->registerSlaveResponseHandler(0x20 + idxFrame, _slaveResponse, 1 + (idxFrame % 8));
+    this->bus.addSlave(*(this->slaves[i]), *(this->serials[i]));
+  }
+
+  // schedule: master request and slave response per slave
+  for (uint8_t i = 0; i < NumSlaves; i++)
+  {
+    frame.id       = 0x10 + i;
+    frame.request  = true;
+    frame.numData  = 4;
+    for (uint8_t k = 0; k < 8; k++)
+      frame.data[k] = (uint8_t) (i + k);
+    frame.timeSlot = timeSlot;
+    schedule.push_back(frame);
+
+    frame.id       = 0x20 + i;
+    frame.request  = false;
+    frame.numData  = 1 + (i % 8);
+    schedule.push_back(frame);
+  }
+  this->bus.setSchedule(schedule.data(), (uint16_t) schedule.size());
+
+} // LIN_Sim_Cluster::LIN_Sim_Cluster()
+
+
+
+/**
+  \brief      Destructor for simulated LIN cluster
+  \details    Close slaves, i.e. remove them from list of opened instances before they are deleted
+*/
+LIN_Sim_Cluster::~LIN_Sim_Cluster(void)
+{
+  for (size_t i = 0; i < this->slaves.size(); i++)
+    this->slaves[i]->end();
+
+} // LIN_Sim_Cluster::~LIN_Sim_Cluster()
+
+
+
+/**
+  \brief      Run simulation
+  \details    Simulate cluster for given time
+  \param[in]  Duration    time to simulate [us]
+  \return     simulation results
+*/
+const LIN_Bus_Sim::result_t &LIN_Sim_Cluster::run(uint64_t Duration)
+{
+  this->bus.run(Duration);
+  return this->bus.getResult();
+
+} // LIN_Sim_Cluster::run()
+
+/*-----------------------------------------------------------------------------
+    END OF FILE
+-----------------------------------------------------------------------------*/
@@ -0,0 +1,84 @@
+/**
+  \file     LIN_sim_cluster.h
+  \brief    Simulated LIN cluster with a standard schedule for the bus simulator
+  \details  Creates several slave nodes of a selected backend with own serial interfaces, and a master schedule with one
+            master request and one slave response frame per slave. Is used by the command line simulator and the
+            regression runner. Only for host builds via CMake
+  \author   Georg Icking-Konert
+*/
+
+/*-----------------------------------------------------------------------------
+  MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _LIN_SIM_CLUSTER_H_
+#define _LIN_SIM_CLUSTER_H_
+
+
+/*-----------------------------------------------------------------------------
+  INCLUDE FILES
+-----------------------------------------------------------------------------*/
+
+#include <memory>
+#include "LIN_bus_sim.h"
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL CLASS
+-----------------------------------------------------------------------------*/
+
+/**
+  \brief  Simulated LIN cluster
+
+  \details Simulated LIN cluster with NumSlaves slaves. Slave i handles master request ID 0x10+i (4 bytes) and slave response
+           ID 0x20+i (1+(i%8) bytes). Optionally an extra slave also responds to ID 0x20, i.e. responses collide on the bus
+*/
+class LIN_Sim_Cluster
+{
+  // PUBLIC TYPES
+  public:
+
+    /// Slave backend
+    typedef enum : uint8_t
+    {
+      BACKEND_PAUSE         = 0,                //!< LIN_Slave_HardwareSerial, BREAK detection via inter-frame pause
+      BACKEND_FE            = 1                 //!< LIN_Slave_Sim, BREAK detection via framing error
+    } backend_t;
+
+
+  // PROTECTED VARIABLES
+  protected:
+
+    std::vector<std::unique_ptr<HardwareSerial>>  serials;  //!< serial interfaces of slaves
+    std::vector<std::unique_ptr<LIN_Slave_Base>>  slaves;   //!< slave nodes
+    LIN_Bus_Sim               bus;              //!< bus simulator
+
+
+  // PUBLIC METHODS
+  public:
+
+    /// @brief Class constructor. Creates and opens slaves and sets schedule
+    LIN_Sim_Cluster(const LIN_Bus_Sim::config_t &Config, uint8_t NumSlaves, LIN_Sim_Cluster::backend_t Backend, bool Collision = false);
+
+    /// @brief Class destructor. Closes slaves
+    ~LIN_Sim_Cluster(void);
+
+    /// @brief Simulate for given time [us] and return results
+    const LIN_Bus_Sim::result_t &run(uint64_t Duration);
+
+    /// @brief Access bus simulator, e.g. for own schedule
+    inline LIN_Bus_Sim &getBus(void) { return this->bus; }
+
+    /// @brief Access slave node
+    inline LIN_Slave_Base &getSlave(uint8_t Idx) { return *(this->slaves[Idx]); }
+
+}; // class LIN_Sim_Cluster
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _LIN_SIM_CLUSTER_H_
+
+/*-----------------------------------------------------------------------------
+    END OF FILE
+-----------------------------------------------------------------------------*/
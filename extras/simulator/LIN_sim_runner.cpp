@@ -0,0 +1,174 @@
+/**
+  \file     LIN_sim_runner.cpp
+  \brief    Parallel runner for parameter sweeps of simulated LIN clusters
+  \details  Implementation of LIN_sim_runner.h. Only for host builds via CMake
+  \author   Georg Icking-Konert
+*/
+
+// include files
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include "LIN_sim_runner.h"
+
+
+/**************************
+ * PUBLIC METHODS
+**************************/
+
+/**
+  \brief      Constructor for sweep runner
+  \details    Constructor for sweep runner without sweep points
+  \param[in]  Duration    simulated time [us] per replica
+  \param[in]  Replicas    number of simulations with different seeds per sweep point
+*/
+LIN_Sim_Runner::LIN_Sim_Runner(uint64_t Duration, uint16_t Replicas)
+{
+  this->duration = Duration;
+  this->replicas = (Replicas > 0) ? Replicas : 1;
+  this->timeWall = 0.0;
+
+} // LIN_Sim_Runner::LIN_Sim_Runner()
+
+
+
+/**
+  \brief      Add a sweep point
+  \details    Add a sweep point. Results are cleared by run()
+  \param[in]  Point   cluster configuration
+*/
+void LIN_Sim_Runner::addPoint(const LIN_Sim_Runner::point_t &Point)
+{
+  this->points.push_back(Point);
+
+} // LIN_Sim_Runner::addPoint()
+
+
+
+/**
+  \brief      Add parameter sweep
+  \details    Add sweep points for all combinations of given parameters. Other parameters are taken from Base
+  \param[in]  Base        base configuration
+  \param[in]  Baudrates   bus baudrates [Baud]
+  \param[in]  Noise       glitch probabilities per bit time
+  \param[in]  NumSlaves   number of slaves
+  \param[in]  TimePoll    periods [us] of handler() calls
+*/
+void LIN_Sim_Runner::addSweep(const LIN_Sim_Runner::point_t &Base, const std::vector<uint32_t> &Baudrates, const std::vector<double> &Noise,
+  const std::vector<uint8_t> &NumSlaves, const std::vector<uint32_t> &TimePoll)
+{
+  LIN_Sim_Runner::point_t   point = Base;
+
+  for (size_t a = 0; a < Baudrates.size(); a++)
+  {
+    for (size_t b = 0; b < Noise.size(); b++)
+    {
+      for (size_t c = 0; c < NumSlaves.size(); c++)
+      {
+        for (size_t d = 0; d < TimePoll.size(); d++)
+        {
+          point.config.baudrate = Baudrates[a];
+          point.config.noise    = Noise[b];
+          point.numSlaves       = NumSlaves[c];
+          point.config.timePoll = TimePoll[d];
+          this->points.push_back(point);
+        }
+      }
+    }
+  }
+
+} // LIN_Sim_Runner::addSweep()
+
+
+
+/**
+  \brief      Run sweep
+  \details    Simulate all replicas of all sweep points in a pool of worker threads. Each job builds its own cluster in the worker
+              thread. Results of replicas are stored per job and summed in job order afterwards, i.e. do not depend on the
+              number of threads or their scheduling
+  \param[in]  NumThreads    number of worker threads. 0 = number of CPU cores
+*/
+void LIN_Sim_Runner::run(unsigned NumThreads)
+{
+  size_t                              numJobs = this->points.size() * this->replicas;
+  std::vector<LIN_Bus_Sim::result_t>  resultJobs(numJobs);
+  std::vector<std::thread>            workers;
+  std::atomic<size_t>                 idxNext(0);
+
+  // number of worker threads
+  if (NumThreads == 0)
+    NumThreads = std::thread::hardware_concurrency();
+  if (NumThreads == 0)
+    NumThreads = 1;
+  if (NumThreads > numJobs)
+    NumThreads = (unsigned) ((numJobs > 0) ? numJobs : 1);
+
+  // worker: fetch next job until all done
+  auto worker = [&]()
+  {
+    size_t idx;
+    while ((idx = idxNext.fetch_add(1)) < numJobs)
+    {
+      LIN_Sim_Runner::point_t point = this->points[idx / this->replicas];
+      point.config.seed += (uint32_t) (idx % this->replicas);
+      LIN_Sim_Cluster cluster(point.config, point.numSlaves, point.backend);
+      resultJobs[idx] = cluster.run(this->duration);
+    }
+  };
+
+  // run jobs in thread pool and measure wall time
+  auto start = std::chrono::steady_clock::now();
+  for (unsigned i = 0; i < NumThreads; i++)
+    workers.emplace_back(worker);
+  for (size_t i = 0; i < workers.size(); i++)
+    workers[i].join();
+  this->timeWall = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  // sum replicas per sweep point in job order
+  this->results.assign(this->points.size(), LIN_Bus_Sim::result_t());
+  for (size_t i = 0; i < this->points.size(); i++)
+  {
+    memset(&(this->results[i]), 0, sizeof(LIN_Bus_Sim::result_t));
+    this->results[i].latencyMin = UINT32_MAX;
+    for (uint16_t k = 0; k < this->replicas; k++)
+      LIN_Bus_Sim::addResult(this->results[i], resultJobs[i * this->replicas + k]);
+  }
+
+} // LIN_Sim_Runner::run()
+
+
+
+/**
+  \brief      Print results as CSV
+  \details    Print one line per sweep point with parameters and summed results. Response space in [us], latency_p99 is the
+              upper limit of the histogram bin. Error columns count finished slave frames with the respective error bit
+  \param[in]  Out     output stream, e.g. stdout
+*/
+void LIN_Sim_Runner::printCSV(FILE *Out)
+{
+  fprintf(Out, "baudrate,noise,slaves,poll_us,jitter_us,backend,replicas,sim_s,frames,ok,missing,error,"
+    "latency_min,latency_mean,latency_p99,latency_max,slave_frames,err_state,err_echo,err_timeout,err_chk,err_sync,err_pid,glitches\n");
+  for (size_t i = 0; i < this->points.size() && i < this->results.size(); i++)
+  {
+    const LIN_Sim_Runner::point_t &point = this->points[i];
+    const LIN_Bus_Sim::result_t &result = this->results[i];
+
+    fprintf(Out, "%u,%g,%u,%u,%u,%s,%u,%.3f,%u,%u,%u,%u,", (unsigned) point.config.baudrate, point.config.noise, (unsigned) point.numSlaves,
+      (unsigned) point.config.timePoll, (unsigned) point.config.timeJitter, (point.backend == LIN_Sim_Cluster::BACKEND_PAUSE) ? "pause" : "fe",
+      (unsigned) this->replicas, (double) result.timeSim / 1e6, (unsigned) result.frames, (unsigned) result.responsesOk,
+      (unsigned) result.responsesMissing, (unsigned) result.responsesError);
+    if (result.responsesOk > 0)
+      fprintf(Out, "%u,%u,%u,%u,", (unsigned) result.latencyMin, (unsigned) (result.latencySum / result.responsesOk),
+        (unsigned) LIN_Bus_Sim::getPercentile(result, 99), (unsigned) result.latencyMax);
+    else
+      fprintf(Out, ",,,,");
+    fprintf(Out, "%u,%u,%u,%u,%u,%u,%u,%u\n", (unsigned) result.slaveFrames, (unsigned) result.slaveErrors[0],
+      (unsigned) result.slaveErrors[1], (unsigned) result.slaveErrors[2], (unsigned) result.slaveErrors[3],
+      (unsigned) result.slaveErrors[4], (unsigned) result.slaveErrors[5], (unsigned) result.glitches);
+  }
+
+} // LIN_Sim_Runner::printCSV()
+
+/*-----------------------------------------------------------------------------
+    END OF FILE
+-----------------------------------------------------------------------------*/
@@ -0,0 +1,95 @@
+/**
+  \file     LIN_sim_runner.h
+  \brief    Parallel runner for parameter sweeps of simulated LIN clusters
+  \details  Simulates independent LIN clusters (see LIN_sim_cluster.h) for a list of sweep points in a pool of worker threads.
+            Each sweep point is simulated for several seeds (replicas) and their results are summed. Results do not depend on the
+            number of threads. Requires the library variant with LIN_SLAVE_THREAD_LOCAL=thread_local, as each cluster uses the
+            static library state (instance list, 64-bit time) and virtual clock of its worker thread.
+            Only for host builds via CMake
+  \author   Georg Icking-Konert
+*/
+
+/*-----------------------------------------------------------------------------
+  MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _LIN_SIM_RUNNER_H_
+#define _LIN_SIM_RUNNER_H_
+
+
+/*-----------------------------------------------------------------------------
+  INCLUDE FILES
+-----------------------------------------------------------------------------*/
+
+#include "LIN_sim_cluster.h"
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL CLASS
+-----------------------------------------------------------------------------*/
+
+/**
+  \brief  Parallel runner for parameter sweeps of simulated LIN clusters
+*/
+class LIN_Sim_Runner
+{
+  // PUBLIC TYPES
+  public:
+
+    /// Sweep point, i.e. one cluster configuration
+    typedef struct
+    {
+      LIN_Bus_Sim::config_t       config;       //!< simulation parameters. Replica i uses seed config.seed+i
+      uint8_t                     numSlaves;    //!< number of slaves
+      LIN_Sim_Cluster::backend_t  backend;      //!< backend class of slaves
+    } point_t;
+
+
+  // PROTECTED VARIABLES
+  protected:
+
+    std::vector<LIN_Sim_Runner::point_t>      points;     //!< sweep points
+    std::vector<LIN_Bus_Sim::result_t>        results;    //!< summed results per sweep point
+    uint64_t                  duration;         //!< simulated time [us] per replica
+    uint16_t                  replicas;         //!< number of replicas per sweep point
+    double                    timeWall;         //!< wall time [s] of last run()
+
+
+  // PUBLIC METHODS
+  public:
+
+    /// @brief Class constructor
+    LIN_Sim_Runner(uint64_t Duration, uint16_t Replicas = 1);
+
+    /// @brief Add a sweep point
+    void addPoint(const LIN_Sim_Runner::point_t &Point);
+
+    /// @brief Add all combinations of baudrates, noise levels, number of slaves and handler() periods
+    void addSweep(const LIN_Sim_Runner::point_t &Base, const std::vector<uint32_t> &Baudrates, const std::vector<double> &Noise,
+      const std::vector<uint8_t> &NumSlaves, const std::vector<uint32_t> &TimePoll);
+
+    /// @brief Simulate all sweep points. NumThreads = 0 uses number of CPU cores
+    void run(unsigned NumThreads = 0);
+
+    /// @brief Number of sweep points
+    inline size_t getNumPoints(void) { return this->points.size(); }
+
+    /// @brief Summed results of a sweep point after run()
+    inline const LIN_Bus_Sim::result_t &getResult(size_t Idx) { return this->results[Idx]; }
+
+    /// @brief Wall time [s] of last run()
+    inline double getWallTime(void) { return this->timeWall; }
+
+    /// @brief Print sweep points and results as CSV
+    void printCSV(FILE *Out);
+
+}; // class LIN_Sim_Runner
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _LIN_SIM_RUNNER_H_
+
+/*-----------------------------------------------------------------------------
+    END OF FILE
+-----------------------------------------------------------------------------*/
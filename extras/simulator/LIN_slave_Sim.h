@@ -0,0 +1,105 @@
+/**
+  \file     LIN_slave_Sim.h
+  \brief    LIN slave backend for the bus simulator with BREAK detection via framing error
+  \details  Slave backend using the host HardwareSerial (see extras/host), which detects BREAK as 0x00 with framing error,
+            like the ESP32, NeoHWSerial and Termios backends. The receive times of the BREAK and of each byte are taken from the
+            serial interface, i.e. like captured in a receive ISR (see LIN_Slave_NeoHWSerial_AVR). For pause based BREAK detection use LIN_Slave_HardwareSerial instead
+  \author   Georg Icking-Konert
+*/
+
+/*-----------------------------------------------------------------------------
+  MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _LIN_SLAVE_SIM_H_
+#define _LIN_SLAVE_SIM_H_
+
+
+/*-----------------------------------------------------------------------------
+  INCLUDE FILES
+-----------------------------------------------------------------------------*/
+
+#include <LIN_slave_Static.h>
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL CLASS
+-----------------------------------------------------------------------------*/
+
+/**
+  \brief  LIN slave node class for bus simulator with BREAK detection via framing error
+*/
+class LIN_Slave_Sim : public LIN_Slave_Static<LIN_Slave_Sim>
+{
+  // static binding of serial interface methods in handler()
+  friend class LIN_Slave_Static<LIN_Slave_Sim>;
+
+  // PROTECTED VARIABLES
+  protected:
+
+    HardwareSerial        *pSerial;                         //!< host serial interface, see extras/host
+
+
+  // PROTECTED METHODS
+  protected:
+
+    /// @brief BREAK is pending, i.e. next byte is 0x00 with framing error
+    inline bool _getBreakFlag(void) { return (this->pSerial->hostFrameError()) && (this->pSerial->peek() == 0x00); }
+
+    /// @brief Take BREAK time from serial interface and remove BREAK from Rx buffer
+    inline void _resetBreakFlag(void)
+    {
+      if (this->_getBreakFlag())
+      {
+        this->timeBreak = this->pSerial->hostReceiveTime();
+        this->pSerial->read();
+      }
+    }
+
+    /// @brief read next byte from Rx buffer
+    inline uint8_t _serialRead(void) { return (uint8_t) this->pSerial->read(); }
+
+    /// @brief receive time [us] of next byte in Rx buffer
+    inline uint32_t _getReceiveTime(void) { return this->pSerial->hostReceiveTime(); }
+
+    /// @brief write bytes to Tx buffer
+    inline void _serialWrite(uint8_t buf[], uint8_t num) { this->pSerial->write(buf, num); }
+
+    /// @brief change baudrate of serial interface, e.g. for auto-baud or clock trim. Bus simulator samples at this baudrate
+    virtual inline void _setBaudrate(uint32_t Baudrate) { this->pSerial->begin(Baudrate); }
+
+
+  // PUBLIC METHODS
+  public:
+
+    /// @brief Class constructor
+    LIN_Slave_Sim(HardwareSerial &Interface, LIN_Slave_Base::version_t Version = LIN_Slave_Base::LIN_V2, const char NameLIN[] = "Sim",
+      uint32_t TimeoutRx = 1500L) : LIN_Slave_Static<LIN_Slave_Sim>(Version, NameLIN, TimeoutRx) { this->pSerial = &Interface; }
+
+    /// @brief Open serial interface
+    inline void begin(uint32_t Baudrate = 19200)
+    {
+      LIN_Slave_Base::begin(Baudrate);
+      this->pSerial->begin(this->baudrate);
+    }
+
+    /// @brief Close serial interface
+    inline void end(void)
+    {
+      LIN_Slave_Base::end();
+      this->pSerial->end();
+    }
+
+    /// @brief check if a byte is available in Rx buffer
+    inline bool available(void) { return (this->pSerial->available() > 0); }
+
+}; // class LIN_Slave_Sim
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _LIN_SLAVE_SIM_H_
+
+/*-----------------------------------------------------------------------------
+    END OF FILE
+-----------------------------------------------------------------------------*/
@@ -0,0 +1,87 @@
+/**
+  \file     lin_sim.cpp
+  \brief    Command line LIN bus simulator
+  \details  Simulates a LIN cluster with the bus simulator and prints results, see LIN_bus_sim.h and LIN_sim_cluster.h.
+            Usage: lin_sim [--baud N] [--seconds N] [--slaves N] [--poll us] [--jitter us] [--noise p] [--seed N]
+                           [--backend pause|fe] [--collision]
+            Only for host builds via CMake
+  \author   Georg Icking-Konert
+*/
+
+// include files
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include "LIN_sim_cluster.h"
+
+
+// print usage and exit
+static void usage(const char *name)
+{
+  fprintf(stderr, "usage: %s [--baud N] [--seconds N] [--slaves N] [--poll us] [--jitter us] [--noise p] [--seed N]\n", name);
+  fprintf(stderr, "       [--backend pause|fe] [--collision]\n");
+  exit(1);
+}
+
+
+int main(int argc, char *argv[])
+{
+  LIN_Bus_Sim::config_t       config = LIN_Bus_Sim::defaultConfig();
+  LIN_Sim_Cluster::backend_t  backend = LIN_Sim_Cluster::BACKEND_FE;
+  double                      seconds = 10.0;
+  int                         numSlaves = 4;
+  bool                        collision = false;
+
+  // parse options
+  for (int i = 1; i < argc; i++)
+  {
+    const char *opt = argv[i];
+    const char *val = (i + 1 < argc) ? argv[i + 1] : NULL;
+
+    if (strcmp(opt, "--collision") == 0)
+    {
+      collision = true;
+      continue;
+    }
+    if (val == NULL)
+      usage(argv[0]);
+    if (strcmp(opt, "--baud") == 0)
+      config.baudrate = (uint32_t) strtoul(val, NULL, 0);
+    else if (strcmp(opt, "--seconds") == 0)
+      seconds = strtod(val, NULL);
+    else if (strcmp(opt, "--slaves") == 0)
+      numSlaves = atoi(val);
+    else if (strcmp(opt, "--poll") == 0)
+      config.timePoll = (uint32_t) strtoul(val, NULL, 0);
+    else if (strcmp(opt, "--jitter") == 0)
+      config.timeJitter = (uint32_t) strtoul(val, NULL, 0);
+    else if (strcmp(opt, "--noise") == 0)
+      config.noise = strtod(val, NULL);
+    else if (strcmp(opt, "--seed") == 0)
+      config.seed = (uint32_t) strtoul(val, NULL, 0);
+    else if ((strcmp(opt, "--backend") == 0) && (strcmp(val, "pause") == 0))
+      backend = LIN_Sim_Cluster::BACKEND_PAUSE;
+    else if ((strcmp(opt, "--backend") == 0) && (strcmp(val, "fe") == 0))
+      backend = LIN_Sim_Cluster::BACKEND_FE;
+    else
+      usage(argv[0]);
+    i++;
+  }
+  if ((numSlaves < 1) || (numSlaves > 16) || (seconds <= 0.0) || (config.noise < 0.0) || (config.noise >= 1.0))
+    usage(argv[0]);
+
+  // simulate cluster and measure wall time
+  LIN_Sim_Cluster cluster(config, (uint8_t) numSlaves, backend, collision);
+  auto start = std::chrono::steady_clock::now();
+  const LIN_Bus_Sim::result_t &result = cluster.run((uint64_t) (seconds * 1e6));
+  double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  // print results
+  printf("cluster          %d slaves (%s), %u Baud, poll %u us + jitter %u us, noise %g, seed %u\n", numSlaves,
+    (backend == LIN_Sim_Cluster::BACKEND_PAUSE) ? "pause" : "fe", (unsigned) config.baudrate, (unsigned) config.timePoll,
+    (unsigned) config.timeJitter, config.noise, (unsigned) config.seed);
+  LIN_Bus_Sim::printResult(result, stdout);
+  printf("wall time        %.3f s (%.0fx real time)\n", wall, (wall > 0.0) ? (seconds / wall) : 0.0);
+
+  return 0;
+}
@@ -0,0 +1,103 @@
+/**
+  \file     lin_sim_sweep.cpp
+  \brief    Command line parameter sweep of simulated LIN clusters
+  \details  Simulates all combinations of the given parameter lists in parallel and prints results as CSV to stdout,
+            and wall time to stderr, see LIN_sim_runner.h.
+            Usage: lin_sim_sweep [--baud list] [--noise list] [--slaves list] [--poll list] [--jitter us] [--seconds N]
+                                 [--replicas N] [--threads N] [--seed N] [--backend pause|fe]
+            Lists are comma separated, e.g. --baud 9600,19200. Only for host builds via CMake
+  \author   Georg Icking-Konert
+*/
+
+// include files
+#include <stdlib.h>
+#include <string.h>
+#include "LIN_sim_runner.h"
+
+
+// print usage and exit
+static void usage(const char *name)
+{
+  fprintf(stderr, "usage: %s [--baud list] [--noise list] [--slaves list] [--poll list] [--jitter us] [--seconds N]\n", name);
+  fprintf(stderr, "       [--replicas N] [--threads N] [--seed N] [--backend pause|fe]\n");
+  exit(1);
+}
+
+// parse comma separated list of numbers
+template <typename T> static std::vector<T> parseList(const char *Str)
+{
+  std::vector<T>  list;
+  char            *end;
+
+  while (*Str != '\0')
+  {
+    list.push_back((T) strtod(Str, &end));
+    if ((end == Str) || ((*end != ',') && (*end != '\0')))
+      return std::vector<T>();
+    Str = (*end == ',') ? end + 1 : end;
+  }
+  return list;
+}
+
+
+int main(int argc, char *argv[])
+{
+  LIN_Sim_Runner::point_t   base;
+  std::vector<uint32_t>     baudrates(1, 19200), timePoll(1, 100);
+  std::vector<double>       noise(1, 0.0);
+  std::vector<uint8_t>      numSlaves(1, 4);
+  double                    seconds = 10.0;
+  unsigned                  replicas = 1, numThreads = 0;
+
+  // defaults
+  base.config    = LIN_Bus_Sim::defaultConfig();
+  base.numSlaves = 4;
+  base.backend   = LIN_Sim_Cluster::BACKEND_FE;
+
+  // parse options
+  for (int i = 1; i + 1 < argc; i += 2)
+  {
+    const char *opt = argv[i];
+    const char *val = argv[i + 1];
+
+    if (strcmp(opt, "--baud") == 0)
+      baudrates = parseList<uint32_t>(val);
+    else if (strcmp(opt, "--noise") == 0)
+      noise = parseList<double>(val);
+    else if (strcmp(opt, "--slaves") == 0)
+      numSlaves = parseList<uint8_t>(val);
+    else if (strcmp(opt, "--poll") == 0)
+      timePoll = parseList<uint32_t>(val);
+    else if (strcmp(opt, "--jitter") == 0)
+      base.config.timeJitter = (uint32_t) strtoul(val, NULL, 0);
+    else if (strcmp(opt, "--seconds") == 0)
+      seconds = strtod(val, NULL);
+    else if (strcmp(opt, "--replicas") == 0)
+      replicas = (unsigned) strtoul(val, NULL, 0);
+    else if (strcmp(opt, "--threads") == 0)
+      numThreads = (unsigned) strtoul(val, NULL, 0);
+    else if (strcmp(opt, "--seed") == 0)
+      base.config.seed = (uint32_t) strtoul(val, NULL, 0);
+    else if ((strcmp(opt, "--backend") == 0) && (strcmp(val, "pause") == 0))
+      base.backend = LIN_Sim_Cluster::BACKEND_PAUSE;
+    else if ((strcmp(opt, "--backend") == 0) && (strcmp(val, "fe") == 0))
+      base.backend = LIN_Sim_Cluster::BACKEND_FE;
+    else
+      usage(argv[0]);
+  }
+  if ((argc % 2 == 0) || baudrates.empty() || noise.empty() || numSlaves.empty() || timePoll.empty() || (seconds <= 0.0) ||
+    (replicas < 1) || (replicas > 0xFFFF))
+    usage(argv[0]);
+
+  // run sweep in parallel
+  LIN_Sim_Runner runner((uint64_t) (seconds * 1e6), (uint16_t) replicas);
+  runner.addSweep(base, baudrates, noise, numSlaves, timePoll);
+  runner.run(numThreads);
+
+  // print results
+  runner.printCSV(stdout);
+  fprintf(stderr, "%u clusters x %u replicas, %.1f s simulated each, wall time %.3f s\n", (unsigned) runner.getNumPoints(), replicas,
+    seconds, runner.getWallTime());
+
+  return 0;
+}
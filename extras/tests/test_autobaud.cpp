@@ -0,0 +1,177 @@
+/**
+  \file     test_autobaud.cpp
+  \brief    Host test of auto-baud detection and clock trim with the bit-level bus simulator
+  \details  A slave with auto-baud detection starts at the first candidate baudrate and locks to masters at 19200, 10417 and
+            9600 Baud. Checks the number of frames until lock, that no response is sent before lock, and that detection restarts
+            after LIN_SLAVE_AUTOBAUD_RETRY errors if the master changes its baudrate. A master clock deviation of +/-5% is measured
+            via getClockDeviation(), and setClockTrim() trims the UART of the slave to the master
+  \author   Georg Icking-Konert
+*/
+
+// include files
+#include <stdlib.h>
+#include <LIN_bus_sim.h>
+#include <LIN_slave_Sim.h>
+#include "test_common.h"
+
+
+// slot time [us] per frame. Simulation runs frame by frame, i.e. bus is idle between runs
+#define TIME_SLOT       20000
+
+// frames to lock: slave starts at 19200 Baud and tries 10417, then 9600 Baud
+#define FRAMES_19200    1
+#define FRAMES_10417    2
+#define FRAMES_9600     3
+
+
+// master request callback
+void masterRequest(uint8_t numData, uint8_t* data)
+{
+  (void) numData;
+  (void) data;
+}
+
+// slave response callback
+void slaveResponse(uint8_t numData, uint8_t* data)
+{
+  for (uint8_t i=0; i<numData; i++)
+    data[i] = (uint8_t) (0xA0 + i);
+}
+
+// master schedule: request and response, one frame per slot
+static const LIN_Bus_Sim::schedule_t schedule[2] = {
+  { 0x10, true,  4, { 1, 2, 3, 4, 0, 0, 0, 0 }, TIME_SLOT },
+  { 0x20, false, 2, { 0, 0, 0, 0, 0, 0, 0, 0 }, TIME_SLOT } };
+
+// simulation config for master baudrate
+static LIN_Bus_Sim::config_t busConfig(uint32_t Baudrate)
+{
+  LIN_Bus_Sim::config_t config = LIN_Bus_Sim::defaultConfig();
+  config.baudrate = Baudrate;
+  return config;
+}
+
+// run frame by frame until slave lock state is reached, return number of frames (0 = not within MaxFrames)
+static uint16_t runUntilLock(LIN_Bus_Sim &Bus, LIN_Slave_Base &Slave, bool FlagLocked, uint16_t MaxFrames)
+{
+  for (uint16_t i=1; i<=MaxFrames; i++)
+  {
+    Bus.run(TIME_SLOT);
+    if (Slave.getBaudLocked() == FlagLocked)
+      return i;
+  }
+  return 0;
+}
+
+
+int main()
+{
+  HardwareSerial    serial;
+
+  // lock to master baudrate. First frame starts after 10ms, then one frame per slot
+  const uint32_t    baudMaster[3] = { 19200, 10417, 9600 };
+  const uint16_t    framesLock[3] = { FRAMES_19200, FRAMES_10417, FRAMES_9600 };
+  for (uint8_t k=0; k<3; k++)
+  {
+    LIN_Slave_Sim   LIN(serial, LIN_Slave_Base::LIN_V2, "Auto");
+    LIN_Bus_Sim     bus(busConfig(baudMaster[k]));
+
+    LIN.begin(19200);
+    LIN.setAutoBaud(true);
+    LIN.registerMasterRequestHandler(0x10, masterRequest, 4);
+    LIN.registerSlaveResponseHandler(0x20, slaveResponse, 2);
+    bus.addSlave(LIN, serial);
+    bus.setSchedule(schedule, 2);
+    bus.run(TIME_SLOT/2);
+    CHECK(!LIN.getBaudLocked());
+
+    // locked within expected number of frames to master baudrate
+    CHECK_EQ(runUntilLock(bus, LIN, true, 10), framesLock[k]);
+    CHECK_EQ(LIN.getBaudrate(), baudMaster[k]);
+    CHECK_EQ(serial.hostBaudrate(), baudMaster[k]);
+
+    // no response before lock, all responses ok afterwards
+    bus.clearResult();
+    bus.run(10 * TIME_SLOT);
+    CHECK_EQ(bus.getResult().frames, 10);
+    CHECK_EQ(bus.getResult().responsesOk, 5);
+    CHECK_EQ(bus.getResult().responsesError, 0);
+    CHECK_EQ(bus.getResult().responsesMissing, 0);
+    CHECK(LIN.getBaudLocked());
+
+    LIN.end();
+  }
+
+  // master changes baudrate: lock is kept for LIN_SLAVE_AUTOBAUD_RETRY-1 SYNC/PID errors, then detection restarts at next candidate
+  {
+    LIN_Slave_Sim   LIN(serial, LIN_Slave_Base::LIN_V2, "Auto");
+    LIN_Bus_Sim     bus(busConfig(19200));
+
+    LIN.begin(19200);
+    LIN.setAutoBaud(true);
+    LIN.registerMasterRequestHandler(0x10, masterRequest, 4);
+    LIN.registerSlaveResponseHandler(0x20, slaveResponse, 2);
+    bus.addSlave(LIN, serial);
+    bus.setSchedule(schedule, 2);
+    bus.run(TIME_SLOT/2);
+    CHECK_EQ(runUntilLock(bus, LIN, true, 10), FRAMES_19200);
+
+    // 1st frame: 1 error. 2nd frame: 2 errors, i.e. a frame at 9600 Baud may be received as several garbled headers at 19200 Baud
+    bus.setBaudrate(9600);
+    CHECK_EQ(runUntilLock(bus, LIN, false, 1), 0);
+    CHECK_EQ(runUntilLock(bus, LIN, false, 1), 1);
+    CHECK_EQ(LIN.getBaudrate(), 10417);
+
+    // 10417 Baud fails on 1st frame, 9600 Baud is locked with 2nd frame
+    CHECK_EQ(runUntilLock(bus, LIN, true, 10), 2);
+    CHECK_EQ(LIN.getBaudrate(), 9600);
+    bus.clearResult();
+    bus.run(10 * TIME_SLOT);
+    CHECK_EQ(bus.getResult().responsesOk, 5);
+    CHECK_EQ(bus.getResult().responsesError, 0);
+
+    LIN.end();
+  }
+
+  // master clock +/-5%: deviation is measured in local clock, trim sets UART to master baudrate and nominal is restored on disable
+  const uint32_t    baudClock[2] = { 20160, 18240 };
+  const int16_t     deviation[2] = { -476, 526 };
+  for (uint8_t k=0; k<2; k++)
+  {
+    LIN_Slave_Sim   LIN(serial, LIN_Slave_Base::LIN_V2, "Trim");
+    LIN_Bus_Sim     bus(busConfig(baudClock[k]));
+
+    LIN.begin(19200);
+    LIN.registerMasterRequestHandler(0x10, masterRequest, 4);
+    LIN.registerSlaveResponseHandler(0x20, slaveResponse, 2);
+    bus.addSlave(LIN, serial);
+    bus.setSchedule(schedule, 2);
+    CHECK_EQ(LIN.getClockDeviation(), 0);
+
+    // measurement without trim, UART keeps nominal baudrate
+    bus.run(20 * TIME_SLOT);
+    CHECK(abs(LIN.getClockDeviation() - deviation[k]) < 30);
+    CHECK_EQ(serial.hostBaudrate(), 19200);
+    CHECK_EQ(bus.getResult().responsesError, 0);
+    CHECK_EQ(bus.getResult().responsesMissing, 0);
+
+    // trim UART to master clock
+    LIN.setClockTrim(true);
+    bus.clearResult();
+    bus.run(20 * TIME_SLOT);
+    CHECK(abs((int32_t) serial.hostBaudrate() - (int32_t) baudClock[k]) < 150);
+    CHECK_EQ(LIN.getBaudrate(), 19200);
+    CHECK_EQ(bus.getResult().responsesOk, 10);
+    CHECK_EQ(bus.getResult().responsesError, 0);
+    for (uint8_t i=0; i<8; i++)
+      CHECK_EQ(bus.getResult().slaveErrors[i], 0);
+
+    // disable restores nominal baudrate
+    LIN.setClockTrim(false);
+    CHECK_EQ(serial.hostBaudrate(), 19200);
+
+    LIN.end();
+  }
+
+  return TEST_RESULT();
+}
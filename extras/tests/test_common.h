@@ -0,0 +1,155 @@
+/**
+  \file     test_common.h
+  \brief    Minimal test helpers for host tests of the LIN slave library
+  \details  Check macros, a stub backend and helpers to feed LIN frames into the host HardwareSerial shim with a virtual clock.
+            No external test framework required. Each test is a separate executable, see CMakeLists.txt in the root folder
+  \author   Georg Icking-Konert
+*/
+
+/*-----------------------------------------------------------------------------
+  MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _TEST_COMMON_H_
+#define _TEST_COMMON_H_
+
+
+/*-----------------------------------------------------------------------------
+  INCLUDE FILES
+-----------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <Arduino.h>
+#include <LIN_slave_Static.h>
+#include <LIN_slave_Protocol.h>
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL MACROS
+-----------------------------------------------------------------------------*/
+
+/// number of failed checks
+static int testNumFailed = 0;
+
+/// check condition, print location on failure and continue
+#define CHECK(cond)       do { if (!(cond)) { testNumFailed++; printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); } } while (0)
+
+/// check equality of integers, print values on failure and continue
+#define CHECK_EQ(a, b)    do { long _a = (long) (a), _b = (long) (b); if (_a != _b) { testNumFailed++; \
+                            printf("%s:%d: CHECK_EQ(%s, %s) failed: %ld != %ld\n", __FILE__, __LINE__, #a, #b, _a, _b); } } while (0)
+
+/// return exit code of test
+#define TEST_RESULT()     ((testNumFailed == 0) ? (printf("passed\n"), 0) : (printf("%d checks failed\n", testNumFailed), 1))
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL FUNCTIONS
+-----------------------------------------------------------------------------*/
+
+/// byte duration [us] at 19200 Baud (10 bits)
+#define TEST_TIME_BYTE    521
+
+/**
+  \brief      Receive a byte and call handler
+  \details    Advance virtual clock by one byte time, inject byte into serial interface and call handler() once per byte
+  \param[in]  Slave     LIN slave node
+  \param[in]  Interface serial interface of node
+  \param[in]  Byte      received byte
+  \param[in]  Pause     additional pause [us] before byte
+*/
+template <class T> void testReceive(T &Slave, HardwareSerial &Interface, uint8_t Byte, uint32_t Pause = 0)
+{
+  ArduinoHost::advanceMicros(Pause + TEST_TIME_BYTE);
+  Interface.hostReceive(Byte);
+  Slave.handler();
+}
+
+/**
+  \brief      Receive a frame header
+  \details    Receive BREAK (as 0x00 after pause, see LIN_Slave_HardwareSerial), SYNC and PID
+  \param[in]  Slave     LIN slave node
+  \param[in]  Interface serial interface of node
+  \param[in]  ID        frame ID (unprotected)
+*/
+template <class T> void testHeader(T &Slave, HardwareSerial &Interface, uint8_t ID)
+{
+  testReceive(Slave, Interface, 0x00, 5000);
+  testReceive(Slave, Interface, 0x55);
+  testReceive(Slave, Interface, LIN_Slave_Protocol::getPID(ID));
+}
+
+/**
+  \brief      Receive a master request frame
+  \details    Receive header, data and enhanced (LIN2.x) checksum
+  \param[in]  Slave     LIN slave node
+  \param[in]  Interface serial interface of node
+  \param[in]  ID        frame ID (unprotected)
+  \param[in]  Data      data bytes
+  \param[in]  NumData   number of data bytes
+*/
+template <class T> void testRequest(T &Slave, HardwareSerial &Interface, uint8_t ID, const uint8_t Data[], uint8_t NumData)
+{
+  testHeader(Slave, Interface, ID);
+  for (uint8_t i=0; i<NumData; i++)
+    testReceive(Slave, Interface, Data[i]);
+  testReceive(Slave, Interface, LIN_Slave_Protocol::checksum(LIN_Slave_Protocol::getSeed(ID, true), Data, NumData));
+}
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL CLASS
+-----------------------------------------------------------------------------*/
+
+/**
+  \brief  Test backend without serial interface
+
+  \details Test backend without serial interface. Bytes are handled via receive(), i.e. like in the receive ISR of
+           LIN_Slave_NeoHWSerial_AVR, and sent bytes are stored in bufTx[]. Tests may derive from it to access protected members
+  \tparam  FlagISR   LIN state machine runs only in receive ISR, i.e. handler() doesn't check timeouts (see LIN_SLAVE_HANDLER_IN_ISR)
+*/
+template <bool FlagISR = false> class LIN_Slave_Test : public LIN_Slave_Static< LIN_Slave_Test<FlagISR> >
+{
+  friend class LIN_Slave_Static< LIN_Slave_Test<FlagISR> >;
+
+  protected:
+    static const bool   flagHandlerISR = FlagISR;
+    bool _getBreakFlag(void) { return false; }
+    void _resetBreakFlag(void) { }
+    inline uint8_t _serialRead(void) { return 0x00; }
+    void _serialWrite(uint8_t buf[], uint8_t num)
+    {
+      for (uint8_t i=0; (i<num) && (this->numTx < sizeof(this->bufTx)); i++)
+        this->bufTx[(this->numTx)++] = buf[i];
+    }
+
+  public:
+    uint8_t             bufTx[32];              //!< sent bytes
+    uint8_t             numTx;                  //!< number of sent bytes
+
+    LIN_Slave_Test(const char NameLIN[] = "Test") : LIN_Slave_Static< LIN_Slave_Test<FlagISR> >(LIN_Slave_Base::LIN_V2, NameLIN) { numTx = 0; }
+    inline bool available(void) { return false; }
+
+    /// emulate receive ISR: byte or BREAK after optional pause [us], at current virtual time
+    void receive(uint8_t Byte, bool FlagBreak = false, uint32_t Pause = 0)
+    {
+      ArduinoHost::advanceMicros(Pause + TEST_TIME_BYTE);
+      this->_handleReceiveISR(Byte, FlagBreak, micros());
+    }
+
+    /// receive data bytes and enhanced checksum of ID back-to-back
+    void receiveData(uint8_t ID, const uint8_t Data[], uint8_t NumData)
+    {
+      for (uint8_t i=0; i<NumData; i++)
+        this->receive(Data[i]);
+      this->receive(LIN_Slave_Protocol::checksum(LIN_Slave_Protocol::getSeed(ID, true), Data, NumData));
+    }
+};
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _TEST_COMMON_H_
+
+/*-----------------------------------------------------------------------------
+    END OF FILE
+-----------------------------------------------------------------------------*/
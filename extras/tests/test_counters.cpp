@@ -0,0 +1,193 @@
+/**
+  \file     test_counters.cpp
+  \brief    Host test of traffic and error counters (LIN_SLAVE_ID_COUNTERS)
+  \details  Frames with and without errors are received on a virtual clock. Checks the counters per ID via getCounters(),
+            the bus level counters via getBusCounters(), the health moving average incl. recovery to 255 and decay to 0,
+            saturation of the error counters, and resetCounters()
+  \author   Georg Icking-Konert
+*/
+
+// include files
+#include <LIN_slave_Sim.h>
+#include "test_common.h"
+
+
+// frame timeout [us] for polling, longer than any frame at 19200 Baud
+#define TIME_TIMEOUT    20000
+
+
+// master request callback
+void masterRequest(uint8_t numData, uint8_t* data)
+{
+  (void) numData;
+  (void) data;
+}
+
+// slave response callback
+void slaveResponse(uint8_t numData, uint8_t* data)
+{
+  for (uint8_t i=0; i<numData; i++)
+    data[i] = (uint8_t) (0xA0 + i);
+}
+
+// receive byte one byte time (plus pause) after previous byte and call handler()
+static void receive(LIN_Slave_Sim &Slave, uint8_t Byte, bool FlagBreak = false, uint32_t Pause = 0)
+{
+  ArduinoHost::advanceMicros(Pause + TEST_TIME_BYTE);
+  Serial1.hostReceive(Byte, FlagBreak);
+  Slave.handler();
+}
+
+// receive BREAK, SYNC and PID
+static void header(LIN_Slave_Sim &Slave, uint8_t PID)
+{
+  receive(Slave, 0x00, true, 5000);
+  receive(Slave, 0x55);
+  receive(Slave, PID);
+}
+
+// receive master request with first NumBytes of data + checksum. Checksum is inverted if FlagChkError is set
+static void request(LIN_Slave_Sim &Slave, uint8_t ID, uint8_t NumData, uint8_t NumBytes, bool FlagChkError = false)
+{
+  uint8_t   bytes[9] = { 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x00 };
+
+  bytes[NumData] = LIN_Slave_Protocol::checksum(LIN_Slave_Protocol::getSeed(ID, true), bytes, NumData);
+  if (FlagChkError)
+    bytes[NumData] = (uint8_t) ~bytes[NumData];
+  header(Slave, LIN_Slave_Protocol::getPID(ID));
+  for (uint8_t i=0; i<NumBytes; i++)
+    receive(Slave, bytes[i]);
+}
+
+// poll handler() until frame timeout
+static void waitTimeout(LIN_Slave_Sim &Slave)
+{
+  for (uint16_t t=0; t<TIME_TIMEOUT; t+=100)
+  {
+    ArduinoHost::advanceMicros(100);
+    Slave.handler();
+  }
+}
+
+// check counters of ID
+static bool checkCounters(LIN_Slave_Sim &Slave, uint8_t ID, uint16_t Ok, uint8_t Chk, uint8_t Echo, uint8_t Pid, uint8_t Timeout, uint8_t Health)
+{
+  LIN_Slave_Base::id_counters_t   cnt;
+
+  Slave.getCounters(ID, cnt);
+  if ((cnt.ok != Ok) || (cnt.chk != Chk) || (cnt.echo != Echo) || (cnt.pid != Pid) || (cnt.timeout != Timeout) || (cnt.health != Health))
+  {
+    printf("ID 0x%02X: ok=%u chk=%u echo=%u pid=%u timeout=%u health=%u\n", ID, cnt.ok, cnt.chk, cnt.echo, cnt.pid, cnt.timeout, cnt.health);
+    return false;
+  }
+  return true;
+}
+
+
+int main()
+{
+  LIN_Slave_Sim                   LIN(Serial1, LIN_Slave_Base::LIN_V2, "Counters");
+  LIN_Slave_Base::bus_counters_t  bus;
+  uint8_t                         buf[16];
+  uint16_t                        num;
+
+  ArduinoHost::useVirtualTime(true);
+  ArduinoHost::setMicros(100000);
+  LIN.begin(19200);
+  LIN.registerMasterRequestHandler(0x10, masterRequest, 4);
+  LIN.registerMasterRequestHandler(0x11, masterRequest, 1);
+  LIN.registerSlaveResponseHandler(0x20, slaveResponse, 2);
+
+  // initially all counters are 0 and health is 255
+  CHECK(checkCounters(LIN, 0x10, 0, 0, 0, 0, 0, 255));
+  LIN.getBusCounters(bus);
+  CHECK_EQ(bus.bytes, 0);
+  CHECK_EQ(bus.breaks, 0);
+
+  // frames without error: health stays at 255. Bytes = SYNC, PID, 4 data, checksum
+  for (uint8_t i=0; i<3; i++)
+    request(LIN, 0x10, 4, 5);
+  CHECK(checkCounters(LIN, 0x10, 3, 0, 0, 0, 0, 255));
+  LIN.getBusCounters(bus);
+  CHECK_EQ(bus.bytes, 3*7);
+  CHECK_EQ(bus.breaks, 3);
+
+  // checksum errors: health decays by 1/8 (rounded up), first ok frame recovers by 1/8 of distance to 255
+  request(LIN, 0x10, 4, 5, true);
+  CHECK(checkCounters(LIN, 0x10, 3, 1, 0, 0, 0, 223));
+  request(LIN, 0x10, 4, 5, true);
+  CHECK(checkCounters(LIN, 0x10, 3, 2, 0, 0, 0, 195));
+  request(LIN, 0x10, 4, 5);
+  CHECK(checkCounters(LIN, 0x10, 4, 2, 0, 0, 0, 203));
+  CHECK_EQ(LIN.getHealth(0x10), 203);
+  CHECK_EQ(LIN.getHealth(LIN_Slave_Protocol::getPID(0x10)), 203);
+
+  // PID parity error is counted for ID of corrupted PID
+  header(LIN, LIN_Slave_Protocol::getPID(0x10) ^ 0x80);
+  CHECK_EQ(LIN.getState(), LIN_Slave_Base::STATE_DONE);
+  CHECK(checkCounters(LIN, 0x10, 4, 2, 0, 1, 0, 177));
+
+  // timeout after PID is counted for ID
+  request(LIN, 0x10, 4, 2);
+  waitTimeout(LIN);
+  CHECK(checkCounters(LIN, 0x10, 4, 2, 0, 1, 1, 154));
+
+  // health recovers to exactly 255 with ok frames, i.e. doesn't get stuck below due to rounding
+  for (uint8_t i=0; i<40; i++)
+    request(LIN, 0x10, 4, 5);
+  CHECK(checkCounters(LIN, 0x10, 44, 2, 0, 1, 1, 255));
+
+  // slave response: ok and echo error
+  header(LIN, LIN_Slave_Protocol::getPID(0x20));
+  num = Serial1.hostTransmit(buf, sizeof(buf));
+  CHECK_EQ(num, 3);
+  for (uint8_t i=0; i<num; i++)
+    receive(LIN, buf[i]);
+  header(LIN, LIN_Slave_Protocol::getPID(0x20));
+  num = Serial1.hostTransmit(buf, sizeof(buf));
+  receive(LIN, (uint8_t) ~buf[0]);
+  CHECK(checkCounters(LIN, 0x20, 1, 0, 1, 0, 0, 223));
+
+  // continuous errors: counters saturate at 255 and health decays to exactly 0
+  for (uint16_t i=0; i<300; i++)
+    request(LIN, 0x11, 1, 2, true);
+  CHECK(checkCounters(LIN, 0x11, 0, 255, 0, 0, 0, 0));
+
+  // other IDs are not affected
+  CHECK(checkCounters(LIN, 0x10, 44, 2, 0, 1, 1, 255));
+  CHECK(checkCounters(LIN, 0x3F, 0, 0, 0, 0, 0, 255));
+
+  // bus level: SYNC error, timeout before PID, frame for other slave
+  LIN.getBusCounters(bus);
+  CHECK_EQ(bus.sync, 0);
+  CHECK_EQ(bus.timeout, 0);
+  CHECK_EQ(bus.other, 0);
+  receive(LIN, 0x00, true, 5000);
+  receive(LIN, 0x54);
+  receive(LIN, 0x00, true, 5000);
+  receive(LIN, 0x55);
+  waitTimeout(LIN);
+  header(LIN, LIN_Slave_Protocol::getPID(0x30));
+  LIN.getBusCounters(bus);
+  CHECK_EQ(bus.sync, 1);
+  CHECK_EQ(bus.timeout, 1);
+  CHECK_EQ(bus.other, 1);
+  CHECK_EQ(bus.resync, 0);
+  CHECK_EQ(bus.breaks, 3 + 2 + 1 + 1 + 1 + 40 + 2 + 300 + 3);
+
+  // reset clears all counters and sets health to 255
+  LIN.resetCounters();
+  CHECK(checkCounters(LIN, 0x10, 0, 0, 0, 0, 0, 255));
+  CHECK(checkCounters(LIN, 0x11, 0, 0, 0, 0, 0, 255));
+  CHECK(checkCounters(LIN, 0x20, 0, 0, 0, 0, 0, 255));
+  LIN.getBusCounters(bus);
+  CHECK_EQ(bus.bytes, 0);
+  CHECK_EQ(bus.breaks, 0);
+  CHECK_EQ(bus.sync, 0);
+  CHECK_EQ(bus.timeout, 0);
+  CHECK_EQ(bus.other, 0);
+
+  LIN.end();
+
+  return TEST_RESULT();
+}
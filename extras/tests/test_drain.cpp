@@ -0,0 +1,115 @@
+/**
+  \file     test_drain.cpp
+  \brief    Host test of handlerDrain() with a backlog of received bytes
+  \details  Several frames are pending in the Rx buffer, e.g. if loop() was blocked. Checks that handlerDrain() handles
+            all bytes of one frame per call, stops after each completed frame and respects MaxBytes, both for the
+            statically bound version and for LIN_Slave_Base::handlerDrain() via base class pointer. Frame timestamps must be the
+            receive times of the bytes, not the time of handling
+  \author   Georg Icking-Konert
+*/
+
+// include files
+#include <LIN_slave_Sim.h>
+#include "test_common.h"
+
+
+// master request callback: count frames and check data
+static uint8_t  numRequest = 0;
+static uint8_t  dataRequest[4];
+void masterRequest(uint8_t numData, uint8_t* data)
+{
+  (void) numData;
+  numRequest++;
+  memcpy(dataRequest, data, 4);
+}
+
+// inject master request ID 0x10 with data k, k+1, .. into Rx buffer with receive times. Returns number of Rx buffer entries
+static uint8_t injectFrame(uint8_t k)
+{
+  uint8_t data[4] = { k, (uint8_t) (k+1), (uint8_t) (k+2), (uint8_t) (k+3) };
+  uint8_t frame[7] = { 0x55, LIN_Slave_Protocol::getPID(0x10), data[0], data[1], data[2], data[3],
+    LIN_Slave_Protocol::checksum(LIN_Slave_Protocol::getSeed(0x10, true), data, 4) };
+
+  ArduinoHost::advanceMicros(2000);
+  Serial1.hostReceive(0x00, true);
+  for (uint8_t i=0; i<7; i++)
+  {
+    ArduinoHost::advanceMicros(TEST_TIME_BYTE);
+    Serial1.hostReceive(frame[i]);
+  }
+  return 8;
+}
+
+
+int main()
+{
+  LIN_Slave_Sim                   LIN(Serial1, LIN_Slave_Base::LIN_V2, "Drain");
+  LIN_Slave_Base                  *pLIN = &LIN;
+  LIN_Slave_Base::frame_record_t  frame;
+  const uint8_t                   numFrames = 5;
+
+  // virtual clock for deterministic timing
+  ArduinoHost::useVirtualTime(true);
+  ArduinoHost::setMicros(100000);
+  LIN.begin(19200);
+  LIN.registerMasterRequestHandler(0x10, masterRequest, 4);
+
+  // backlog of frames, e.g. loop() blocked for 10ms. Statically bound and virtual handlerDrain() behave the same
+  for (uint8_t mode=0; mode<2; mode++)
+  {
+    uint32_t timeInject = micros();
+    numRequest = 0;
+    for (uint8_t k=0; k<numFrames; k++)
+      injectFrame(0x10*k);
+    ArduinoHost::advanceMicros(10000);
+
+    // each call handles one frame and stops at frame end. BREAK and SYNC are handled in the same handler() call
+    for (uint8_t k=0; k<numFrames; k++)
+    {
+      uint8_t num = (mode == 0) ? LIN.handlerDrain() : pLIN->handlerDrain();
+      CHECK_EQ(num, 7);
+      CHECK_EQ(LIN.getState(), LIN_Slave_Base::STATE_DONE);
+      CHECK_EQ(LIN.getError(), LIN_Slave_Base::NO_ERROR);
+      CHECK_EQ(numRequest, k+1);
+      CHECK_EQ(dataRequest[0], 0x10*k);
+      CHECK_EQ(Serial1.available(), 8*(numFrames-1-k));
+    }
+
+    // all frames in queue, none lost. Timestamps are receive times of bytes, not handling times
+    for (uint8_t k=0; k<LIN_SLAVE_FRAME_QUEUE; k++)
+    {
+      uint32_t timeBreak = timeInject + 2000 + k*(2000 + 7*TEST_TIME_BYTE);
+      CHECK(LIN.readFrame(frame));
+      CHECK_EQ(frame.data[3], 0x10*k + 3);
+      CHECK_EQ(frame.timeStart, timeBreak);
+      CHECK_EQ(frame.timePID, timeBreak + 2*TEST_TIME_BYTE);
+      CHECK_EQ(frame.timeEnd, timeBreak + 7*TEST_TIME_BYTE);
+    }
+    CHECK_EQ(LIN.getQueueOverflow(), (mode+1) * (numFrames - LIN_SLAVE_FRAME_QUEUE));   // counter is cumulative
+    while (LIN.readFrame(frame));
+    CHECK_EQ(LIN.handlerDrain(), 0);
+  }
+
+  // MaxBytes limits handled bytes, rest is handled by next call
+  injectFrame(0x55);
+  CHECK_EQ(LIN.handlerDrain(3), 3);
+  CHECK_EQ(LIN.getState(), LIN_Slave_Base::STATE_RECEIVING_DATA);
+  CHECK_EQ(LIN.handlerDrain(), 4);
+  CHECK_EQ(LIN.getState(), LIN_Slave_Base::STATE_DONE);
+  CHECK_EQ(dataRequest[0], 0x55);
+
+  // truncated frame in backlog: handlerDrain() handles pending bytes, timeout is detected by next handler() without bytes
+  ArduinoHost::advanceMicros(2000);
+  Serial1.hostReceive(0x00, true);
+  Serial1.hostReceive(0x55);
+  Serial1.hostReceive(LIN_Slave_Protocol::getPID(0x10));
+  Serial1.hostReceive(0x01);
+  ArduinoHost::advanceMicros(100000);
+  CHECK_EQ(LIN.handlerDrain(), 3);
+  CHECK_EQ(LIN.getState(), LIN_Slave_Base::STATE_RECEIVING_DATA);
+  LIN.handler();
+  CHECK_EQ(LIN.getState(), LIN_Slave_Base::STATE_DONE);
+  CHECK_EQ(LIN.getError(), LIN_Slave_Base::ERROR_TIMEOUT);
+
+  return TEST_RESULT();
+}
@@ -0,0 +1,158 @@
+/**
+  \file     test_frame_table.cpp
+  \brief    Host test of compile-time frame table
+  \details  Checks checkFrameTable() and checkFrameIndex() at compile time incl. invalid tables, the index built by
+            makeFrameIndex(), and dispatch of frames via attachFrameTable() incl. precedence over registered callbacks
+  \author   Georg Icking-Konert
+*/
+
+// include files
+#include <string.h>
+#include <LIN_slave_HardwareSerial.h>
+#include "test_common.h"
+
+
+// number of callback calls and received request data
+static uint8_t  numRequest = 0;
+static uint8_t  numResponse = 0;
+static uint8_t  numRegistered = 0;
+static uint8_t  dataRequest[8];
+
+// master request callback: store data
+void masterRequest(uint8_t numData, uint8_t* data)
+{
+  numRequest++;
+  memcpy(dataRequest, data, numData);
+}
+
+// slave response callback: fixed data
+void slaveResponse(uint8_t numData, uint8_t* data)
+{
+  numResponse++;
+  for (uint8_t i=0; i<numData; i++)
+    data[i] = (uint8_t) (0xB0 + i);
+}
+
+// registered callback, overridden by frame table
+void registeredCallback(uint8_t numData, uint8_t* data)
+{
+  (void) numData;
+  (void) data;
+  numRegistered++;
+}
+
+
+// valid frame table, sorted by ID incl. min. and max. ID
+constexpr LIN_Slave_Base::frame_entry_t frames[] PROGMEM = {
+  LIN_Slave_Base::entryMasterRequest(0x00, masterRequest, 1),
+  LIN_Slave_Base::entryMasterRequest(0x10, masterRequest, 4),
+  LIN_Slave_Base::entrySlaveResponse(0x20, slaveResponse, 2),
+  LIN_Slave_Base::entrySlaveResponse(0x3F, slaveResponse, 8)
+};
+constexpr LIN_Slave_Base::frame_index_t framesIndex PROGMEM = LIN_Slave_Base::makeFrameIndex(frames);
+static_assert(LIN_Slave_Base::checkFrameTable(frames), "valid frame table rejected");
+static_assert(LIN_Slave_Base::checkFrameIndex(frames, framesIndex), "valid frame index rejected");
+static_assert((framesIndex.idx[0x00] == 0) && (framesIndex.idx[0x10] == 1) && (framesIndex.idx[0x20] == 2) && (framesIndex.idx[0x3F] == 3),
+  "wrong frame index");
+static_assert((framesIndex.idx[0x01] == 0xFF) && (framesIndex.idx[0x1F] == 0xFF) && (framesIndex.idx[0x3E] == 0xFF), "wrong frame index");
+
+// invalid: duplicate ID
+constexpr LIN_Slave_Base::frame_entry_t framesDuplicate[] = {
+  LIN_Slave_Base::entryMasterRequest(0x10, masterRequest, 4),
+  LIN_Slave_Base::entrySlaveResponse(0x10, slaveResponse, 4)
+};
+static_assert(!LIN_Slave_Base::checkFrameTable(framesDuplicate), "duplicate ID accepted");
+
+// invalid: IDs not ascending
+constexpr LIN_Slave_Base::frame_entry_t framesUnsorted[] = {
+  LIN_Slave_Base::entryMasterRequest(0x20, masterRequest, 4),
+  LIN_Slave_Base::entrySlaveResponse(0x10, slaveResponse, 4)
+};
+static_assert(!LIN_Slave_Base::checkFrameTable(framesUnsorted), "unsorted IDs accepted");
+
+// invalid: frame length 0 and 9
+constexpr LIN_Slave_Base::frame_entry_t framesLength0[] = { LIN_Slave_Base::entryMasterRequest(0x10, masterRequest, 0) };
+constexpr LIN_Slave_Base::frame_entry_t framesLength9[] = { LIN_Slave_Base::entrySlaveResponse(0x10, slaveResponse, 9) };
+static_assert(!LIN_Slave_Base::checkFrameTable(framesLength0), "frame length 0 accepted");
+static_assert(!LIN_Slave_Base::checkFrameTable(framesLength9), "frame length 9 accepted");
+
+// invalid: ID > 0x3F and missing callback
+constexpr LIN_Slave_Base::frame_entry_t framesID[] = { LIN_Slave_Base::entryMasterRequest(0x40, masterRequest, 4) };
+constexpr LIN_Slave_Base::frame_entry_t framesNull[] = { LIN_Slave_Base::entryMasterRequest(0x10, nullptr, 4) };
+static_assert(!LIN_Slave_Base::checkFrameTable(framesID), "ID > 0x3F accepted");
+static_assert(!LIN_Slave_Base::checkFrameTable(framesNull), "missing callback accepted");
+
+// invalid: index of other table
+constexpr LIN_Slave_Base::frame_index_t framesIndexOther = LIN_Slave_Base::makeFrameIndex(framesUnsorted);
+static_assert(!LIN_Slave_Base::checkFrameIndex(frames, framesIndexOther), "wrong frame index accepted");
+
+
+int main()
+{
+  LIN_Slave_HardwareSerial  LIN(Serial1, 1000, LIN_Slave_Base::LIN_V2, "Table");
+  const uint8_t             data[4] = { 0x01, 0x02, 0x03, 0x04 };
+  uint8_t                   buf[16];
+  uint16_t                  num;
+
+  ArduinoHost::useVirtualTime(true);
+  ArduinoHost::setMicros(100000);
+  LIN.begin(19200);
+
+  // callbacks registered at runtime for IDs in table and not in table
+  LIN.registerMasterRequestHandler(0x10, registeredCallback, 4);
+  LIN.registerMasterRequestHandler(0x11, registeredCallback, 4);
+  LIN.attachFrameTable(frames, framesIndex);
+
+  // master request via table, registered callback for same ID is overridden
+  testRequest(LIN, Serial1, 0x10, data, 4);
+  CHECK_EQ(LIN.getState(), LIN_Slave_Base::STATE_DONE);
+  CHECK_EQ(LIN.getError(), LIN_Slave_Base::NO_ERROR);
+  CHECK_EQ(numRequest, 1);
+  CHECK_EQ(numRegistered, 0);
+  CHECK(memcmp(dataRequest, data, 4) == 0);
+
+  // min. ID with 1 data byte
+  LIN.resetStateMachine();
+  testRequest(LIN, Serial1, 0x00, data, 1);
+  CHECK_EQ(LIN.getError(), LIN_Slave_Base::NO_ERROR);
+  CHECK_EQ(numRequest, 2);
+
+  // ID not in table falls back to registered callback
+  LIN.resetStateMachine();
+  testRequest(LIN, Serial1, 0x11, data, 4);
+  CHECK_EQ(LIN.getError(), LIN_Slave_Base::NO_ERROR);
+  CHECK_EQ(numRegistered, 1);
+  CHECK_EQ(numRequest, 2);
+
+  // slave responses via table with length from table, incl. max. ID
+  const uint8_t numData[2] = { 2, 8 };
+  const uint8_t ids[2] = { 0x20, 0x3F };
+  for (uint8_t k=0; k<2; k++)
+  {
+    uint8_t expect[8];
+    for (uint8_t i=0; i<numData[k]; i++)
+      expect[i] = (uint8_t) (0xB0 + i);
+    LIN.resetStateMachine();
+    testHeader(LIN, Serial1, ids[k]);
+    num = Serial1.hostTransmit(buf, sizeof(buf));
+    CHECK_EQ(num, numData[k] + 1);
+    CHECK(memcmp(buf, expect, numData[k]) == 0);
+    CHECK_EQ(buf[numData[k]], LIN_Slave_Protocol::checksum(LIN_Slave_Protocol::getSeed(ids[k], true), expect, numData[k]));
+    for (uint16_t i=0; i<num; i++)
+      testReceive(LIN, Serial1, buf[i]);
+    CHECK_EQ(LIN.getState(), LIN_Slave_Base::STATE_DONE);
+    CHECK_EQ(LIN.getError(), LIN_Slave_Base::NO_ERROR);
+    CHECK_EQ(numResponse, k + 1);
+  }
+
+  // unknown ID is ignored without response
+  LIN.resetStateMachine();
+  testHeader(LIN, Serial1, 0x21);
+  CHECK_EQ(Serial1.hostTransmit(buf, sizeof(buf)), 0);
+  CHECK_EQ(LIN.getError(), LIN_Slave_Base::NO_ERROR);
+  CHECK_EQ(numResponse, 2);
+
+  LIN.end();
+
+  return TEST_RESULT();
+}
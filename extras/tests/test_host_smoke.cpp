@@ -0,0 +1,66 @@
+/**
+  \file     test_host_smoke.cpp
+  \brief    Host smoke test of the LIN slave library
+  \details  Receive a master request and answer a slave response via LIN_Slave_HardwareSerial on the host shim
+  \author   Georg Icking-Konert
+*/
+
+// include files
+#include <LIN_slave_HardwareSerial.h>
+#include "test_common.h"
+
+// received master request
+static uint8_t  numRequest = 0;
+static uint8_t  dataRequest[8];
+
+// master request callback: store data
+void masterRequest(uint8_t numData, uint8_t* data)
+{
+  numRequest = numData;
+  memcpy(dataRequest, data, numData);
+}
+
+// slave response callback: fixed data
+void slaveResponse(uint8_t numData, uint8_t* data)
+{
+  for (uint8_t i=0; i<numData; i++)
+    data[i] = 0xA0 + i;
+}
+
+
+int main()
+{
+  LIN_Slave_HardwareSerial  LIN(Serial1, 1000, LIN_Slave_Base::LIN_V2, "Smoke");
+  const uint8_t             data[4] = { 0x11, 0x22, 0xFF, 0x00 };
+  uint8_t                   bufTx[16];
+
+  // virtual clock for deterministic timing
+  ArduinoHost::useVirtualTime(true);
+  ArduinoHost::setMicros(100000);
+
+  // open node and register frames
+  LIN.begin(19200);
+  CHECK_EQ(Serial1.hostBaudrate(), 19200);
+  CHECK(LIN.registerMasterRequestHandler(0x10, masterRequest, 4));
+  CHECK(LIN.registerSlaveResponseHandler(0x20, slaveResponse, 2));
+  CHECK(!LIN.registerMasterRequestHandler(0x11, nullptr, 4));
+
+  // master request is passed to callback
+  testRequest(LIN, Serial1, 0x10, data, 4);
+  CHECK_EQ(numRequest, 4);
+  CHECK(memcmp(dataRequest, data, 4) == 0);
+  CHECK_EQ(LIN.getError(), LIN_Slave_Base::NO_ERROR);
+
+  // slave response is sent after PID incl. enhanced checksum
+  testHeader(LIN, Serial1, 0x20);
+  CHECK_EQ(Serial1.hostTransmit(bufTx, sizeof(bufTx)), 3);
+  CHECK_EQ(bufTx[0], 0xA0);
+  CHECK_EQ(bufTx[1], 0xA1);
+  CHECK_EQ(bufTx[2], LIN_Slave_Protocol::checksum(LIN_Slave_Protocol::getSeed(0x20, true), bufTx, 2));
+
+  // close node
+  LIN.end();
+  CHECK_EQ(Serial1.hostBaudrate(), 0);
+
+  return TEST_RESULT();
+}
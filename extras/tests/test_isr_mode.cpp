@@ -0,0 +1,130 @@
+/**
+  \file     test_isr_mode.cpp
+  \brief    Host test of LIN state machine in receive ISR (LIN_SLAVE_HANDLER_IN_ISR)
+  \details  Test backend handles all bytes via _handleReceiveISR() like LIN_Slave_NeoHWSerial_AVR in ISR mode.
+            Checks that handler() doesn't touch frame state, queue or log, that a truncated frame is aborted in ISR, and that
+            slave responses (via callback and pre-published) are sent from ISR with correct data and checksum
+  \author   Georg Icking-Konert
+*/
+
+// include files
+#include "test_common.h"
+
+
+/// Test backend with LIN state machine in receive ISR
+typedef LIN_Slave_Test<true>    LIN_Slave_ISR;
+
+
+// master request callback
+void masterRequest(uint8_t numData, uint8_t* data)
+{
+  (void) numData;
+  (void) data;
+}
+
+// slave response callback
+void slaveResponse(uint8_t numData, uint8_t* data)
+{
+  for (uint8_t i=0; i<numData; i++)
+    data[i] = (uint8_t) (0xC0 + i);
+}
+
+
+int main()
+{
+  LIN_Slave_ISR                   LIN;
+  LIN_Slave_Base::frame_record_t  frame;
+  LIN_Slave_Base::log_entry_t     entry;
+
+  // virtual clock for deterministic timing
+  ArduinoHost::useVirtualTime(true);
+  ArduinoHost::setMicros(100000);
+  LIN.begin(19200);
+  LIN.registerMasterRequestHandler(0x10, masterRequest, 4);
+  LIN.registerSlaveResponseHandler(0x20, slaveResponse, 3);
+
+  // truncated master request: header + 2 of 4 data bytes
+  LIN.receive(0x00, true);
+  LIN.receive(0x55);
+  LIN.receive(LIN_Slave_Protocol::getPID(0x10));
+  LIN.receive(0x01);
+  LIN.receive(0x02);
+  CHECK_EQ(LIN.getState(), LIN_Slave_Base::STATE_RECEIVING_DATA);
+
+  // drain log of frame start
+  while (LIN.readLog(entry));
+
+  // handler() long after timeout: no access to frame state, queue or log from loop context
+  ArduinoHost::advanceMicros(100000);
+  LIN.handler();
+  CHECK_EQ(LIN.getState(), LIN_Slave_Base::STATE_RECEIVING_DATA);
+  CHECK(!LIN.readFrame(frame));
+  CHECK(!LIN.readLog(entry));
+
+  // next BREAK in ISR aborts truncated frame first, then starts new frame
+  LIN.receive(0x00, true);
+  CHECK_EQ(LIN.getState(), LIN_Slave_Base::STATE_WAIT_FOR_SYNC);
+  CHECK(LIN.getError() & LIN_Slave_Base::ERROR_TIMEOUT);
+  CHECK(LIN.readFrame(frame));
+  CHECK_EQ(frame.id, 0x10);
+  CHECK(frame.error & LIN_Slave_Base::ERROR_TIMEOUT);
+  CHECK(LIN.readLog(entry));
+  CHECK_EQ(entry.event, LIN_Slave_Base::LOG_TIMEOUT);
+  CHECK(LIN.readLog(entry));
+  CHECK_EQ(entry.event, LIN_Slave_Base::LOG_BREAK);
+
+  // complete frame in ISR without handler()
+  LIN.resetError();
+  LIN.receive(0x55);
+  LIN.receive(LIN_Slave_Protocol::getPID(0x10));
+  const uint8_t data[4] = { 1, 2, 3, 4 };
+  for (uint8_t i=0; i<4; i++)
+    LIN.receive(data[i]);
+  LIN.receive(LIN_Slave_Protocol::checksum(LIN_Slave_Protocol::getSeed(0x10, true), data, 4));
+  CHECK_EQ(LIN.getState(), LIN_Slave_Base::STATE_DONE);
+  CHECK_EQ(LIN.getError(), LIN_Slave_Base::NO_ERROR);
+  CHECK(LIN.readFrame(frame));
+  CHECK_EQ(frame.error, LIN_Slave_Base::NO_ERROR);
+  CHECK_EQ(frame.data[3], 4);
+
+  // slave response via callback: sent in ISR on PID reception, data + enhanced checksum
+  const uint8_t response[3] = { 0xC0, 0xC1, 0xC2 };
+  LIN.resetError();
+  LIN.numTx = 0;
+  LIN.receive(0x00, true);
+  LIN.receive(0x55);
+  LIN.receive(LIN_Slave_Protocol::getPID(0x20));
+  CHECK_EQ(LIN.getState(), LIN_Slave_Base::STATE_RECEIVING_ECHO);
+  CHECK_EQ(LIN.numTx, 4);
+  for (uint8_t i=0; i<3; i++)
+    CHECK_EQ(LIN.bufTx[i], response[i]);
+  CHECK_EQ(LIN.bufTx[3], LIN_Slave_Protocol::checksum(LIN_Slave_Protocol::getSeed(0x20, true), response, 3));
+
+  // echo finishes frame in ISR
+  for (uint8_t i=0; i<LIN.numTx; i++)
+    LIN.receive(LIN.bufTx[i]);
+  CHECK_EQ(LIN.getState(), LIN_Slave_Base::STATE_DONE);
+  CHECK_EQ(LIN.getError(), LIN_Slave_Base::NO_ERROR);
+  CHECK(LIN.readFrame(frame));
+  CHECK_EQ(frame.id, 0x20);
+  CHECK_EQ(frame.numData, 3);
+  CHECK_EQ(frame.data[2], 0xC2);
+
+  // pre-published slave response: sent in ISR without callback, checksum precomputed
+  const uint8_t published[8] = { 8, 7, 6, 5, 4, 3, 2, 1 };
+  CHECK(LIN.publishResponse(0x21, published, 8));
+  LIN.numTx = 0;
+  LIN.receive(0x00, true);
+  LIN.receive(0x55);
+  LIN.receive(LIN_Slave_Protocol::getPID(0x21));
+  CHECK_EQ(LIN.numTx, 9);
+  for (uint8_t i=0; i<8; i++)
+    CHECK_EQ(LIN.bufTx[i], published[i]);
+  CHECK_EQ(LIN.bufTx[8], LIN_Slave_Protocol::checksum(LIN_Slave_Protocol::getSeed(0x21, true), published, 8));
+  for (uint8_t i=0; i<LIN.numTx; i++)
+    LIN.receive(LIN.bufTx[i]);
+  CHECK_EQ(LIN.getState(), LIN_Slave_Base::STATE_DONE);
+  CHECK_EQ(LIN.getError(), LIN_Slave_Base::NO_ERROR);
+
+  return TEST_RESULT();
+}
@@ -0,0 +1,176 @@
+/**
+  \file     test_log.cpp
+  \brief    Host test of deferred binary event log (LIN_SLAVE_LOG_SIZE)
+  \details  Frames are received on a virtual clock. Checks the logged events, the 8-byte records written by drainLog()
+            incl. MaxEntries, and the LOG_LOST record after overflow. If a file name is passed, the drained records are
+            also written to it, mixed with text like other serial output. The file is decoded by extras/logging/decode_log.py
+            in ctest test decode_log, see CMakeLists.txt
+  \author   Georg Icking-Konert
+*/
+
+// include files
+#include <stdio.h>
+#include <LIN_slave_Sim.h>
+#include "test_common.h"
+
+
+// master request callback
+void masterRequest(uint8_t numData, uint8_t* data)
+{
+  (void) numData;
+  (void) data;
+}
+
+// slave response callback
+void slaveResponse(uint8_t numData, uint8_t* data)
+{
+  for (uint8_t i=0; i<numData; i++)
+    data[i] = (uint8_t) (0xA0 + i);
+}
+
+// output stream capturing written bytes, e.g. instead of Serial
+class LogSink : public Print
+{
+  public:
+    uint8_t   buf[256];
+    uint16_t  num = 0;
+    size_t write(uint8_t c) { if (num < sizeof(buf)) buf[num++] = c; return 1; }
+};
+
+// receive byte one byte time (plus pause) after previous byte and call handler()
+static void receive(LIN_Slave_Sim &Slave, uint8_t Byte, bool FlagBreak = false, uint32_t Pause = 0)
+{
+  ArduinoHost::advanceMicros(Pause + TEST_TIME_BYTE);
+  Serial1.hostReceive(Byte, FlagBreak);
+  Slave.handler();
+}
+
+// receive BREAK, SYNC and PID. Returns time of BREAK
+static uint32_t header(LIN_Slave_Sim &Slave, uint8_t ID)
+{
+  receive(Slave, 0x00, true, 5000);
+  uint32_t timeBreak = micros();
+  receive(Slave, 0x55);
+  receive(Slave, LIN_Slave_Protocol::getPID(ID));
+  return timeBreak;
+}
+
+// check record Idx in sink: marker, event, ID, data and time (little endian)
+static bool checkRecord(const LogSink &Sink, uint8_t Idx, LIN_Slave_Base::log_event_t Event, uint8_t ID, uint8_t Data, uint32_t Time)
+{
+  const uint8_t *p = Sink.buf + 8*Idx;
+  uint32_t      time = (uint32_t) p[4] | ((uint32_t) p[5] << 8) | ((uint32_t) p[6] << 16) | ((uint32_t) p[7] << 24);
+
+  if ((p[0] != LIN_SLAVE_LOG_MARKER) || (p[1] != Event) || (p[2] != ID) || (p[3] != Data) || (time != Time))
+  {
+    printf("record %u: 0x%02X 0x%02X 0x%02X 0x%02X %u\n", Idx, p[0], p[1], p[2], p[3], time);
+    return false;
+  }
+  return true;
+}
+
+
+int main(int argc, char *argv[])
+{
+  LIN_Slave_Sim   LIN(Serial1, LIN_Slave_Base::LIN_V2, "Log");
+  LogSink         sink[4];
+  uint8_t         buf[16];
+  uint16_t        num;
+  uint32_t        timeBreak[4];
+  const uint8_t   data[4] = { 1, 2, 3, 4 };
+  const uint8_t   chk = LIN_Slave_Protocol::checksum(LIN_Slave_Protocol::getSeed(0x10, true), data, 4);
+
+  ArduinoHost::useVirtualTime(true);
+  ArduinoHost::setMicros(100000);
+  LIN.begin(19200);
+  LIN.registerMasterRequestHandler(0x10, masterRequest, 4);
+  LIN.registerSlaveResponseHandler(0x20, slaveResponse, 2);
+
+  // empty log writes nothing
+  CHECK_EQ(LIN.drainLog(sink[0]), 0);
+  CHECK_EQ(sink[0].num, 0);
+
+  // master request, slave response, checksum error, ID of other slave -> 11 events
+  timeBreak[0] = header(LIN, 0x10);
+  for (uint8_t i=0; i<4; i++)
+    receive(LIN, data[i]);
+  receive(LIN, chk);
+  timeBreak[1] = header(LIN, 0x20);
+  num = Serial1.hostTransmit(buf, sizeof(buf));
+  for (uint8_t i=0; i<num; i++)
+    receive(LIN, buf[i]);
+  timeBreak[2] = header(LIN, 0x10);
+  for (uint8_t i=0; i<4; i++)
+    receive(LIN, data[i]);
+  receive(LIN, (uint8_t) ~chk);
+  timeBreak[3] = header(LIN, 0x30);
+
+  // drain in 2 steps via MaxEntries
+  CHECK_EQ(LIN.drainLog(sink[0], 4), 4);
+  CHECK_EQ(LIN.drainLog(sink[1]), 7);
+  CHECK_EQ(LIN.drainLog(sink[1]), 0);
+  CHECK_EQ(sink[0].num, 4*8);
+  CHECK_EQ(sink[1].num, 7*8);
+
+  // records of master request. BREAK has ID of previous frame, event times are receive times
+  CHECK(checkRecord(sink[0], 0, LIN_Slave_Base::LOG_BREAK, 0x00, 0x00, timeBreak[0]));
+  CHECK(checkRecord(sink[0], 1, LIN_Slave_Base::LOG_REQUEST, 0x10, 4, timeBreak[0] + 2*TEST_TIME_BYTE));
+  CHECK(checkRecord(sink[0], 2, LIN_Slave_Base::LOG_FRAME_OK, 0x10, 4, timeBreak[0] + 7*TEST_TIME_BYTE));
+
+  // records of slave response
+  CHECK(checkRecord(sink[0], 3, LIN_Slave_Base::LOG_BREAK, 0x10, 0x00, timeBreak[1]));
+  CHECK(checkRecord(sink[1], 0, LIN_Slave_Base::LOG_RESPONSE, 0x20, 2, timeBreak[1] + 2*TEST_TIME_BYTE));
+  CHECK(checkRecord(sink[1], 1, LIN_Slave_Base::LOG_FRAME_OK, 0x20, 2, timeBreak[1] + 5*TEST_TIME_BYTE));
+
+  // records of checksum error and other slave
+  CHECK(checkRecord(sink[1], 2, LIN_Slave_Base::LOG_BREAK, 0x20, 0x00, timeBreak[2]));
+  CHECK(checkRecord(sink[1], 3, LIN_Slave_Base::LOG_REQUEST, 0x10, 4, timeBreak[2] + 2*TEST_TIME_BYTE));
+  CHECK(checkRecord(sink[1], 4, LIN_Slave_Base::LOG_CHK_ERROR, 0x10, (uint8_t) ~chk, timeBreak[2] + 7*TEST_TIME_BYTE));
+  CHECK(checkRecord(sink[1], 5, LIN_Slave_Base::LOG_BREAK, 0x10, 0x00, timeBreak[3]));
+  CHECK(checkRecord(sink[1], 6, LIN_Slave_Base::LOG_IGNORE, 0x30, LIN_Slave_Protocol::getPID(0x30), timeBreak[3] + 2*TEST_TIME_BYTE));
+
+  // overflow: 10 headers of other slave -> 20 events, events of last 2 headers are lost
+  for (uint8_t i=0; i<10; i++)
+  {
+    uint32_t time = header(LIN, 0x30);
+    if (i == LIN_SLAVE_LOG_SIZE/2-1)
+      timeBreak[0] = time;
+  }
+  CHECK_EQ(LIN.drainLog(sink[2], LIN_SLAVE_LOG_SIZE), LIN_SLAVE_LOG_SIZE);
+  CHECK(checkRecord(sink[2], LIN_SLAVE_LOG_SIZE-1, LIN_Slave_Base::LOG_IGNORE, 0x30, LIN_Slave_Protocol::getPID(0x30),
+    timeBreak[0] + 2*TEST_TIME_BYTE));
+
+  // LOST record is written after logged entries, with time of drain
+  CHECK_EQ(LIN.drainLog(sink[3]), 1);
+  CHECK(checkRecord(sink[3], 0, LIN_Slave_Base::LOG_LOST, 0x00, 20 - LIN_SLAVE_LOG_SIZE, micros()));
+  CHECK_EQ(LIN.drainLog(sink[3]), 0);
+
+  // log continues after overflow
+  header(LIN, 0x30);
+  LIN_Slave_Base::log_entry_t entry;
+  CHECK(LIN.readLog(entry));
+  CHECK_EQ(entry.event, LIN_Slave_Base::LOG_BREAK);
+  CHECK(LIN.readLog(entry));
+  CHECK_EQ(entry.event, LIN_Slave_Base::LOG_IGNORE);
+  CHECK(!LIN.readLog(entry));
+
+  // optionally write records to file for decoder test, with text output in between
+  if (argc > 1)
+  {
+    FILE *pFile = fopen(argv[1], "wb");
+    CHECK(pFile != nullptr);
+    if (pFile != nullptr)
+    {
+      for (uint8_t i=0; i<4; i++)
+      {
+        fwrite(sink[i].buf, 1, sink[i].num, pFile);
+        fprintf(pFile, "debug output %u\n", i);
+      }
+      fclose(pFile);
+    }
+  }
+
+  LIN.end();
+
+  return TEST_RESULT();
+}
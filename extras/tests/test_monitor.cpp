@@ -0,0 +1,191 @@
+/**
+  \file     test_monitor.cpp
+  \brief    Host test of passive monitor mode
+  \details  Frames of unknown length are captured via setMonitorMode() on a virtual clock. Checks length inference via the
+            checksum masks at frame end (next BREAK, timeout or 8 data bytes), the LIN1.x ID-encoded length, classic vs. enhanced
+            checksum incl. diagnostic frames where both are equal, errors of headers without response and of invalid checksums,
+            the report of dropped frames if the frame queue is full, and that no response is sent
+  \author   Georg Icking-Konert
+*/
+
+// include files
+#include <LIN_slave_Sim.h>
+#include "test_common.h"
+
+
+// frame timeout [us] for polling, longer than any frame at 19200 Baud
+#define TIME_TIMEOUT    20000
+
+
+// frames passed to monitor callback
+static LIN_Slave_Base::frame_record_t   frames[16];
+static uint8_t                          numFrames = 0;
+
+// monitor callback: store frame
+void monitorFrame(const LIN_Slave_Base::frame_record_t &Frame)
+{
+  if (numFrames < 16)
+    frames[numFrames] = Frame;
+  numFrames++;
+}
+
+// slave response callback
+void slaveResponse(uint8_t numData, uint8_t* data)
+{
+  for (uint8_t i=0; i<numData; i++)
+    data[i] = (uint8_t) (0xA0 + i);
+}
+
+// receive byte one byte time (plus pause) after previous byte and call handler()
+static void receive(LIN_Slave_Sim &Slave, uint8_t Byte, bool FlagBreak = false, uint32_t Pause = 0)
+{
+  ArduinoHost::advanceMicros(Pause + TEST_TIME_BYTE);
+  Serial1.hostReceive(Byte, FlagBreak);
+  Slave.handler();
+}
+
+// receive frame with classic or enhanced checksum and optional extra bytes after checksum. Frame end is detected later
+static void frame(LIN_Slave_Sim &Slave, uint8_t ID, const uint8_t Data[], uint8_t NumData, bool FlagEnhanced, uint8_t NumExtra = 0)
+{
+  receive(Slave, 0x00, true, 5000);
+  receive(Slave, 0x55);
+  receive(Slave, LIN_Slave_Protocol::getPID(ID));
+  for (uint8_t i=0; i<NumData; i++)
+    receive(Slave, Data[i]);
+  if (NumData > 0)
+    receive(Slave, LIN_Slave_Protocol::checksum(FlagEnhanced ? LIN_Slave_Protocol::getSeed(ID, true) : 0x00, Data, NumData));
+  for (uint8_t i=0; i<NumExtra; i++)
+    receive(Slave, 0xFF);
+}
+
+// poll handler() until frame end by timeout
+static void waitTimeout(LIN_Slave_Sim &Slave)
+{
+  for (uint16_t t=0; t<TIME_TIMEOUT; t+=100)
+  {
+    ArduinoHost::advanceMicros(100);
+    Slave.handler();
+  }
+}
+
+// check last captured frame
+static bool checkFrame(uint8_t ID, LIN_Slave_Base::frame_t Type, const uint8_t Data[], uint8_t NumData, uint8_t Error)
+{
+  const LIN_Slave_Base::frame_record_t  *pFrame = &(frames[numFrames-1]);
+
+  if ((pFrame->id != ID) || (pFrame->type != Type) || (pFrame->numData != NumData) || (pFrame->error != Error) ||
+    ((Data != nullptr) && (memcmp(pFrame->data, Data, NumData) != 0)))
+  {
+    printf("frame %u: ID 0x%02X, type 0x%02X, length %u, error 0x%02X\n", numFrames-1, pFrame->id, pFrame->type, pFrame->numData, pFrame->error);
+    return false;
+  }
+  return true;
+}
+
+
+int main()
+{
+  LIN_Slave_Sim                   LIN(Serial1, LIN_Slave_Base::LIN_V2, "Monitor");
+  LIN_Slave_Base::frame_record_t  record;
+  const uint8_t                   data[8] = { 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88 };
+  uint8_t                         buf[16];
+
+  ArduinoHost::useVirtualTime(true);
+  ArduinoHost::setMicros(100000);
+  LIN.begin(19200);
+  LIN.registerSlaveResponseHandler(0x20, slaveResponse, 2);
+  LIN.setMonitorMode(true, monitorFrame);
+
+  // enhanced checksum, 3 bytes: length from checksum mask on next BREAK
+  frame(LIN, 0x10, data, 3, true);
+  CHECK_EQ(numFrames, 0);
+  frame(LIN, 0x11, data, 5, false);
+  CHECK_EQ(numFrames, 1);
+  CHECK(checkFrame(0x10, LIN_Slave_Base::MONITOR_ENHANCED, data, 3, LIN_Slave_Base::NO_ERROR));
+
+  // classic checksum, 5 bytes: frame end on timeout
+  waitTimeout(LIN);
+  CHECK_EQ(numFrames, 2);
+  CHECK(checkFrame(0x11, LIN_Slave_Base::MONITOR_CLASSIC, data, 5, LIN_Slave_Base::NO_ERROR));
+
+  // 8 data bytes: evaluated on checksum reception without waiting for frame end
+  frame(LIN, 0x12, data, 8, true);
+  CHECK_EQ(numFrames, 3);
+  CHECK(checkFrame(0x12, LIN_Slave_Base::MONITOR_ENHANCED, data, 8, LIN_Slave_Base::NO_ERROR));
+  CHECK_EQ(LIN.getState(), LIN_Slave_Base::STATE_DONE);
+
+  // extra byte after checksum: all received bytes don't match -> LIN1.x ID-encoded length, i.e. 4 bytes for ID 0x20..0x2F
+  frame(LIN, 0x25, data, 4, false, 1);
+  waitTimeout(LIN);
+  CHECK_EQ(numFrames, 4);
+  CHECK(checkFrame(0x25, LIN_Slave_Base::MONITOR_CLASSIC, data, 4, LIN_Slave_Base::NO_ERROR));
+
+  // same for 2 bytes (ID 0x00..0x1F) and 8 bytes (ID 0x30..0x3F)
+  frame(LIN, 0x05, data, 2, true, 2);
+  waitTimeout(LIN);
+  CHECK(checkFrame(0x05, LIN_Slave_Base::MONITOR_ENHANCED, data, 2, LIN_Slave_Base::NO_ERROR));
+  frame(LIN, 0x35, data, 8, false);
+  CHECK(checkFrame(0x35, LIN_Slave_Base::MONITOR_CLASSIC, data, 8, LIN_Slave_Base::NO_ERROR));
+  CHECK_EQ(numFrames, 6);
+
+  // diagnostic frame: classic and enhanced checksum are equal -> reported as classic
+  frame(LIN, 0x3C, data, 8, true);
+  CHECK_EQ(numFrames, 7);
+  CHECK(checkFrame(0x3C, LIN_Slave_Base::MONITOR_CLASSIC, data, 8, LIN_Slave_Base::NO_ERROR));
+
+  // checksum collision: 2nd byte matches classic checksum of 1st byte, i.e. frame may end after 1 byte.
+  // Full length with enhanced checksum takes precedence over shorter classic candidate
+  const uint8_t collision[4] = { 0x12, (uint8_t) ~0x12, 0x01, 0x02 };
+  frame(LIN, 0x10, collision, 4, true);
+  waitTimeout(LIN);
+  CHECK_EQ(numFrames, 8);
+  CHECK(checkFrame(0x10, LIN_Slave_Base::MONITOR_ENHANCED, collision, 4, LIN_Slave_Base::NO_ERROR));
+
+  // same first 2 bytes without further bytes: the classic candidate after 1 byte is the frame
+  frame(LIN, 0x10, collision, 1, false);
+  waitTimeout(LIN);
+  CHECK_EQ(numFrames, 9);
+  CHECK(checkFrame(0x10, LIN_Slave_Base::MONITOR_CLASSIC, collision, 1, LIN_Slave_Base::NO_ERROR));
+
+  // header without response -> timeout error, no data
+  frame(LIN, 0x20, data, 0, true);
+  waitTimeout(LIN);
+  CHECK_EQ(numFrames, 10);
+  CHECK(checkFrame(0x20, LIN_Slave_Base::MONITOR_ENHANCED, nullptr, 0, LIN_Slave_Base::ERROR_TIMEOUT));
+
+  // registered slave response is not sent in monitor mode
+  CHECK_EQ(Serial1.hostTransmit(buf, sizeof(buf)), 0);
+
+  // invalid checksum -> checksum error, length is number of received bytes - 1
+  frame(LIN, 0x10, data, 3, true, 1);
+  waitTimeout(LIN);
+  CHECK_EQ(numFrames, 11);
+  CHECK(checkFrame(0x10, LIN_Slave_Base::MONITOR_ENHANCED, nullptr, 4, LIN_Slave_Base::ERROR_CHK));
+  CHECK(memcmp(frames[10].data, data, 3) == 0);
+  LIN.resetError();
+
+  // queue keeps first frames, dropped frames are reported via getQueueOverflow(). Callback gets all frames
+  CHECK_EQ(LIN.getQueueOverflow(), 11 - LIN_SLAVE_FRAME_QUEUE);
+  for (uint8_t i=0; i<LIN_SLAVE_FRAME_QUEUE; i++)
+  {
+    CHECK(LIN.readFrame(record));
+    CHECK_EQ(record.id, frames[i].id);
+    CHECK_EQ(record.numData, frames[i].numData);
+    CHECK_EQ(record.type, frames[i].type);
+  }
+  CHECK(!LIN.readFrame(record));
+  frame(LIN, 0x12, data, 8, true);
+  CHECK(LIN.readFrame(record));
+  CHECK(checkFrame(0x12, LIN_Slave_Base::MONITOR_ENHANCED, data, 8, LIN_Slave_Base::NO_ERROR));
+  CHECK_EQ(LIN.getQueueOverflow(), 11 - LIN_SLAVE_FRAME_QUEUE);
+
+  // normal operation: slave response is sent again, no more frames to monitor callback
+  LIN.setMonitorMode(false);
+  frame(LIN, 0x20, data, 0, true);
+  CHECK_EQ(Serial1.hostTransmit(buf, sizeof(buf)), 3);
+  CHECK_EQ(numFrames, 12);
+
+  LIN.end();
+
+  return TEST_RESULT();
+}
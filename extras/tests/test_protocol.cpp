@@ -0,0 +1,113 @@
+/**
+  \file     test_protocol.cpp
+  \brief    Host test of LIN protocol tables and checksum
+  \details  Checks PID and checksum seed tables and the checksum of LIN_slave_Protocol.h against a bitwise reference
+            implementation of the LIN spec, for all IDs, all 256 PID values and random frames. Also checks the
+            incremental checksum of the state machine via received frames
+  \author   Georg Icking-Konert
+*/
+
+// include files
+#include <LIN_slave_HardwareSerial.h>
+#include "test_common.h"
+
+
+// reference PID: parity bits from individual ID bits, see LIN spec "2.3.1.3 Protected identifier field"
+static uint8_t refPID(uint8_t ID)
+{
+  uint8_t bit[6];
+  for (uint8_t i=0; i<6; i++)
+    bit[i] = (ID >> i) & 0x01;
+  uint8_t p0 = bit[0] ^ bit[1] ^ bit[2] ^ bit[4];
+  uint8_t p1 = (bit[1] ^ bit[3] ^ bit[4] ^ bit[5]) ^ 0x01;
+  return (uint8_t) ((ID & 0x3F) | (p0 << 6) | (p1 << 7));
+}
+
+// reference checksum: 16-bit sum folded at the end, see LIN spec "2.3.1.5 Checksum"
+static uint8_t refChecksum(uint8_t ID, bool Enhanced, const uint8_t Data[], uint8_t NumData)
+{
+  uint16_t sum = 0;
+  if ((Enhanced) && (ID != 0x3C) && (ID != 0x3D))
+    sum = refPID(ID);
+  for (uint8_t i=0; i<NumData; i++)
+    sum += Data[i];
+  while (sum > 0xFF)
+    sum = (sum & 0xFF) + (sum >> 8);
+  return (uint8_t) ~sum;
+}
+
+// received master request
+static uint8_t  numRequest = 0;
+
+// master request callback: count
+void masterRequest(uint8_t numData, uint8_t* data)
+{
+  (void) data;
+  numRequest = numData;
+}
+
+
+int main()
+{
+  uint8_t   data[8];
+  uint16_t  numValid = 0;
+
+  // PID and seed tables for all IDs
+  for (uint8_t id=0; id<64; id++)
+  {
+    CHECK_EQ(LIN_Slave_Protocol::getPID(id), refPID(id));
+    CHECK_EQ(LIN_Slave_Protocol::getPID(id | 0xC0), refPID(id));
+    CHECK_EQ(LIN_Slave_Protocol::getSeed(id, false), 0x00);
+    CHECK_EQ(LIN_Slave_Protocol::getSeed(id, true), ((id == 0x3C) || (id == 0x3D)) ? 0x00 : refPID(id));
+  }
+
+  // exactly one valid PID per ID
+  for (uint16_t pid=0; pid<256; pid++)
+  {
+    bool valid = LIN_Slave_Protocol::isValidPID((uint8_t) pid);
+    CHECK_EQ(valid, refPID(pid & 0x3F) == pid);
+    numValid += valid ? 1 : 0;
+  }
+  CHECK_EQ(numValid, 64);
+
+  // checksum of random frames, incl. carry chains (all 0xFF) and empty frame
+  srand(1);
+  for (uint16_t k=0; k<10000; k++)
+  {
+    uint8_t id  = (uint8_t) (rand() & 0x3F);
+    uint8_t num = (uint8_t) (rand() % 9);
+    for (uint8_t i=0; i<num; i++)
+      data[i] = (k < 100) ? 0xFF : (uint8_t) rand();
+    for (uint8_t enhanced=0; enhanced<2; enhanced++)
+      CHECK_EQ(LIN_Slave_Protocol::checksum(LIN_Slave_Protocol::getSeed(id, enhanced), data, num), refChecksum(id, enhanced, data, num));
+  }
+
+  // incremental checksum of state machine: frame with reference checksum is accepted, with wrong checksum rejected
+  {
+    LIN_Slave_HardwareSerial  LIN(Serial1, 1000, LIN_Slave_Base::LIN_V2, "Protocol");
+    ArduinoHost::useVirtualTime(true);
+    ArduinoHost::setMicros(100000);
+    LIN.begin(19200);
+    for (uint8_t id=0; id<64; id++)
+      LIN.registerMasterRequestHandler(id, masterRequest, 8);
+    for (uint8_t id=0; id<64; id++)
+    {
+      for (uint8_t i=0; i<8; i++)
+        data[i] = (uint8_t) rand();
+      for (uint8_t wrong=0; wrong<2; wrong++)
+      {
+        numRequest = 0;
+        LIN.resetStateMachine();
+        LIN.resetError();
+        testHeader(LIN, Serial1, id);
+        for (uint8_t i=0; i<8; i++)
+          testReceive(LIN, Serial1, data[i]);
+        testReceive(LIN, Serial1, refChecksum(id, true, data, 8) ^ wrong);
+        CHECK_EQ(numRequest, wrong ? 0 : 8);
+        CHECK_EQ(LIN.getError(), wrong ? LIN_Slave_Base::ERROR_CHK : LIN_Slave_Base::NO_ERROR);
+      }
+    }
+  }
+
+  return TEST_RESULT();
+}
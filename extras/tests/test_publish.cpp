@@ -0,0 +1,121 @@
+/**
+  \file     test_publish.cpp
+  \brief    Host test of pre-published slave responses
+  \details  Checks that published responses are sent incl. checksum without callback, that a publish transaction
+            becomes visible only on commitPublish(), and the limits of publishResponse()
+  \author   Georg Icking-Konert
+*/
+
+// include files
+#include <LIN_slave_HardwareSerial.h>
+#include "test_common.h"
+
+
+// slave response callback: count calls, fixed data
+static uint8_t  numCallback = 0;
+void slaveResponse(uint8_t numData, uint8_t* data)
+{
+  numCallback++;
+  for (uint8_t i=0; i<numData; i++)
+    data[i] = 0xC0 + i;
+}
+
+/**
+  \brief      Receive header and echo of slave response
+  \details    Receive header for ID, fetch sent response and receive it as echo
+  \param[in]  LIN       LIN slave node
+  \param[in]  ID        frame ID (unprotected)
+  \param[out] Buf       sent bytes incl. checksum
+  \return     number of sent bytes incl. checksum
+*/
+static uint16_t requestResponse(LIN_Slave_HardwareSerial &LIN, uint8_t ID, uint8_t Buf[])
+{
+  uint16_t  num;
+
+  LIN.resetStateMachine();
+  testHeader(LIN, Serial1, ID);
+  num = Serial1.hostTransmit(Buf, 16);
+  for (uint16_t i=0; i<num; i++)
+    testReceive(LIN, Serial1, Buf[i]);
+  return num;
+}
+
+// check sent slave response against expected data incl. enhanced checksum
+static bool checkResponse(uint8_t ID, const uint8_t Buf[], uint16_t Num, const uint8_t Data[], uint8_t NumData)
+{
+  return (Num == (uint16_t) (NumData+1)) && (memcmp(Buf, Data, NumData) == 0) &&
+    (Buf[NumData] == LIN_Slave_Protocol::checksum(LIN_Slave_Protocol::getSeed(ID, true), Data, NumData));
+}
+
+
+int main()
+{
+  LIN_Slave_HardwareSerial  LIN(Serial1, 1000, LIN_Slave_Base::LIN_V2, "Publish");
+  const uint8_t             dataA[4] = { 0x01, 0x02, 0x03, 0x04 };
+  const uint8_t             dataB[4] = { 0x11, 0x12, 0x13, 0x14 };
+  const uint8_t             dataDiag[8] = { 0x7F, 0x06, 0xB2, 0x00, 0xFF, 0xFF, 0xFF, 0xFF };
+  uint8_t                   buf[16];
+  uint16_t                  num;
+  uint8_t                   gen;
+
+  // virtual clock for deterministic timing
+  ArduinoHost::useVirtualTime(true);
+  ArduinoHost::setMicros(100000);
+  LIN.begin(19200);
+  LIN.registerSlaveResponseHandler(0x21, slaveResponse, 2);
+
+  // published response is sent without callback and with checksum, echo is checked
+  CHECK(LIN.publishResponse(0x20, dataA, 4));
+  num = requestResponse(LIN, 0x20, buf);
+  CHECK(checkResponse(0x20, buf, num, dataA, 4));
+  CHECK_EQ(LIN.getState(), LIN_Slave_Base::STATE_DONE);
+  CHECK_EQ(LIN.getError(), LIN_Slave_Base::NO_ERROR);
+
+  // diagnostic frame uses classic checksum
+  CHECK(LIN.publishResponse(0x3D, dataDiag, 8));
+  num = requestResponse(LIN, 0x3D, buf);
+  CHECK(checkResponse(0x3D, buf, num, dataDiag, 8));
+  CHECK_EQ(buf[8], LIN_Slave_Protocol::checksum(0x00, dataDiag, 8));
+
+  // published response takes precedence over callback
+  CHECK(LIN.publishResponse(0x21, dataB, 3));
+  numCallback = 0;
+  num = requestResponse(LIN, 0x21, buf);
+  CHECK(checkResponse(0x21, buf, num, dataB, 3));
+  CHECK_EQ(numCallback, 0);
+
+  // transaction: old data is sent until commit, new slot is inactive until commit
+  gen = LIN.getPublishGeneration();
+  LIN.beginPublish();
+  CHECK(LIN.publishResponse(0x20, dataB, 4));
+  CHECK(LIN.publishResponse(0x20, dataB, 2));     // last publish in transaction wins
+  CHECK(LIN.publishResponse(0x22, dataA, 4));
+  CHECK_EQ(LIN.getPublishGeneration(), gen);
+  num = requestResponse(LIN, 0x20, buf);
+  CHECK(checkResponse(0x20, buf, num, dataA, 4));
+  num = requestResponse(LIN, 0x22, buf);
+  CHECK_EQ(num, 0);
+  LIN.commitPublish();
+  CHECK_EQ(LIN.getPublishGeneration(), (uint8_t) (gen+1));
+  num = requestResponse(LIN, 0x20, buf);
+  CHECK(checkResponse(0x20, buf, num, dataB, 2));
+  num = requestResponse(LIN, 0x22, buf);
+  CHECK(checkResponse(0x22, buf, num, dataA, 4));
+
+  // both buffers are in sync after commit: single publish of other ID keeps data of 0x20
+  CHECK(LIN.publishResponse(0x22, dataB, 1));
+  num = requestResponse(LIN, 0x20, buf);
+  CHECK(checkResponse(0x20, buf, num, dataB, 2));
+  num = requestResponse(LIN, 0x22, buf);
+  CHECK(checkResponse(0x22, buf, num, dataB, 1));
+
+  // invalid length or all slots used (0x20, 0x3D, 0x21, 0x22) -> rejected
+  CHECK(!LIN.publishResponse(0x23, dataA, 0));
+  CHECK(!LIN.publishResponse(0x23, dataA, 9));
+  CHECK(!LIN.publishResponse(0x23, dataA, 4));
+  CHECK(LIN.publishResponse(0x22 | 0xC0, dataA, 4));    // parity bits are ignored
+  num = requestResponse(LIN, 0x22, buf);
+  CHECK(checkResponse(0x22, buf, num, dataA, 4));
+
+  return TEST_RESULT();
+}
@@ -0,0 +1,136 @@
+/**
+  \file     test_queue.cpp
+  \brief    Host test of the lock-free queue of completed frames
+  \details  Checks index wrap-around, both overflow policies and consistency of records read while the producer
+            overwrites them (producer and consumer in separate threads). Requires LIN_SLAVE_FRAME_QUEUE > 0
+  \author   Georg Icking-Konert
+*/
+
+// include files
+#include <thread>
+#include "test_common.h"
+
+
+/**
+  \brief  Node which pushes synthetic frames
+*/
+class LIN_Slave_Queue : public LIN_Slave_Test<>
+{
+  public:
+    LIN_Slave_Queue() : LIN_Slave_Test<>("Queue") { }
+
+    /// push frame number Num. All data bytes and ID are derived from Num, i.e. a torn record is detected
+    void push(uint32_t Num)
+    {
+      this->id      = (uint8_t) (Num & 0x3F);
+      this->type    = LIN_Slave_Base::MASTER_REQUEST;
+      this->numData = 8;
+      for (uint8_t i=0; i<8; i++)
+        this->bufData[i] = (uint8_t) (Num >> (8*(i & 0x03)));
+      this->_pushFrame();
+    }
+};
+
+// check record consistency and return frame number
+static uint32_t checkRecord(const LIN_Slave_Base::frame_record_t &Frame)
+{
+  uint32_t num = (uint32_t) Frame.data[0] | ((uint32_t) Frame.data[1] << 8) | ((uint32_t) Frame.data[2] << 16) | ((uint32_t) Frame.data[3] << 24);
+  CHECK(memcmp(Frame.data, Frame.data+4, 4) == 0);
+  CHECK_EQ(Frame.id, num & 0x3F);
+  CHECK_EQ(Frame.numData, 8);
+  return num;
+}
+
+
+int main()
+{
+  LIN_Slave_Base::frame_record_t  frame;
+
+  // wrap-around of free running 8-bit indices, queue never full
+  {
+    LIN_Slave_Queue LIN;
+    LIN.begin(19200);
+    for (uint32_t i=0; i<1000; i++)
+    {
+      LIN.push(i);
+      if (i & 0x01)
+      {
+        CHECK(LIN.readFrame(frame));
+        CHECK_EQ(checkRecord(frame), i-1);
+        CHECK(LIN.readFrame(frame));
+        CHECK_EQ(checkRecord(frame), i);
+      }
+    }
+    CHECK(!LIN.readFrame(frame));
+    CHECK_EQ(LIN.getQueueOverflow(), 0);
+  }
+
+  // full queue, drop new frames: oldest LIN_SLAVE_FRAME_QUEUE frames are kept
+  {
+    LIN_Slave_Queue LIN;
+    LIN.begin(19200);
+    LIN.setQueuePolicy(LIN_Slave_Base::QUEUE_DROP_NEW);
+    for (uint32_t i=0; i<LIN_SLAVE_FRAME_QUEUE+3; i++)
+      LIN.push(i);
+    CHECK_EQ(LIN.getQueueOverflow(), 3);
+    for (uint32_t i=0; i<LIN_SLAVE_FRAME_QUEUE; i++)
+    {
+      CHECK(LIN.readFrame(frame));
+      CHECK_EQ(checkRecord(frame), i);
+    }
+    CHECK(!LIN.readFrame(frame));
+  }
+
+  // full queue, overwrite oldest: newest LIN_SLAVE_FRAME_QUEUE-1 frames are kept. Also with stalled reader (>256 frames)
+  {
+    const uint32_t numFrames[2] = { LIN_SLAVE_FRAME_QUEUE+5, 1000 };
+    for (uint8_t k=0; k<2; k++)
+    {
+      LIN_Slave_Queue LIN;
+      LIN.begin(19200);
+      LIN.setQueuePolicy(LIN_Slave_Base::QUEUE_OVERWRITE_OLD);
+      for (uint32_t i=0; i<numFrames[k]; i++)
+        LIN.push(i);
+      CHECK_EQ(LIN.getQueueOverflow(), numFrames[k] - (LIN_SLAVE_FRAME_QUEUE-1));
+      for (uint32_t i=numFrames[k]-(LIN_SLAVE_FRAME_QUEUE-1); i<numFrames[k]; i++)
+      {
+        CHECK(LIN.readFrame(frame));
+        CHECK_EQ(checkRecord(frame), i);
+      }
+      CHECK(!LIN.readFrame(frame));
+    }
+  }
+
+  // concurrent producer with overwrite: no torn record, frame numbers increase.
+  // Note: stress test, torn reads are only likely on a multi-core host where producer and consumer really run in parallel
+  {
+    LIN_Slave_Queue   LIN;
+    const uint32_t    numFrames = 2000000;
+    volatile bool     flagDone = false;
+    uint32_t          numRead = 0, numPrev = 0;
+    int               numFailedPrev = testNumFailed;
+
+    LIN.begin(19200);
+    LIN.setQueuePolicy(LIN_Slave_Base::QUEUE_OVERWRITE_OLD);
+    std::thread producer([&]() {
+      for (uint32_t i=1; i<=numFrames; i++)
+        LIN.push(i);
+      flagDone = true;
+    });
+    while ((!flagDone) && (testNumFailed - numFailedPrev < 10))
+    {
+      if (LIN.readFrame(frame))
+      {
+        uint32_t num = checkRecord(frame);
+        CHECK(num > numPrev);
+        numPrev = num;
+        numRead++;
+      }
+    }
+    producer.join();
+    CHECK(numRead > 0);
+    printf("concurrent: %u of %u frames read\n", (unsigned) numRead, (unsigned) numFrames);
+  }
+
+  return TEST_RESULT();
+}
@@ -0,0 +1,111 @@
+/**
+  \file     test_resync.cpp
+  \brief    Host test of frame header resynchronization without BREAK
+  \details  Checks scoring of bytes outside a frame (see LIN_SLAVE_RESYNC_SCORE): a header after a missed BREAK is found,
+            while 0x00 0x55 PID inside frame data or back-to-back without pause is not, and a finished frame in STATE_DONE is kept
+  \author   Georg Icking-Konert
+*/
+
+// include files
+#include "test_common.h"
+
+
+/// Test backend with explicit BREAK flag, i.e. a 0x00 without framing error is no BREAK
+typedef LIN_Slave_Test<>        LIN_Slave_Resync;
+
+
+// received master request
+static uint8_t  numRequest = 0;
+static uint8_t  dataRequest[8];
+
+// master request callback: store data
+void masterRequest(uint8_t numData, uint8_t* data)
+{
+  numRequest = numData;
+  memcpy(dataRequest, data, numData);
+}
+
+// number of resynchronizations in log
+static uint8_t countResync(LIN_Slave_Resync &LIN)
+{
+  LIN_Slave_Base::log_entry_t   entry;
+  uint8_t                       num = 0;
+
+  while (LIN.readLog(entry))
+    num += (entry.event == LIN_Slave_Base::LOG_RESYNC) ? 1 : 0;
+  return num;
+}
+
+
+int main()
+{
+  LIN_Slave_Resync      LIN;
+  const uint8_t         pid = LIN_Slave_Protocol::getPID(0x10);
+  const uint8_t         dataFake[4] = { 0x00, 0x55, pid, 0x01 };
+  const uint8_t         data[4] = { 0x11, 0x22, 0x33, 0x44 };
+  LIN_Slave_Base::frame_t type;
+  uint8_t               id, numData, buf[8];
+
+  // virtual clock for deterministic timing
+  ArduinoHost::useVirtualTime(true);
+  ArduinoHost::setMicros(100000);
+  LIN.begin(19200);
+  LIN.registerMasterRequestHandler(0x10, masterRequest, 4);
+
+  // missed BREAK: pause, 0x00 without framing error, 0x55, PID -> score 5, frame is received
+  LIN.receive(0x00, false, 5000);
+  LIN.receive(0x55);
+  LIN.receive(pid);
+  CHECK_EQ(LIN.getState(), LIN_Slave_Base::STATE_RECEIVING_DATA);
+  LIN.receiveData(0x10, data, 4);
+  CHECK_EQ(LIN.getState(), LIN_Slave_Base::STATE_DONE);
+  CHECK_EQ(LIN.getError(), LIN_Slave_Base::NO_ERROR);
+  CHECK(memcmp(dataRequest, data, 4) == 0);
+  CHECK_EQ(countResync(LIN), 1);
+  LIN.resetStateMachine();
+
+  // header candidate with invalid PID is discarded silently, search continues
+  LIN.receive(0x00, false, 5000);
+  LIN.receive(0x55);
+  LIN.receive(pid ^ 0x80);
+  CHECK_EQ(LIN.getState(), LIN_Slave_Base::STATE_WAIT_FOR_BREAK);
+  CHECK_EQ(LIN.getError(), LIN_Slave_Base::NO_ERROR);
+  CHECK_EQ(countResync(LIN), 0);
+
+  // back-to-back 0x00 0x55 PID without pause -> score 3, no frame
+  LIN.receive(0x01, false, 5000);
+  LIN.receive(0x00);
+  LIN.receive(0x55);
+  LIN.receive(pid);
+  CHECK_EQ(LIN.getState(), LIN_Slave_Base::STATE_WAIT_FOR_BREAK);
+  CHECK_EQ(countResync(LIN), 0);
+
+  // pause 0x00 0x55 PID inside data of a received frame -> is data, no resync
+  numRequest = 0;
+  LIN.receive(0x00, true, 5000);
+  LIN.receive(0x55);
+  LIN.receive(pid);
+  LIN.receive(dataFake[0], false, 700);
+  for (uint8_t i=1; i<4; i++)
+    LIN.receive(dataFake[i]);
+  LIN.receive(LIN_Slave_Protocol::checksum(LIN_Slave_Protocol::getSeed(0x10, true), dataFake, 4));
+  CHECK_EQ(LIN.getState(), LIN_Slave_Base::STATE_DONE);
+  CHECK_EQ(LIN.getError(), LIN_Slave_Base::NO_ERROR);
+  CHECK_EQ(numRequest, 4);
+  CHECK(memcmp(dataRequest, dataFake, 4) == 0);
+  CHECK_EQ(countResync(LIN), 0);
+
+  // finished frame not yet fetched: pause 0x00 0x55 PID doesn't overwrite it
+  LIN.receive(0x00, false, 5000);
+  LIN.receive(0x55);
+  LIN.receive(LIN_Slave_Protocol::getPID(0x20));
+  CHECK_EQ(LIN.getState(), LIN_Slave_Base::STATE_DONE);
+  LIN.getFrame(type, id, numData, buf);
+  CHECK_EQ(type, LIN_Slave_Base::MASTER_REQUEST);
+  CHECK_EQ(id, 0x10);
+  CHECK_EQ(numData, 4);
+  CHECK(memcmp(buf, dataFake, 4) == 0);
+  CHECK_EQ(countResync(LIN), 0);
+
+  return TEST_RESULT();
+}
@@ -0,0 +1,90 @@
+/**
+  \file     test_runner.cpp
+  \brief    Host test of the parallel sweep runner of the bus simulator
+  \details  Checks that the static library state is per thread, that clusters in parallel worker threads do not interfere,
+            i.e. results with several threads equal the sequential results, and that sweep points and replicas are combined
+            as expected. Prints wall times for 1 and N threads for information only, as speedup depends on the machine
+  \author   Georg Icking-Konert
+*/
+
+// include files
+#include <string.h>
+#include <thread>
+#include "../simulator/LIN_sim_runner.h"
+#include "test_common.h"
+
+
+// build runner with 2x2x2 sweep points
+static void buildSweep(LIN_Sim_Runner &Runner)
+{
+  LIN_Sim_Runner::point_t base;
+
+  base.config           = LIN_Bus_Sim::defaultConfig();
+  base.config.noise     = 1e-4;
+  base.config.timeJitter = 50;
+  base.numSlaves        = 3;
+  base.backend          = LIN_Sim_Cluster::BACKEND_FE;
+  Runner.addSweep(base, { 9600, 19200 }, { 0.0, 1e-4 }, { 2, 6 }, { 100 });
+}
+
+
+// 64-bit time of a thread: wrap-around of virtual micros(), then later time
+static void threadTime(uint64_t Time, uint64_t *Result)
+{
+  ArduinoHost::useVirtualTime(true);
+  ArduinoHost::setMicros(Time - 0x2000);
+  LIN_Slave_Base::getMicros64();
+  ArduinoHost::setMicros(Time);
+  *Result = LIN_Slave_Base::getMicros64();
+}
+
+
+int main()
+{
+  LIN_Sim_Runner  sequential(1000000, 3);
+  LIN_Sim_Runner  parallel(1000000, 3);
+  unsigned        numThreads = 8;
+  uint64_t        timeA = 0, timeB = 0;
+
+  // 64-bit time is extended per thread, i.e. a thread with small time does not see the wrap-around of another thread
+  std::thread threadA(threadTime, 0x100001000ULL, &timeA);
+  threadA.join();
+  std::thread threadB(threadTime, 0x3000ULL, &timeB);
+  threadB.join();
+  CHECK(timeA == 0x100001000ULL);
+  CHECK(timeB == 0x3000ULL);
+
+  // same sweep with 1 and 8 worker threads
+  buildSweep(sequential);
+  buildSweep(parallel);
+  CHECK_EQ(sequential.getNumPoints(), 8);
+  sequential.run(1);
+  parallel.run(numThreads);
+
+  // results are identical and plausible
+  for (size_t i = 0; i < sequential.getNumPoints(); i++)
+  {
+    const LIN_Bus_Sim::result_t &result = parallel.getResult(i);
+    CHECK(memcmp(&(sequential.getResult(i)), &result, sizeof(LIN_Bus_Sim::result_t)) == 0);
+    CHECK_EQ(result.timeSim, 3 * 1000000);
+    CHECK(result.responsesOk > 0);
+  }
+
+  // noise-free sweep points are error-free, noisy ones have glitches. Order is baudrate, noise, slaves, poll
+  for (size_t i = 0; i < parallel.getNumPoints(); i++)
+  {
+    const LIN_Bus_Sim::result_t &result = parallel.getResult(i);
+    if ((i / 2) % 2 == 0)
+    {
+      CHECK_EQ(result.glitches, 0);
+      CHECK_EQ(result.responsesError + result.responsesMissing, 0);
+    }
+    else
+      CHECK(result.glitches > 0);
+  }
+
+  // wall times for information
+  printf("wall time 1 thread %.3f s, %u threads %.3f s\n", sequential.getWallTime(), numThreads, parallel.getWallTime());
+
+  return TEST_RESULT();
+}
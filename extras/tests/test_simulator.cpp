@@ -0,0 +1,82 @@
+/**
+  \file     test_simulator.cpp
+  \brief    Host test of the bit-level LIN bus simulator
+  \details  Checks that a cluster without noise runs error-free with both BREAK detection methods and response space
+            bounded by the handler() period, that colliding responses and noise are detected, and that results are
+            reproducible for a given seed
+  \author   Georg Icking-Konert
+*/
+
+// include files
+#include <string.h>
+#include "../simulator/LIN_sim_cluster.h"
+#include "test_common.h"
+
+
+int main()
+{
+  LIN_Bus_Sim::config_t   config = LIN_Bus_Sim::defaultConfig();
+  LIN_Bus_Sim::result_t   resultA, resultB;
+
+  // no noise: all responses ok (last may be pending), each frame finished by one slave, response space < handler() period + 2 bit times
+  for (uint8_t backend = 0; backend < 2; backend++)
+  {
+    LIN_Sim_Cluster cluster(config, 4, (LIN_Sim_Cluster::backend_t) backend);
+    const LIN_Bus_Sim::result_t &result = cluster.run(2000000);
+    CHECK(result.frames > 100);
+    CHECK(result.responsesOk + 1 >= result.frames / 2);
+    CHECK_EQ(result.responsesMissing, 0);
+    CHECK_EQ(result.responsesError, 0);
+    CHECK(result.slaveFrames + 1 >= result.frames);
+    for (uint8_t i = 0; i < 8; i++)
+      CHECK_EQ(result.slaveErrors[i], 0);
+    CHECK(result.latencyMax < config.timePoll + 2 * 1000000 / config.baudrate);
+    CHECK_EQ(result.glitches, 0);
+  }
+
+  // slower loop(): response space grows with handler() period
+  {
+    LIN_Bus_Sim::config_t configSlow = config;
+    configSlow.timePoll = 500;
+    LIN_Sim_Cluster cluster(configSlow, 2, LIN_Sim_Cluster::BACKEND_FE);
+    const LIN_Bus_Sim::result_t &result = cluster.run(2000000);
+    CHECK_EQ(result.responsesError, 0);
+    CHECK(result.latencyMax > config.timePoll + 2 * 1000000 / config.baudrate);
+    CHECK(result.latencyMax < configSlow.timePoll + 2 * 1000000 / configSlow.baudrate);
+  }
+
+  // two slaves respond to same ID: collision is detected by slaves via echo and by master
+  {
+    LIN_Sim_Cluster cluster(config, 2, LIN_Sim_Cluster::BACKEND_FE, true);
+    const LIN_Bus_Sim::result_t &result = cluster.run(1000000);
+    CHECK(result.responsesOk + result.responsesError > 0);
+    CHECK(result.slaveErrors[1] + result.slaveErrors[3] > 0);
+  }
+
+  // noise: glitches are counted and cause errors
+  {
+    LIN_Bus_Sim::config_t configNoise = config;
+    configNoise.noise = 1e-3;
+    LIN_Sim_Cluster cluster(configNoise, 4, LIN_Sim_Cluster::BACKEND_FE);
+    const LIN_Bus_Sim::result_t &result = cluster.run(5000000);
+    CHECK(result.glitches > 0);
+    CHECK(result.responsesError + result.responsesMissing > 0);
+    CHECK(result.responsesOk > 0);
+  }
+
+  // same seed and jitter: identical results
+  config.noise = 1e-4;
+  config.timeJitter = 50;
+  {
+    LIN_Sim_Cluster cluster(config, 3, LIN_Sim_Cluster::BACKEND_PAUSE);
+    resultA = cluster.run(3000000);
+  }
+  {
+    LIN_Sim_Cluster cluster(config, 3, LIN_Sim_Cluster::BACKEND_PAUSE);
+    resultB = cluster.run(3000000);
+  }
+  CHECK(memcmp(&resultA, &resultB, sizeof(resultA)) == 0);
+  CHECK(resultA.glitches > 0);
+
+  return TEST_RESULT();
+}
@@ -0,0 +1,147 @@
+/**
+  \file     test_statistics.cpp
+  \brief    Host test of timing statistics (LIN_SLAVE_STATISTICS)
+  \details  Frames are received with receive times like captured in a receive ISR, and handled after a known loop() delay
+            on a virtual clock. Checks that latency includes this delay, that inter-byte gaps are the bus timing and not the
+            handler() call spacing, and the histograms of handler and callback times incl. getCallbackTimeMax() and resetStatistics()
+  \author   Georg Icking-Konert
+*/
+
+// include files
+#include <LIN_slave_Sim.h>
+#include "test_common.h"
+
+
+// execution time [us] of callbacks on virtual clock
+#define TIME_REQUEST    40
+#define TIME_RESPONSE   100
+
+// delay [us] of handler() call after last received byte, e.g. due to a long loop()
+#define TIME_LOOP       3000
+
+
+// master request callback
+void masterRequest(uint8_t numData, uint8_t* data)
+{
+  (void) numData;
+  (void) data;
+  ArduinoHost::advanceMicros(TIME_REQUEST);
+}
+
+// slave response callback
+void slaveResponse(uint8_t numData, uint8_t* data)
+{
+  for (uint8_t i=0; i<numData; i++)
+    data[i] = i;
+  ArduinoHost::advanceMicros(TIME_RESPONSE);
+}
+
+// inject BREAK and bytes into Rx buffer, one byte time apart
+static void inject(const uint8_t Bytes[], uint8_t Num)
+{
+  ArduinoHost::advanceMicros(5000);
+  Serial1.hostReceive(0x00, true);
+  for (uint8_t i=0; i<Num; i++)
+  {
+    ArduinoHost::advanceMicros(TEST_TIME_BYTE);
+    Serial1.hostReceive(Bytes[i]);
+  }
+}
+
+// number of samples in histogram
+static uint16_t numSamples(const LIN_Slave_Base::histogram_t &Histogram)
+{
+  uint16_t num = 0;
+  for (uint8_t i=0; i<LIN_SLAVE_STAT_BINS; i++)
+    num += Histogram.count[i];
+  return num;
+}
+
+
+int main()
+{
+  LIN_Slave_Sim                 LIN(Serial1, LIN_Slave_Base::LIN_V2, "Stat");
+  LIN_Slave_Base::histogram_t   hist;
+  uint8_t                       bufTx[16];
+
+  // virtual clock for deterministic timing
+  ArduinoHost::useVirtualTime(true);
+  ArduinoHost::setMicros(100000);
+  LIN.begin(19200);
+  LIN.registerMasterRequestHandler(0x10, masterRequest, 4);
+  LIN.registerSlaveResponseHandler(0x20, slaveResponse, 2);
+
+  // no samples after begin()
+  for (uint8_t i=0; i<LIN_Slave_Base::STAT_NUM; i++)
+  {
+    LIN.getHistogram((LIN_Slave_Base::statistics_t) i, hist);
+    CHECK_EQ(numSamples(hist), 0);
+    CHECK_EQ(hist.max, 0);
+  }
+
+  // slave response header, handled TIME_LOOP after PID reception
+  const uint8_t header[2] = { 0x55, LIN_Slave_Protocol::getPID(0x20) };
+  inject(header, 2);
+  ArduinoHost::advanceMicros(TIME_LOOP);
+  CHECK_EQ(LIN.handlerDrain(), 2);
+  CHECK_EQ(Serial1.hostTransmit(bufTx, sizeof(bufTx)), 3);
+  CHECK_EQ(LIN.getState(), LIN_Slave_Base::STATE_RECEIVING_ECHO);
+
+  // latency = loop delay + callback, i.e. 3100us -> bin 12 (2048..4095us)
+  LIN.getHistogram(LIN_Slave_Base::STAT_LATENCY, hist);
+  CHECK_EQ(numSamples(hist), 1);
+  CHECK_EQ(hist.count[12], 1);
+  CHECK_EQ(hist.max, TIME_LOOP + TIME_RESPONSE);
+
+  // gaps BREAK->SYNC and SYNC->PID are byte times, not handler() spacing -> bin 10 (512..1023us)
+  LIN.getHistogram(LIN_Slave_Base::STAT_GAP, hist);
+  CHECK_EQ(numSamples(hist), 2);
+  CHECK_EQ(hist.count[10], 2);
+  CHECK_EQ(hist.max, TEST_TIME_BYTE);
+
+  // callback time 100us -> bin 7 (64..127us), max. per ID
+  LIN.getHistogram(LIN_Slave_Base::STAT_CALLBACK, hist);
+  CHECK_EQ(numSamples(hist), 1);
+  CHECK_EQ(hist.count[7], 1);
+  CHECK_EQ(LIN.getCallbackTimeMax(0x20), TIME_RESPONSE);
+  CHECK_EQ(LIN.getCallbackTimeMax(LIN_Slave_Protocol::getPID(0x20)), TIME_RESPONSE);
+  CHECK_EQ(LIN.getCallbackTimeMax(0x10), 0);
+
+  // handler time: SYNC takes no virtual time (bin 0), PID incl. callback -> bin 7
+  LIN.getHistogram(LIN_Slave_Base::STAT_HANDLER, hist);
+  CHECK_EQ(numSamples(hist), 2);
+  CHECK_EQ(hist.count[0], 1);
+  CHECK_EQ(hist.count[7], 1);
+
+  // reset clears all histograms and max. callback times
+  LIN.resetStatistics();
+  for (uint8_t i=0; i<LIN_Slave_Base::STAT_NUM; i++)
+  {
+    LIN.getHistogram((LIN_Slave_Base::statistics_t) i, hist);
+    CHECK_EQ(numSamples(hist), 0);
+    CHECK_EQ(hist.max, 0);
+  }
+  CHECK_EQ(LIN.getCallbackTimeMax(0x20), 0);
+
+  // master request handled late as backlog: gaps are still byte times, no latency sample
+  const uint8_t data[4] = { 1, 2, 3, 4 };
+  const uint8_t request[7] = { 0x55, LIN_Slave_Protocol::getPID(0x10), data[0], data[1], data[2], data[3],
+    LIN_Slave_Protocol::checksum(LIN_Slave_Protocol::getSeed(0x10, true), data, 4) };
+  inject(request, 7);
+  ArduinoHost::advanceMicros(TIME_LOOP);
+  CHECK_EQ(LIN.handlerDrain(), 7);
+  CHECK_EQ(LIN.getState(), LIN_Slave_Base::STATE_DONE);
+  CHECK_EQ(LIN.getError(), LIN_Slave_Base::NO_ERROR);
+  LIN.getHistogram(LIN_Slave_Base::STAT_GAP, hist);
+  CHECK_EQ(numSamples(hist), 7);
+  CHECK_EQ(hist.count[10], 7);
+  LIN.getHistogram(LIN_Slave_Base::STAT_LATENCY, hist);
+  CHECK_EQ(numSamples(hist), 0);
+  CHECK_EQ(LIN.getCallbackTimeMax(0x10), TIME_REQUEST);
+
+  // invalid statistics type returns empty histogram
+  LIN.getHistogram(LIN_Slave_Base::STAT_NUM, hist);
+  CHECK_EQ(numSamples(hist), 0);
+
+  return TEST_RESULT();
+}
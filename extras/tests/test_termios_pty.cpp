@@ -0,0 +1,191 @@
+/**
+  \file     test_termios_pty.cpp
+  \brief    End-to-end host test of LIN_Slave_Termios via a pseudo-terminal
+  \details  The test acts as LIN master on the master side of a pty, the slave node opens the pty slave device.
+            The tty driver escapes data 0xFF as 0xFF 0xFF (PARMRK). A pty cannot send a BREAK, therefore the BREAK mark
+            0xFF 0x00 0x00 is injected into the raw receive buffer of the node. Bus echo of slave responses is emulated.
+            Time of the LIN node is virtual, i.e. timeouts are deterministic. Prints CPU time of handler() per frame
+  \author   Georg Icking-Konert
+*/
+
+// include files
+#include <LIN_slave_Termios.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+#include "test_common.h"
+
+
+/**
+  \brief  Termios node with access to raw receive buffer
+*/
+class LIN_Slave_TermiosTest : public LIN_Slave_Termios
+{
+  public:
+    LIN_Slave_TermiosTest(const char Device[]) : LIN_Slave_Termios(Device, LIN_Slave_Base::LIN_V2, "Termios") { }
+
+    /// inject raw bytes before pending tty data, e.g. BREAK mark 0xFF 0x00 0x00. Raw buffer must be consumed
+    void injectRaw(const uint8_t Buf[], uint8_t Num)
+    {
+      memcpy(this->bufRaw, Buf, Num);
+      this->idxRaw = 0;
+      this->numRaw = Num;
+    }
+
+    /// read decoded data byte
+    uint8_t readByte(void) { return this->_serialRead(); }
+
+    /// raw buffer is consumed
+    bool rawEmpty(void) { return (this->idxRaw >= this->numRaw); }
+};
+
+
+// master side of pty
+static int      fdMaster;
+
+// received master requests
+static uint8_t  numRequest = 0;
+static uint8_t  dataRequest[8];
+
+// master request callback: store data
+void masterRequest(uint8_t numData, uint8_t* data)
+{
+  numRequest++;
+  memcpy(dataRequest, data, numData);
+}
+
+// slave response callback: data with 0xFF
+void slaveResponse(uint8_t numData, uint8_t* data)
+{
+  (void) numData;
+  data[0] = 0xFF;
+  data[1] = 0x12;
+}
+
+// CPU time of calling thread [ns]
+static uint64_t cpuTime(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+  return (uint64_t) ts.tv_sec * 1000000000ULL + (uint64_t) ts.tv_nsec;
+}
+
+// inject BREAK, send frame bytes as master and wait until they are readable by the node. Previous frame is done
+static void sendFrame(LIN_Slave_TermiosTest &LIN, const uint8_t Buf[], uint8_t Num)
+{
+  const uint8_t markBreak[3] = { 0xFF, 0x00, 0x00 };
+  CHECK(LIN.rawEmpty());
+  if (LIN.getState() == LIN_Slave_Base::STATE_DONE)
+    LIN.resetStateMachine();
+  CHECK_EQ(write(fdMaster, Buf, Num), Num);
+  usleep(2000);
+  LIN.injectRaw(markBreak, 3);
+}
+
+// call handler until frame is done, emulate bus echo of slave response. Returns CPU time [ns] of handler()
+static uint64_t runFrame(LIN_Slave_TermiosTest &LIN)
+{
+  uint8_t   buf[16];
+  uint64_t  timeCpu = 0, timeStart;
+  int       num;
+
+  for (int i=0; (i < 1000) && (LIN.getState() != LIN_Slave_Base::STATE_DONE); i++)
+  {
+    ArduinoHost::advanceMicros(50);
+    timeStart = cpuTime();
+    LIN.handler();
+    timeCpu += cpuTime() - timeStart;
+
+    // echo sent response back to node
+    num = read(fdMaster, buf, sizeof(buf));
+    if (num > 0)
+      CHECK_EQ(write(fdMaster, buf, num), num);
+    if ((i % 10) == 9)
+      usleep(100);
+  }
+  return timeCpu;
+}
+
+
+int main()
+{
+  const uint8_t   pidReq = LIN_Slave_Protocol::getPID(0x1A);
+  const uint8_t   pidResp = LIN_Slave_Protocol::getPID(0x05);
+  const uint8_t   data[4] = { 0xFF, 0x01, 0xFF, 0xFF };
+  uint8_t         frameReq[7] = { 0x55, pidReq, data[0], data[1], data[2], data[3],
+                    LIN_Slave_Protocol::checksum(LIN_Slave_Protocol::getSeed(0x1A, true), data, 4) };
+  uint8_t         frameResp[2] = { 0x55, pidResp };
+  uint64_t        timeCpu = 0;
+  const int       numFrames = 200;
+
+  // virtual clock of node
+  ArduinoHost::useVirtualTime(true);
+  ArduinoHost::setMicros(100000);
+
+  // open pty
+  fdMaster = posix_openpt(O_RDWR | O_NOCTTY);
+  CHECK(fdMaster >= 0);
+  CHECK(grantpt(fdMaster) == 0);
+  CHECK(unlockpt(fdMaster) == 0);
+  fcntl(fdMaster, F_SETFL, O_NONBLOCK);
+
+  // open node
+  LIN_Slave_TermiosTest   LIN(ptsname(fdMaster));
+  LIN.begin(19200);
+  CHECK(LIN.getState() != LIN_Slave_Base::STATE_OFF);
+  LIN.registerMasterRequestHandler(0x1A, masterRequest, 4);
+  LIN.registerSlaveResponseHandler(0x05, slaveResponse, 2);
+
+  // data byte with framing error (0xFF 0x00 x) is passed as data byte x, i.e. outside frame ignored
+  {
+    const uint8_t markError[3] = { 0xFF, 0x00, 0x33 };
+    LIN.injectRaw(markError, 3);
+    CHECK(LIN.available());
+    CHECK_EQ(LIN.readByte(), 0x33);
+  }
+
+  // master requests and slave responses with escaped data 0xFF
+  for (int i=0; i<numFrames; i++)
+  {
+    LIN.resetError();
+    if (i & 0x01)
+      sendFrame(LIN, frameResp, 2);
+    else
+      sendFrame(LIN, frameReq, 7);
+    timeCpu += runFrame(LIN);
+    CHECK_EQ(LIN.getError(), LIN_Slave_Base::NO_ERROR);
+  }
+  CHECK_EQ(numRequest, numFrames/2);
+  CHECK(memcmp(dataRequest, data, 4) == 0);
+  printf("handler() CPU time per frame: %.2f us\n", (double) timeCpu / 1000.0 / numFrames);
+
+  // truncated master request (header + 2 data bytes) is aborted by timeout
+  LIN.resetError();
+  sendFrame(LIN, frameReq, 4);
+  for (int i=0; i<50; i++)
+  {
+    LIN.handler();
+    usleep(100);
+  }
+  CHECK_EQ(LIN.getState(), LIN_Slave_Base::STATE_RECEIVING_DATA);
+
+  // next frame arrives before timeout is detected, i.e. BREAK, SYNC and PID are pending together
+  numRequest = 0;
+  ArduinoHost::advanceMicros(50000);
+  sendFrame(LIN, frameReq, 7);
+  runFrame(LIN);
+  CHECK(LIN.getError() & LIN_Slave_Base::ERROR_TIMEOUT);
+  CHECK_EQ(numRequest, 1);
+  CHECK_EQ(LIN.getState(), LIN_Slave_Base::STATE_DONE);
+
+  // close node
+  LIN.end();
+  close(fdMaster);
+
+  // not existing device -> node is off
+  LIN_Slave_TermiosTest   LIN2("/dev/nonexistent_lin");
+  LIN2.begin(19200);
+  CHECK_EQ(LIN2.getState(), LIN_Slave_Base::STATE_OFF);
+
+  return TEST_RESULT();
+}
@@ -0,0 +1,133 @@
+/**
+  \file     test_timeout.cpp
+  \brief    Host test of frame timeout in polled mode
+  \details  Truncated master requests with 1..8 of 8 data bytes are received at 9600 and 19200 Baud, and handler() is polled
+            on a virtual clock. Checks that ERROR_TIMEOUT is set on the first handler() call after TFrame_Max = 1.4*TFrame_Nominal
+            since BREAK, and that the next BREAK starts a valid frame. Further checks that setTimeoutAdaptive() extends the
+            timeout for a master with inter-byte space. Receive timeout between bytes is disabled via a large TimeoutRx
+  \author   Georg Icking-Konert
+*/
+
+// include files
+#include <LIN_slave_Sim.h>
+#include "test_common.h"
+
+
+// period [us] of handler() calls after last received byte
+#define TIME_POLL       10
+
+// max. time [us] to poll for timeout
+#define TIME_MAX        100000L
+
+
+// number of received master requests
+static uint8_t numRequest = 0;
+
+// master request callback
+void masterRequest(uint8_t numData, uint8_t* data)
+{
+  (void) numData;
+  (void) data;
+  numRequest++;
+}
+
+// receive BREAK and first NumBytes bytes of master request 0x18 (SYNC, PID, 8 data, checksum) with given byte period.
+// Calls handler() every TIME_POLL and after each byte, returns receive time of BREAK
+static uint32_t receiveFrame(LIN_Slave_Sim &Slave, uint32_t TimeByte, uint8_t NumBytes)
+{
+  uint8_t     bytes[11] = { 0x55, LIN_Slave_Protocol::getPID(0x18), 0xA0, 0xA1, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6, 0xA7, 0x00 };
+  uint32_t    timeBreak, timeNext;
+
+  bytes[10] = LIN_Slave_Protocol::checksum(LIN_Slave_Protocol::getSeed(0x18, true), bytes + 2, 8);
+  ArduinoHost::advanceMicros(5000);
+  timeBreak = micros();
+  Serial1.hostReceive(0x00, true);
+  Slave.handler();
+  for (uint8_t i=0; i<NumBytes; i++)
+  {
+    timeNext = micros() + TimeByte;
+    while ((int32_t) (timeNext - micros()) > TIME_POLL)
+    {
+      ArduinoHost::advanceMicros(TIME_POLL);
+      Slave.handler();
+    }
+    ArduinoHost::setMicros(timeNext);
+    Serial1.hostReceive(bytes[i]);
+    Slave.handler();
+  }
+  return timeBreak;
+}
+
+// poll handler() until ERROR_TIMEOUT. Returns time [us] since BREAK, or 0 if no timeout within TIME_MAX
+static uint32_t pollTimeout(LIN_Slave_Sim &Slave, uint32_t TimeBreak)
+{
+  while ((uint32_t) (micros() - TimeBreak) < TIME_MAX)
+  {
+    if (Slave.getError() & LIN_Slave_Base::ERROR_TIMEOUT)
+      return micros() - TimeBreak;
+    ArduinoHost::advanceMicros(TIME_POLL);
+    Slave.handler();
+  }
+  return 0;
+}
+
+
+int main()
+{
+  const uint32_t  baudrates[2] = { 9600, 19200 };
+
+  ArduinoHost::useVirtualTime(true);
+  ArduinoHost::setMicros(100000);
+
+  for (uint8_t k=0; k<2; k++)
+  {
+    LIN_Slave_Sim   LIN(Serial1, LIN_Slave_Base::LIN_V2, "Timeout", 50000L);
+    uint32_t        timeByte  = 10000000L / baudrates[k];
+    uint32_t        timeFrame = (34 + 10 * 9) * 1400000L / baudrates[k];
+    uint32_t        timeBreak, timeError;
+
+    LIN.begin(baudrates[k]);
+    LIN.registerMasterRequestHandler(0x18, masterRequest, 8);
+
+    // truncated frames with 1..8 data bytes: timeout on first handler() call after TFrame_Max, then next frame is ok
+    for (uint8_t n=1; n<=8; n++)
+    {
+      timeBreak = receiveFrame(LIN, timeByte, 2 + n);
+      CHECK_EQ(LIN.getState(), (n < 8) ? LIN_Slave_Base::STATE_RECEIVING_DATA : LIN_Slave_Base::STATE_WAIT_FOR_CHK);
+      timeError = pollTimeout(LIN, timeBreak);
+      CHECK(timeError > timeFrame);
+      CHECK(timeError <= timeFrame + TIME_POLL);
+      CHECK_EQ(LIN.getState(), LIN_Slave_Base::STATE_DONE);
+
+      // recovery with next BREAK
+      LIN.resetError();
+      numRequest = 0;
+      receiveFrame(LIN, timeByte, 11);
+      CHECK_EQ(LIN.getState(), LIN_Slave_Base::STATE_DONE);
+      CHECK_EQ(LIN.getError(), LIN_Slave_Base::NO_ERROR);
+      CHECK_EQ(numRequest, 1);
+    }
+
+    // master with inter-byte space of 1 byte time: complete frame exceeds nominal TFrame_Max
+    receiveFrame(LIN, 2 * timeByte, 11);
+    CHECK(LIN.getError() & LIN_Slave_Base::ERROR_TIMEOUT);
+    LIN.resetError();
+
+    // adaptive timeout: time until PID + 1.4 * 9 measured byte periods
+    LIN.setTimeoutAdaptive(true);
+    numRequest = 0;
+    receiveFrame(LIN, 2 * timeByte, 11);
+    CHECK_EQ(LIN.getError(), LIN_Slave_Base::NO_ERROR);
+    CHECK_EQ(numRequest, 1);
+    timeBreak = receiveFrame(LIN, 2 * timeByte, 2 + 4);
+    timeError = pollTimeout(LIN, timeBreak);
+    CHECK(timeError > 2 * (2 * timeByte) + 14 * 9 * (2 * timeByte) / 10);
+    CHECK(timeError <= 2 * (2 * timeByte) + 14 * 9 * (2 * timeByte) / 10 + TIME_POLL);
+    LIN.resetError();
+    LIN.setTimeoutAdaptive(false);
+
+    LIN.end();
+  }
+
+  return TEST_RESULT();
+}
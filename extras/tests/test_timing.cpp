@@ -0,0 +1,65 @@
+/**
+  \file     test_timing.cpp
+  \brief    Host test of bit time conversion and baudrate limits
+  \details  Checks _bitsToTime() against exact values for all supported baudrates, and that baudrates below
+            LIN_SLAVE_MIN_BAUDRATE (incl. 0) are clamped in begin() and setFastMode() instead of dividing by zero
+  \author   Georg Icking-Konert
+*/
+
+// include files
+#include "test_common.h"
+
+
+/**
+  \brief  Node which exposes timing conversion
+*/
+class LIN_Slave_Timing : public LIN_Slave_Test<>
+{
+  public:
+    LIN_Slave_Timing() : LIN_Slave_Test<>("Timing") { }
+    uint32_t bitsToTime(uint16_t Bits) { return this->_bitsToTime(Bits); }
+    uint16_t timeToBits(uint32_t Time) { return LIN_Slave_Base::_timeToBits(Time); }
+};
+
+
+int main()
+{
+  LIN_Slave_Timing  LIN;
+  const uint32_t    baud[] = { 1000, 2400, 9600, 10417, 19200, 57600, 115200, 250000 };
+  const uint16_t    bits[] = { 1, 13, 14, 29, 100, 1000, 0xFFFF };
+
+  // conversion error vs. exact value: <0.5% for >=9600 Baud, else <7% (divisor baudrate/64 is truncated). Plus 1us truncation of result
+  for (uint8_t i=0; i<sizeof(baud)/sizeof(baud[0]); i++)
+  {
+    LIN.begin(baud[i]);
+    CHECK_EQ(LIN.getBaudrate(), baud[i]);
+    for (uint8_t k=0; k<sizeof(bits)/sizeof(bits[0]); k++)
+    {
+      double exact = (double) bits[k] * 1000000.0 / (double) baud[i];
+      double time  = (double) LIN.bitsToTime(bits[k]);
+      CHECK((time > exact*0.995 - 1.0) && (time < exact * ((baud[i] >= 9600) ? 1.005 : 1.07)));
+    }
+  }
+
+  // [us] at 19200 Baud -> bit times, rounded and saturated
+  CHECK_EQ(LIN.timeToBits(1500), 29);
+  CHECK_EQ(LIN.timeToBits(0), 0);
+  CHECK_EQ(LIN.timeToBits(0xFFFFFFFF), 0xFFFF);
+
+  // too low baudrates are clamped
+  LIN.begin(0);
+  CHECK_EQ(LIN.getBaudrate(), LIN_SLAVE_MIN_BAUDRATE);
+  CHECK(LIN.bitsToTime(10) > 0);
+  LIN.begin(63);
+  CHECK_EQ(LIN.getBaudrate(), LIN_SLAVE_MIN_BAUDRATE);
+  LIN.setFastMode(true, 0);
+  CHECK_EQ(LIN.getBaudrate(), LIN_SLAVE_MIN_BAUDRATE);
+  LIN.setFastMode(false);
+  CHECK_EQ(LIN.getBaudrate(), LIN_SLAVE_MIN_BAUDRATE);
+
+  // handler with clamped baudrate
+  LIN.handler();
+  CHECK_EQ(LIN.getState(), LIN_Slave_Base::STATE_WAIT_FOR_BREAK);
+
+  return TEST_RESULT();
+}
@@ -10,6 +10,13 @@
 // include files
 #include <LIN_slave_Base.h>
 
+// definition of static class variables
+LIN_SLAVE_THREAD_LOCAL LIN_Slave_Base *LIN_Slave_Base::pFirstInstance = nullptr;
+LIN_SLAVE_THREAD_LOCAL LIN_Slave_Base *LIN_Slave_Base::pNextService = nullptr;
+LIN_SLAVE_THREAD_LOCAL uint32_t LIN_Slave_Base::timeHigh = 0;
+const uint32_t LIN_Slave_Base::tableBaud[] = { LIN_SLAVE_AUTOBAUD_RATES };
+LIN_SLAVE_THREAD_LOCAL uint32_t LIN_Slave_Base::timeLow = 0;
+
 // warn if debug is active (any debug level)
 #if defined(LIN_SLAVE_DEBUG_SERIAL)
   #warning Debug interface is active, see file 'LIN_slave_Base.h'
@@ -29,18 +36,8 @@
 */
 uint8_t LIN_Slave_Base::_calculatePID(uint8_t ID)
 {
-  uint8_t  pid;       // protected frame ID
-  uint8_t  tmp;       // temporary variable for calculating parity bits
-
-  // protect ID  with parity bits
-  pid  = (uint8_t) (ID & 0x3F);                                             // clear upper bits 6 & 7
-  tmp  = (uint8_t) ((pid ^ (pid>>1) ^ (pid>>2) ^ (pid>>4)) & 0x01);         // pid[6] = PI0 = ID0^ID1^ID2^ID4
-  pid |= (uint8_t) (tmp << 6);
-  tmp  = (uint8_t) (~((pid>>1) ^ (pid>>3) ^ (pid>>4) ^ (pid>>5)) & 0x01);   // pid[7] = PI1 = ~(ID1^ID3^ID4^ID5)
-  pid |= (uint8_t) (tmp << 7);
-
-  // return protected ID
-  return pid;
+  // protect ID with parity bits via lookup table
+  return LIN_Slave_Protocol::getPID(ID);
 
 } // LIN_Slave_Base::_calculatePID()
 
@@ -51,29 +48,25 @@ uint8_t LIN_Slave_Base::_calculatePID(uint8_t ID)
   \details    Calculate LIN frame checksum as described in LIN1.x / LIN2.x specs
   \param[in]  NumData   number of data bytes in frame
   \param[in]  Data      frame data bytes
+  \param[in]  PID       protected frame ID
   \return     calculated checksum, depending on protocol version
 */
-uint8_t LIN_Slave_Base::_calculateChecksum(uint8_t NumData, uint8_t Data[])
+uint8_t LIN_Slave_Base::_calculateChecksum(uint8_t NumData, uint8_t Data[], uint8_t PID)
 {
-  uint16_t chk=0x00;
+  uint8_t chk;
 
   // LIN2.x uses extended checksum which includes protected ID, i.e. including parity bits
   // LIN1.x uses classical checksum only over data bytes
   // Diagnostic frames with ID 0x3C and 0x3D/0x7D always use classical checksum (see LIN spec "2.3.1.5 Checkum")
-  if (!((this->version == LIN_V1) || (pid == 0x3C) || (pid == 0x7D)))    // if version 2  & no diagnostic frames (0x3C=60 (PID=0x3C) or 0x3D=61 (PID=0x7D))
-    chk = (uint16_t) this->pid;
+  chk = LIN_Slave_Protocol::getSeed(PID, (this->version != LIN_Slave_Base::LIN_V1));
 
   // loop over data bytes
   for (uint8_t i = 0; i < NumData; i++)
-  {
-    chk += (uint16_t) (Data[i]);
-    if (chk>255)
-      chk -= 255;
-  }
-  chk = (uint8_t)(0xFF - ((uint8_t) chk));   // bitwise invert
+    chk = LIN_Slave_Protocol::checksumAdd(chk, Data[i]);
+  chk = (uint8_t) (~chk);   // bitwise invert
 
   // return frame checksum
-  return (uint8_t) chk;
+  return chk;
 
   // optional debug output (debug level 2)
   #if defined(LIN_SLAVE_DEBUG_SERIAL) && (LIN_SLAVE_DEBUG_LEVEL >= 2)
@@ -111,514 +104,2143 @@ void LIN_Slave_Base::_resetBreakFlag()
 
 
 
-/**************************
- * PUBLIC METHODS
-**************************/
-
 /**
-  \brief      LIN slave node constructor
-  \details    LIN slave node constructor. Initialize class variables to default values.
-              For an explanation of the LIN bus and protocol e.g. see https://en.wikipedia.org/wiki/Local_Interconnect_Network
-  \param[in]  Version     LIN protocol version (default = v2)
-  \param[in]  NameLIN     LIN node name (default = "Slave")
-  \param[in]  TimeoutRx   timeout [us] for bytes in frame (default = 1500)
-  \param[in]  PinTxEN     optional Tx enable pin (high active) e.g. for LIN via RS485 (default = -127/none)
+  \brief      Find callback for a frame ID
+  \details    Find callback for a frame ID. An attached frame table is looked up first via its index, see attachFrameTable(). For a sparse table (LIN_SLAVE_MAX_FRAMES > 0) unregistered IDs are rejected via
+              bitmap, and the index of registered IDs is the number of registered lower IDs. Runtime is constant in both cases
+  \param[in]  ID    frame ID (unprotected)
+  \return     pointer to callback, or nullptr if ID is not registered
 */
-LIN_Slave_Base::LIN_Slave_Base(LIN_Slave_Base::version_t Version, const char NameLIN[], uint32_t TimeoutRx, const int8_t PinTxEN)
+LIN_Slave_Base::callback_t *LIN_Slave_Base::_findCallback(uint8_t ID)
 {
-  // Debug serial initialized in begin() -> no debug output here
-
-  // store parameters in class variables
-  this->version = Version;                                    // LIN protocol version (required for checksum)
-  memcpy(this->nameLIN, NameLIN, LIN_SLAVE_BUFLEN_NAME);      // node name e.g. for debug
-  this->timeoutRx = TimeoutRx;                                // timeout [us] for bytes in frame
-  this->pinTxEN = PinTxEN;                                    // optional Tx enable pin for RS485
+  LIN_Slave_Base::callback_t  *pCallback;
 
-  // initialize slave node properties
-  this->state     = LIN_Slave_Base::STATE_WAIT_FOR_BREAK;     // status of LIN state machine
-  this->error     = LIN_Slave_Base::NO_ERROR;                 // last LIN error. Is latched
-  for (uint8_t i=0; i<64; i++)
+  // look up attached frame table via index by ID (built at compile time) -> one access
+  if (this->tableFrame != nullptr)
   {
-    this->callback[i].type_numData = 0x00;                    // frame type (high nibble) and number of data bytes (low nibble)
-    this->callback[i].fct = nullptr;                          // user callback functions (IDs 0x00 - 0x3F)
-  }
+    uint8_t   idx = LIN_SLAVE_PROTOCOL_READ(&(this->indexFrame->idx[ID & 0x3F]));
 
-  // initialize frame properties
-  this->pid         = 0x00;                                   // protected frame identifier
-  this->id          = 0x00;                                   // unprotected frame identifier
-  this->numData     = 0;                                      // number of data bytes in frame
-  for (uint8_t i=0; i<9; i++)
-    this->bufData[i] = 0x00;                                  // init data bytes (max 8B) + chk
-  this->idxData    = 0;                                       // current index in bufData
-  this->timeLastRx = 0;                                       // time [ms] of last received byte in frame
+    // ID found -> copy entry from flash to RAM
+    if (idx != 0xFF)
+    {
+      this->callbackTable.type_numData = LIN_SLAVE_PROTOCOL_READ(&(this->tableFrame[idx].type_numData));
+      LIN_SLAVE_PROTOCOL_COPY(&(this->callbackTable.fct), &(this->tableFrame[idx].fct), sizeof(this->callbackTable.fct));
+      return &(this->callbackTable);
+    }
+  } // frame table attached
 
-  // initialize TxEN pin low (=transmitter off)
-  if (this->pinTxEN >= 0)
-  {
-    digitalWrite(this->pinTxEN, LOW);
-    pinMode(this->pinTxEN, OUTPUT);
-  }
+  #if (LIN_SLAVE_MAX_FRAMES > 0)
+    uint8_t   bits;
 
-} // LIN_Slave_Base::LIN_Slave_Base()
+    // ID not registered -> abort
+    bits = this->maskFrame[ID >> 3];
+    if (!(bits & (uint8_t) (1 << (ID & 0x07))))
+      return nullptr;
 
+    // count registered IDs below ID within same byte (parallel bit count)
+    bits &= (uint8_t) ((1 << (ID & 0x07)) - 1);
+    bits = (uint8_t) (bits - ((bits >> 1) & 0x55));
+    bits = (uint8_t) ((bits & 0x33) + ((bits >> 2) & 0x33));
+    bits = (uint8_t) ((bits + (bits >> 4)) & 0x0F);
 
+    // index in sorted table = registered IDs in lower bytes + in same byte
+    pCallback = &(this->callback[this->rankFrame[ID >> 3] + bits]);
 
-/**
-  \brief      Open serial interface
-  \details    Open serial interface with specified baudrate. Here dummy!
-  \param[in]  Baudrate    communication speed [Baud] (default = 19200)
-*/
-void LIN_Slave_Base::begin(uint16_t Baudrate)
-{
-  // For optional debugging
-  #if defined(LIN_SLAVE_DEBUG_SERIAL)
-    LIN_SLAVE_DEBUG_SERIAL.begin(115200);
-    while (!LIN_SLAVE_DEBUG_SERIAL);
-  #endif
+  #else
+
+    // direct table access
+    pCallback = &(this->callback[ID & 0x3F]);
 
-  // print debug message (debug level 2)
-  #if defined(LIN_SLAVE_DEBUG_SERIAL) && (LIN_SLAVE_DEBUG_LEVEL >= 2)
-    LIN_SLAVE_DEBUG_SERIAL.print(this->nameLIN);
-    LIN_SLAVE_DEBUG_SERIAL.print(": LIN_Slave_Base::begin(");
-    LIN_SLAVE_DEBUG_SERIAL.print((int) Baudrate);
-    LIN_SLAVE_DEBUG_SERIAL.println(")");
   #endif
 
-  // store parameters in class variables
-  this->baudrate   = Baudrate;                                  // communication baudrate [Baud]
+  // return callback, or nullptr if none is attached
+  return (pCallback->fct != nullptr) ? pCallback : nullptr;
 
-  // initialize slave node properties
-  this->error = LIN_Slave_Base::NO_ERROR;                       // last LIN error. Is latched
-  this->state = LIN_Slave_Base::STATE_WAIT_FOR_BREAK;           // status of LIN state machine
+} // LIN_Slave_Base::_findCallback()
 
-  // initialize optional TxEN pin to low (=transmitter off)
-  if (this->pinTxEN >= 0)
+
+
+/**
+  \brief      Store callback for a frame ID
+  \details    Store callback for a frame ID. For a sparse table (LIN_SLAVE_MAX_FRAMES > 0) a new ID is inserted sorted by ID.
+              If the sparse table is full, a new ID is ignored. A missing callback is rejected, like in checkFrameTable()
+  \param[in]  ID            frame ID (unprotected)
+  \param[in]  Type_NumData  frame type (high nibble) and number of data bytes (low nibble)
+  \param[in]  Fct           user callback function
+  \return     true if callback was stored, false if Fct is nullptr or table is full
+*/
+bool LIN_Slave_Base::_storeCallback(uint8_t ID, uint8_t Type_NumData, LIN_Slave_Base::LinMessageCallback Fct)
+{
+  uint8_t   idx = ID;
+
+  // no callback -> ignore. Would be treated as unregistered ID by _findCallback(), but occupy a sparse table slot
+  if (Fct == nullptr)
   {
-    digitalWrite(this->pinTxEN, LOW);
-    pinMode(this->pinTxEN, OUTPUT);
+    // optional debug output (debug level 1)
+    #if defined(LIN_SLAVE_DEBUG_SERIAL) && (LIN_SLAVE_DEBUG_LEVEL >= 1)
+      LIN_SLAVE_DEBUG_SERIAL.print(this->nameLIN);
+      LIN_SLAVE_DEBUG_SERIAL.print(": LIN_Slave_Base::_storeCallback()");
+      LIN_SLAVE_DEBUG_SERIAL.print(": no callback, ignore ID 0x");
+      LIN_SLAVE_DEBUG_SERIAL.println(ID, HEX);
+    #endif
+
+    return false;
   }
 
-} // LIN_Slave_Base::begin()
+  #if (LIN_SLAVE_MAX_FRAMES > 0)
+
+    // get index in sorted table
+    idx = 0;
+    for (uint8_t i = 0; i < ID; i++)
+    {
+      if (this->maskFrame[i >> 3] & (uint8_t) (1 << (i & 0x07)))
+        idx++;
+    }
 
+    // new ID -> insert into table
+    if (!(this->maskFrame[ID >> 3] & (uint8_t) (1 << (ID & 0x07))))
+    {
+      // table is full -> ignore
+      if (this->numFrames >= LIN_SLAVE_MAX_FRAMES)
+      {
+        // optional debug output (debug level 1)
+        #if defined(LIN_SLAVE_DEBUG_SERIAL) && (LIN_SLAVE_DEBUG_LEVEL >= 1)
+          LIN_SLAVE_DEBUG_SERIAL.print(this->nameLIN);
+          LIN_SLAVE_DEBUG_SERIAL.print(": LIN_Slave_Base::_storeCallback()");
+          LIN_SLAVE_DEBUG_SERIAL.print(": table full, ignore ID 0x");
+          LIN_SLAVE_DEBUG_SERIAL.println(ID, HEX);
+        #endif
 
+        return false;
+      }
+
+      // shift callbacks of higher IDs up by one
+      memmove(&(this->callback[idx+1]), &(this->callback[idx]), (this->numFrames - idx) * sizeof(LIN_Slave_Base::callback_t));
+      (this->numFrames)++;
+
+      // mark ID as registered and update ranks of higher bytes
+      this->maskFrame[ID >> 3] |= (uint8_t) (1 << (ID & 0x07));
+      for (uint8_t i = (ID >> 3) + 1; i < 8; i++)
+        (this->rankFrame[i])++;
+
+    } // new ID
 
-/**
-  \brief      Close serial interface
-  \details    Close serial interface. Here dummy!
-*/
-void LIN_Slave_Base::end()
-{
-  // optional debug output (debug level 2)
-  #if defined(LIN_SLAVE_DEBUG_SERIAL) && (LIN_SLAVE_DEBUG_LEVEL >= 2)
-    LIN_SLAVE_DEBUG_SERIAL.print(this->nameLIN);
-    LIN_SLAVE_DEBUG_SERIAL.println(": LIN_Slave_Base::end()");
   #endif
 
-  // set slave node properties
-  this->error = LIN_Slave_Base::NO_ERROR;                     // last LIN error. Is latched
-  this->state = LIN_Slave_Base::STATE_OFF;                    // status of LIN state machine
+  // store callback
+  this->callback[idx].type_numData = Type_NumData;
+  this->callback[idx].fct = Fct;
 
-  // optionally disable RS485 transmitter
-  _disableTransmitter();
+  // callback was stored
+  return true;
 
-} // LIN_Slave_Base::end()
+} // LIN_Slave_Base::_storeCallback()
 
 
 
-/**
-  \brief      Attach user callback function for master request frame
-  \details    Attach user callback function for master request frame. Callback functions are called by handler() after reception of a master request frame
-  \param[in]  ID        frame ID (protected or unprotected)
-  \param[in]  Fct       user callback function
-  \param[in]  NumData   number of frame data bytes
-*/
-void LIN_Slave_Base::registerMasterRequestHandler(uint8_t ID, LIN_Slave_Base::LinMessageCallback Fct, uint8_t NumData)
-{  
-  // drop parity bits -> non-protected ID = 0..63
-  ID &= 0x3F;
+#if (LIN_SLAVE_NUM_RESPONSES > 0)
+  /**
+    \brief      Find slot of pre-published slave response
+    \details    Find slot of pre-published slave response for frame ID
+    \param[in]  ID    frame ID (unprotected)
+    \return     index in response[], or LIN_SLAVE_NUM_RESPONSES if not published
+  */
+  uint8_t LIN_Slave_Base::_findResponse(uint8_t ID)
+  {
+    uint8_t   idx;
 
-  // register user callback function for master request frame
-  this->callback[ID].type_numData = LIN_Slave_Base::MASTER_REQUEST | (NumData & 0x0F);
-  this->callback[ID].fct = Fct;
+    // search published responses
+    for (idx = 0; idx < LIN_SLAVE_NUM_RESPONSES; idx++)
+    {
+      if (this->response[idx].id == ID)
+        break;
+    }
 
-  // optional debug output (debug level 2)
-  #if defined(LIN_SLAVE_DEBUG_SERIAL) && (LIN_SLAVE_DEBUG_LEVEL >= 2)
-    LIN_SLAVE_DEBUG_SERIAL.print(this->nameLIN);
-    LIN_SLAVE_DEBUG_SERIAL.print(": LIN_Slave_Base::registerMasterRequestHandler()");
-    LIN_SLAVE_DEBUG_SERIAL.print(": registered ID 0x");
-    LIN_SLAVE_DEBUG_SERIAL.println(ID, HEX);
-  #endif
+    // return index or LIN_SLAVE_NUM_RESPONSES if not found
+    return idx;
 
-} // LIN_Slave_Base::registerMasterRequestHandler
+  } // LIN_Slave_Base::_findResponse()
+#endif
 
 
 
 /**
-  \brief      Attach user callback function for slave response frame
-  \details    Attach user callback function for slave response frame. Callback functions are called by handler() after reception of a PID
-  \param[in]  ID        frame ID (protected or unprotected)
-  \param[in]  Fct       user callback function
-  \param[in]  NumData   number of frame data bytes
+  \brief      Copy current frame to frame record
+  \details    Copy properties, data, errors and timestamps of current frame to a frame record
+  \param[out] Record    frame record
 */
-void LIN_Slave_Base::registerSlaveResponseHandler(uint8_t ID, LIN_Slave_Base::LinMessageCallback Fct, uint8_t NumData)
+void LIN_Slave_Base::_getRecord(LIN_Slave_Base::frame_record_t &Record)
 {
-  // drop parity bits -> non-protected ID = 0..63
-  ID &= 0x3F;
-
-  // register user callback function for slave response frame
-  this->callback[ID].type_numData = LIN_Slave_Base::SLAVE_RESPONSE | (NumData & 0x0F);
-  this->callback[ID].fct = Fct;
-
-  // optional debug output (debug level 2)
-  #if defined(LIN_SLAVE_DEBUG_SERIAL) && (LIN_SLAVE_DEBUG_LEVEL >= 2)
-    LIN_SLAVE_DEBUG_SERIAL.print(this->nameLIN);
-    LIN_SLAVE_DEBUG_SERIAL.print(": LIN_Slave_Base::registerSlaveResponseHandler()");
-    LIN_SLAVE_DEBUG_SERIAL.print(": registered ID 0x");
-    LIN_SLAVE_DEBUG_SERIAL.println(ID, HEX);
-  #endif
+  Record.id        = this->id;
+  Record.type      = this->type;
+  Record.numData   = this->numData;
+  memcpy(Record.data, this->bufData, this->numData);
+  Record.error     = this->errorFrame;
+  Record.timeStart = LIN_Slave_Base::_toMicros64(this->timeFrameStart);
+  Record.timePID   = LIN_Slave_Base::_toMicros64(this->timePID);
+  Record.timeEnd   = LIN_Slave_Base::_toMicros64(this->timeLastRx);
 
-} // LIN_Slave_Base::registerSlaveResponseHandler
+} // LIN_Slave_Base::_getRecord()
 
 
 
 /**
-  \brief      Handle LIN protocol and call user-defined frame callback functions
-  \details    Handle LIN protocol and call user-defined frame callback functions, both for slave request and slave response frames
+  \brief      Store completed frame in queue
+  \details    Store completed frame incl. errors and timestamps in queue of completed frames (single producer).
+              If queue is full, either the new frame is dropped, or the oldest unread frame is overwritten, depending on setQueuePolicy().
+              The read index is never modified here, so readFrame() requires no interrupt lock. A sequence number per record
+              lets readFrame() detect a record overwritten during copy, also after the write index was rewound for a stalled reader
 */
-void LIN_Slave_Base::handler()
+void LIN_Slave_Base::_pushFrame()
 {
-  uint8_t   chk_calc;
+  // optionally update traffic and error counters of frame ID
+  this->_countFrame();
 
-  // on receive timeout [us] within frame reset state machine
-  if (!(this->state | (LIN_Slave_Base::STATE_OFF | LIN_Slave_Base::STATE_WAIT_FOR_BREAK | LIN_Slave_Base::STATE_DONE)) && 
-    ((micros() - this->timeLastRx) > this->timeoutRx))
-  {
-    // set error and abort frame
-    this->error = (LIN_Slave_Base::error_t) ((int) this->error | (int) LIN_Slave_Base::ERROR_TIMEOUT);
-    this->state = LIN_Slave_Base::STATE_DONE;
+  #if (LIN_SLAVE_FRAME_QUEUE > 0)
+    uint8_t                         head = this->queueHead;
+    uint8_t                         used = (uint8_t) (head - this->queueTail);
+    uint8_t                         idx;
+    LIN_Slave_Base::frame_record_t  *pRecord;
 
-    // flush receive buffer
-    while (this->available())
-      this->_serialRead();
+    // queue is full -> count lost frame and drop new frame or overwrite oldest
+    if (used >= LIN_SLAVE_FRAME_QUEUE - ((this->queuePolicy == LIN_Slave_Base::QUEUE_OVERWRITE_OLD) ? 1 : 0))
+    {
+      if (this->queueOverflow < 0xFFFF)
+        this->queueOverflow = this->queueOverflow + 1;
+      if (this->queuePolicy == LIN_Slave_Base::QUEUE_DROP_NEW)
+        return;
+
+      // reader is stalled -> keep distance to read index <2*depth to avoid index wrap-around. Same slot due to power of 2
+      if (used >= 2*LIN_SLAVE_FRAME_QUEUE)
+        head -= LIN_SLAVE_FRAME_QUEUE;
+    }
+
+    // fill record. Odd sequence number marks record as being written, e.g. on overwrite while readFrame() copies it
+    idx = head & (LIN_SLAVE_FRAME_QUEUE-1);
+    pRecord = &(this->queue[idx]);
+    this->queueSeq[idx] = this->queueSeq[idx] + 1;
+    LIN_SLAVE_BARRIER();
+    this->_getRecord(*pRecord);
+    LIN_SLAVE_BARRIER();
+    this->queueSeq[idx] = this->queueSeq[idx] + 1;
+
+    // publish record (atomic byte write)
+    this->queueHead = head + 1;
+  #endif
 
-    // optionally disable RS485 transmitter
-    _disableTransmitter();
+} // LIN_Slave_Base::_pushFrame()
 
-    // optional debug output (debug level 1)
-    #if defined(LIN_SLAVE_DEBUG_SERIAL) && (LIN_SLAVE_DEBUG_LEVEL >= 1)
-      LIN_SLAVE_DEBUG_SERIAL.print(this->nameLIN);
-      LIN_SLAVE_DEBUG_SERIAL.print(": LIN_Slave_Base::handler()");
-      LIN_SLAVE_DEBUG_SERIAL.print(": error: frame timeout after ");
-      LIN_SLAVE_DEBUG_SERIAL.print((long) (micros() - this->timeLastRx));
-      LIN_SLAVE_DEBUG_SERIAL.println("us");
-    #endif
 
-  } // if frame receive timeout
 
+/**
+  \brief      Get max. frame duration
+  \details    Get max. frame duration TFrame_Max = 1.4 * TFrame_Nominal (see LIN2.x spec "2.3.2 Frame slot"), 
+              with TFrame_Nominal = 34 bits for header + 10 bits per byte in response
+  \param[in]  NumBytes   number of bytes in response, incl. checksum (0 = header only)
+  \return     max. frame duration [us] at current baudrate
+*/
+uint32_t LIN_Slave_Base::_getFrameTimeMax(uint8_t NumBytes)
+{
+  // 1.4 * bits * 1e6us / baudrate. Max. 124 bits -> no overflow
+  return (uint32_t) (34 + 10 * (uint16_t) NumBytes) * 1400000L / this->baudrate;
 
-  // detected LIN BREAK (=0x00 with framing error or inter-frame pause detected)
-  // Note: received BREAK byte is consumed by child class to support also sync on SYNC byte. 
-  if (this->_getBreakFlag() == true)
-  {
-    // clear BREAK flag again
-    this->_resetBreakFlag();
-    
-    // start frame reception. Note: 0x00 already checked by derived class
-    this->state = LIN_Slave_Base::STATE_WAIT_FOR_SYNC;
+} // LIN_Slave_Base::_getFrameTimeMax()
 
-    // optionally disable RS485 transmitter
-    _disableTransmitter();
 
-    // optional debug output (debug level 3)
-    #if defined(LIN_SLAVE_DEBUG_SERIAL) && (LIN_SLAVE_DEBUG_LEVEL >= 3)
-      LIN_SLAVE_DEBUG_SERIAL.print(this->nameLIN);
-      LIN_SLAVE_DEBUG_SERIAL.print(": LIN_Slave_Base::handler()");
-      LIN_SLAVE_DEBUG_SERIAL.println(": BREAK detected ");
-    #endif
 
-  } // if BREAK detected
+/**
+  \brief      Set timeout for current frame
+  \details    Set timeout for current frame after PID reception, i.e. when the number of data bytes is known.
+              Optionally adapt to measured byte period of master (SYNC -> PID), see setTimeoutAdaptive()
+*/
+void LIN_Slave_Base::_setFrameTimeout()
+{
+  uint32_t  timeByte, timeoutAdapt;
 
+  // nominal max. frame duration
+  this->timeoutFrame = this->_getFrameTimeMax(this->numData+1);
 
-  // A byte was received -> handle it
-  if (this->available())
+  // optionally extend timeout by measured byte period of master (incl. inter-byte space)
+  if (this->flagTimeoutAdaptive == true)
   {
-    // read received byte and reset timeout timer
-    uint8_t byteReceived = this->_serialRead();
-    this->timeLastRx = micros();
+    // clip measured byte period to [1..2] nominal byte periods to limit effect of handler latency
+    timeByte = this->timeLastRx - this->timeSync;
+    if (timeByte < this->timeByteNom)
+      timeByte = this->timeByteNom;
+    else if (timeByte > 2 * (uint32_t) this->timeByteNom)
+      timeByte = 2 * (uint32_t) this->timeByteNom;
+
+    // measured time until PID + 1.4 * (data + checksum) measured byte periods
+    timeoutAdapt = (this->timeLastRx - this->timeFrameStart) + (14 * (uint32_t) (this->numData+1) * timeByte) / 10;
+    if (timeoutAdapt > this->timeoutFrame)
+      this->timeoutFrame = timeoutAdapt;
+  }
 
-    // optional debug output (debug level 3)
-    #if defined(LIN_SLAVE_DEBUG_SERIAL) && (LIN_SLAVE_DEBUG_LEVEL >= 3)
-      LIN_SLAVE_DEBUG_SERIAL.print(this->nameLIN);
-      LIN_SLAVE_DEBUG_SERIAL.print(": LIN_Slave_Base::handler()");
-      if (this->_getBreakFlag() == true)
-        LIN_SLAVE_DEBUG_SERIAL.print(": BRK, Rx=0x");
-      else
-        LIN_SLAVE_DEBUG_SERIAL.print(": Rx=0x");
-      LIN_SLAVE_DEBUG_SERIAL.println(byteReceived, HEX);
-    #endif
+} // LIN_Slave_Base::_setFrameTimeout()
 
-    // handle byte
-    switch (this->state)
-    {
-      // LIN interface disabled, do nothing
-      case LIN_Slave_Base::STATE_OFF:
-        break;
 
-      // just to avoid compiler warning, do nothing. Break state is handled above
-      case LIN_Slave_Base::STATE_WAIT_FOR_BREAK:
-        break;
-      
-      // master request frame is finished, do nothing
-      case LIN_Slave_Base::STATE_DONE:
-        break;
 
-      // break has been received, waiting for sync field
-      case LIN_Slave_Base::STATE_WAIT_FOR_SYNC:
-        
-        // valid SYNC (=0x55) -> wait for ID
-        if (byteReceived == 0x55)
-        {
-          this->idxData = 0;
-          this->state = LIN_Slave_Base::STATE_WAIT_FOR_PID;
-        } 
+/**
+  \brief      Evaluate captured frame in monitor mode
+  \details    Evaluate frame with unknown length at frame end, i.e. on next BREAK, timeout or max. length. Length is inferred from
+              the number of received bytes, or if the checksum doesn't match, from the LIN1.x ID-encoded length (2/4/8 bytes).
+              A length is valid if the byte after the data matches the enhanced or classic checksum, which was checked
+              on reception (see _monitorByte()), so this has constant runtime. Frame is stored in queue and passed to monitor callback
+*/
+void LIN_Slave_Base::_monitorFrame()
+{
+  uint8_t                       numBytes = this->idxData;     // received data bytes + checksum
+  uint8_t                       len[2];
+  LIN_Slave_Base::frame_t       typeFrame = (LIN_Slave_Base::frame_t) 0;
+  LIN_Slave_Base::frame_record_t  record;
 
-        // invalid SYNC (!=0x55) -> error
-        else
-        {
-          // set error and abort frame
-          this->error = (LIN_Slave_Base::error_t) ((int) this->error | (int) LIN_Slave_Base::ERROR_SYNC);
-          this->state = LIN_Slave_Base::STATE_DONE;
+  // candidate lengths: all received bytes, LIN1.x ID-encoded length
+  len[0] = (numBytes > 0) ? numBytes - 1 : 0;
+  len[1] = (this->id < 0x20) ? 2 : ((this->id < 0x30) ? 4 : 8);
 
-          // optionally disable RS485 transmitter
-          _disableTransmitter();
+  // check candidates. For diagnostic frames 0x3C/0x3D both checksums are equal -> classic
+  for (uint8_t i=0; (i < 2) && (typeFrame == 0); i++)
+  {
+    if ((len[i] < 1) || (len[i] >= numBytes))
+      continue;
+    if (this->maskClassic & (0x01 << len[i]))
+      typeFrame = LIN_Slave_Base::MONITOR_CLASSIC;
+    else if (this->maskEnhanced & (0x01 << len[i]))
+      typeFrame = LIN_Slave_Base::MONITOR_ENHANCED;
+    if (typeFrame != 0)
+      this->numData = len[i];
+  }
 
-          // optional debug output (debug level 1)
-          #if defined(LIN_SLAVE_DEBUG_SERIAL) && (LIN_SLAVE_DEBUG_LEVEL >= 1)
-            LIN_SLAVE_DEBUG_SERIAL.print(this->nameLIN);
-            LIN_SLAVE_DEBUG_SERIAL.print(": LIN_Slave_Base::handler()");
-            LIN_SLAVE_DEBUG_SERIAL.print(": SYNC error, received 0x");
-            LIN_SLAVE_DEBUG_SERIAL.println(byteReceived, HEX);
-          #endif
+  // no response (header only) or no matching checksum -> set error
+  if (typeFrame == 0)
+  {
+    this->numData = len[0];
+    typeFrame = (this->version == LIN_Slave_Base::LIN_V1) ? LIN_Slave_Base::MONITOR_CLASSIC : LIN_Slave_Base::MONITOR_ENHANCED;
+    this->_setError((numBytes == 0) ? LIN_Slave_Base::ERROR_TIMEOUT : LIN_Slave_Base::ERROR_CHK);
+  }
+  this->type  = typeFrame;
+  this->state = LIN_Slave_Base::STATE_DONE;
 
-        } // invalid SYNC
+  // store frame in queue and optionally log it
+  this->_pushFrame();
+  this->_log((this->errorFrame == LIN_Slave_Base::NO_ERROR) ? LIN_Slave_Base::LOG_FRAME_OK : LIN_Slave_Base::LOG_CHK_ERROR,
+    this->numData, this->timeLastRx);
 
-        break; // STATE_WAIT_FOR_SYNC
+  // optionally call user monitor callback
+  if (this->fctMonitor != nullptr)
+  {
+    this->_getRecord(record);
+    this->fctMonitor(record);
+  }
 
+  // optional debug output (debug level 2)
+  #if defined(LIN_SLAVE_DEBUG_SERIAL) && (LIN_SLAVE_DEBUG_LEVEL >= 2)
+    LIN_SLAVE_DEBUG_SERIAL.print(this->nameLIN);
+    LIN_SLAVE_DEBUG_SERIAL.print(": LIN_Slave_Base::_monitorFrame()");
+    LIN_SLAVE_DEBUG_SERIAL.print(": ID 0x");
+    LIN_SLAVE_DEBUG_SERIAL.print(this->id, HEX);
+    LIN_SLAVE_DEBUG_SERIAL.print(", length ");
+    LIN_SLAVE_DEBUG_SERIAL.print(this->numData);
+    LIN_SLAVE_DEBUG_SERIAL.print(", error 0x");
+    LIN_SLAVE_DEBUG_SERIAL.println(this->errorFrame, HEX);
+  #endif
 
-      // sync field has been received, waiting for protected ID
-      case LIN_Slave_Base::STATE_WAIT_FOR_PID:
+} // LIN_Slave_Base::_monitorFrame()
 
-        this->pid = byteReceived;          // received (protected) ID
-        this->id  = byteReceived & 0x3F;   // extract ID, drop parity bits
 
-        // check PID parity bits 7+8
-        if (this->pid != this->_calculatePID(this->id))
-        {
-          // set error and abort frame
-          this->error = (LIN_Slave_Base::error_t) ((int) this->error | (int) LIN_Slave_Base::ERROR_PID);
-          this->state = LIN_Slave_Base::STATE_DONE;
-
-          // optionally disable RS485 transmitter
-          _disableTransmitter();
-
-          // optional debug output (debug level 1)
-          #if defined(LIN_SLAVE_DEBUG_SERIAL) && (LIN_SLAVE_DEBUG_LEVEL >= 1)
-            LIN_SLAVE_DEBUG_SERIAL.print(this->nameLIN);
-            LIN_SLAVE_DEBUG_SERIAL.print(": LIN_Slave_Base::handler()");
-            LIN_SLAVE_DEBUG_SERIAL.print(": PID parity error, received 0x");
-            LIN_SLAVE_DEBUG_SERIAL.print(this->pid, HEX);
-            LIN_SLAVE_DEBUG_SERIAL.print(", calculated 0x");
-            LIN_SLAVE_DEBUG_SERIAL.println(this->_calculatePID(this->id), HEX);
-          #endif
-          
-        } // PID error
-
-        // if slave response ID is registered, call callback function and send response
-        else if ((this->callback[id].fct != nullptr) && (this->callback[id].type_numData & LIN_Slave_Base::SLAVE_RESPONSE))
-        {
-          // get type (high nibble) and number of response bytes (low nibble) from callback array
-          this->type = (LIN_Slave_Base::frame_t) (this->callback[id].type_numData & 0xF0);
-          this->numData = this->callback[id].type_numData & 0x0F;
-          
-          // call the user-defined callback function for this ID
-          this->callback[id].fct(numData, this->bufData);
 
-          // attach frame checksum
-          bufData[numData] = this->_calculateChecksum(this->numData, this->bufData);
+/**
+  \brief      Handle a received BREAK
+  \details    Handle a received BREAK, i.e. start reception of a new frame. Is called by handler() or directly from a receive ISR.
+              Note: BREAK detection (e.g. 0x00 with framing error) is done by derived class
+  \param[in]  TimeBreak   time [us] of BREAK reception, e.g. captured in receive ISR
+*/
+void LIN_Slave_Base::_handleBreak(uint32_t TimeBreak)
+{
+  // monitor mode: BREAK terminates previous frame with unknown length
+  if ((this->flagMonitor) && (this->state == LIN_Slave_Base::STATE_RECEIVING_DATA))
+    this->_monitorFrame();
+
+  // start frame reception. Note: 0x00 already checked by derived class
+  this->state = LIN_Slave_Base::STATE_WAIT_FOR_SYNC;
+  this->errorFrame = LIN_Slave_Base::NO_ERROR;
+  this->timeFrameStart = TimeBreak;
+  this->timeLastRx = TimeBreak;
+  this->timePID = TimeBreak;
+  this->scoreBreak = 0;
+  this->scoreResync = 0;
+
+  // optionally count and log BREAKs
+  #if defined(LIN_SLAVE_ID_COUNTERS)
+    LIN_Slave_Base::_countInc(this->counterBus.breaks, 1);
+  #endif
+  this->_log(LIN_Slave_Base::LOG_BREAK, 0x00, TimeBreak);
 
-          // optionally enable RS485 transmitter
-          _enableTransmitter();
+  // frame length is not yet known -> timeout for frame header
+  this->timeoutFrame = this->_getFrameTimeMax(0);
 
-          // send slave response (data+chk)
-          this->_serialWrite(bufData, numData+1);
+  // optionally disable RS485 transmitter
+  _disableTransmitter();
 
-          // advance state to receiving echo
-          this->state = LIN_Slave_Base::STATE_RECEIVING_ECHO;
+  // optional debug output (debug level 3)
+  #if defined(LIN_SLAVE_DEBUG_SERIAL) && (LIN_SLAVE_DEBUG_LEVEL >= 3)
+    LIN_SLAVE_DEBUG_SERIAL.print(this->nameLIN);
+    LIN_SLAVE_DEBUG_SERIAL.print(": LIN_Slave_Base::_handleBreak()");
+    LIN_SLAVE_DEBUG_SERIAL.println(": BREAK detected ");
+  #endif
 
-          // optional debug output (debug level 2)
-          #if defined(LIN_SLAVE_DEBUG_SERIAL) && (LIN_SLAVE_DEBUG_LEVEL >= 2)
-            LIN_SLAVE_DEBUG_SERIAL.print(this->nameLIN);
-            LIN_SLAVE_DEBUG_SERIAL.print(": LIN_Slave_Base::handler()");
-            LIN_SLAVE_DEBUG_SERIAL.print(": handle slave response PID 0x");
-            LIN_SLAVE_DEBUG_SERIAL.println(this->pid, HEX);
-          #endif
+} // LIN_Slave_Base::_handleBreak()
 
-        } // if slave response frame
-        
-        // if master request ID is registered, get number of data bytes and advance state
-        else if ((this->callback[id].fct != nullptr) && (this->callback[id].type_numData & LIN_Slave_Base::MASTER_REQUEST))
-        {
-          // get type (high nibble) and number of response bytes (low nibble) from callback array
-          this->type = (LIN_Slave_Base::frame_t) (this->callback[id].type_numData & 0xF0);
-          this->numData = this->callback[id].type_numData & 0x0F;
-          
-          // advance state to receiving data
-          this->state = LIN_Slave_Base::STATE_RECEIVING_DATA;
-        
-        } // if master request frame 
-          
-        // ID is not registered -> wait for next break
-        else
-        {
-          // optional debug output (debug level 2)
-          #if defined(LIN_SLAVE_DEBUG_SERIAL) && (LIN_SLAVE_DEBUG_LEVEL >= 2)
-            LIN_SLAVE_DEBUG_SERIAL.print(this->nameLIN);
-            LIN_SLAVE_DEBUG_SERIAL.print(": LIN_Slave_Base::handler()");
-            LIN_SLAVE_DEBUG_SERIAL.print(": drop frame PID 0x");
-            LIN_SLAVE_DEBUG_SERIAL.println(this->pid, HEX);
-          #endif
-
-          // reset state machine
-          this->state = LIN_Slave_Base::STATE_WAIT_FOR_BREAK;
 
-        } // if frame not registered
 
-        break; // STATE_WAIT_FOR_PID
+/**
+  \brief      Check a byte outside a frame for a frame header without BREAK
+  \details    Check a byte received outside a frame (STATE_WAIT_FOR_BREAK) for a frame header without detected BREAK,
+              e.g. if the BREAK was missed due to noise or after a corrupted SYNC or PID. Evidence is scored: a pause before the byte
+              (see LIN_SLAVE_RESYNC_PAUSE) scores 1, a BREAK-like 0x00 scores 1 for the next byte, and a 0x55 (SYNC) scores 2.
+              If a 0x55 reaches LIN_SLAVE_RESYNC_SCORE, a frame header is started and confirmed by a valid PID, else discarded
+              silently. Not called in STATE_DONE, as this would discard a frame not yet fetched via getFrame().
+              Is called by _handleByte(), i.e. has constant runtime
+  \param[in]  byteReceived   received byte
+  \param[in]  TimeReceived   time [us] of byte reception
+  \param[in]  TimeGap        time [us] since previous byte or BREAK
+*/
+void LIN_Slave_Base::_resyncByte(uint8_t byteReceived, uint32_t TimeReceived, uint32_t TimeGap)
+{
+  uint8_t   score;
 
+  // pause before this byte is evidence for a new frame
+  score = (TimeGap >= this->timePauseResync) ? 1 : 0;
 
-      // receive master request data
-      case LIN_Slave_Base::STATE_RECEIVING_DATA:
+  // BREAK-like 0x00 without framing error -> store evidence for following SYNC
+  if (byteReceived == 0x00)
+  {
+    this->scoreBreak = score + 1;
+    this->timeResync = TimeReceived;
+    return;
+  }
 
-        // check received data
-        this->bufData[(this->idxData)++] = byteReceived;
-        
-        // if data is finished, advance to checksum check
-        if (this->idxData >= this->numData)
-          this->state = LIN_Slave_Base::STATE_WAIT_FOR_CHK;
+  // SYNC with sufficient evidence -> start frame header. Frame start is BREAK candidate, if any
+  score += this->scoreBreak + 2;
+  if ((byteReceived == 0x55) && (score >= LIN_SLAVE_RESYNC_SCORE))
+  {
+    this->state = LIN_Slave_Base::STATE_WAIT_FOR_PID;
+    this->errorFrame = LIN_Slave_Base::NO_ERROR;
+    this->timeFrameStart = (this->scoreBreak != 0) ? this->timeResync : TimeReceived;
+    this->timeSync = TimeReceived;
+    this->timePID = TimeReceived;
+    this->idxData = 0;
+    this->scoreResync = score;
 
-        break; // STATE_RECEIVING_DATA
+    // frame length is not yet known -> timeout for frame header
+    this->timeoutFrame = this->_getFrameTimeMax(0);
 
+    // optional debug output (debug level 3)
+    #if defined(LIN_SLAVE_DEBUG_SERIAL) && (LIN_SLAVE_DEBUG_LEVEL >= 3)
+      LIN_SLAVE_DEBUG_SERIAL.print(this->nameLIN);
+      LIN_SLAVE_DEBUG_SERIAL.print(": LIN_Slave_Base::_resyncByte()");
+      LIN_SLAVE_DEBUG_SERIAL.print(": SYNC candidate, score ");
+      LIN_SLAVE_DEBUG_SERIAL.println(score);
+    #endif
+  }
 
-      // receive slave response echo
-      case LIN_Slave_Base::STATE_RECEIVING_ECHO:
+  // no BREAK candidate for next byte
+  this->scoreBreak = 0;
 
-        // compare received echo to sent data
-        if (this->bufData[(this->idxData)++] != byteReceived)
-        {
-          // set error and abort frame
-          this->error = (LIN_Slave_Base::error_t) ((int) this->error | (int) LIN_Slave_Base::ERROR_ECHO);
-          this->state = LIN_Slave_Base::STATE_DONE;
-
-          // optionally disable RS485 transmitter
-          _disableTransmitter();
-
-          // optional debug output (debug level 1)
-          #if defined(LIN_SLAVE_DEBUG_SERIAL) && (LIN_SLAVE_DEBUG_LEVEL >= 1)
-            LIN_SLAVE_DEBUG_SERIAL.print(this->nameLIN);
-            LIN_SLAVE_DEBUG_SERIAL.print(": LIN_Slave_Base::handler()");
-            LIN_SLAVE_DEBUG_SERIAL.print(": echo error, received 0x");
-            LIN_SLAVE_DEBUG_SERIAL.print(byteReceived, HEX);
-            LIN_SLAVE_DEBUG_SERIAL.print(", expected 0x");
-            LIN_SLAVE_DEBUG_SERIAL.println(this->bufData[(this->idxData)-1], HEX);
-          #endif
-
-        } // if echo error
-
-        // if data is finished, finish frame
-        else if (this->idxData >= this->numData+1)
-        {
-          this->state = LIN_Slave_Base::STATE_DONE;
+} // LIN_Slave_Base::_resyncByte()
 
-          // optionally disable RS485 transmitter
-          _disableTransmitter();
-        }
 
-        break; // STATE_RECEIVING_ECHO
 
+/**
+  \brief      Handle a received byte
+  \details    Handle a received byte in LIN state machine and call user-defined frame callback functions.
+              Is called by handler() or directly from a receive ISR. The latter requires that all callback functions are ISR-safe.
+              Runtime per byte is bounded: besides the optional user callback, max. 8 bytes are summed (checksum of slave response
+              via callback, master request checksum is accumulated per byte), max. 9 bytes are copied and written to the Tx buffer
+              (slave response), and at frame end one record is stored in the frame queue and one log entry is written.
+              Measured max. median per byte on host x86-64 with all options (lin_bench): 38ns static, 49ns virtual binding
+  \param[in]  byteReceived   received byte
+  \param[in]  TimeReceived   time [us] of byte reception, e.g. captured in receive ISR
+*/
+void LIN_Slave_Base::_handleByte(uint8_t byteReceived, uint32_t TimeReceived)
+{
+  LIN_Slave_Base::callback_t  *pCallback;
+  uint32_t                    timeEntry = this->_statTime();  // only used for optional statistics
+  uint32_t                    timeStat;
+  uint32_t                    timeGap = TimeReceived - this->timeLastRx;
+  #if (LIN_SLAVE_NUM_RESPONSES > 0)
+    uint8_t   idxResponse;
+  #endif
 
-      // Data has been received for master request frame, waiting for checksum
-      case LIN_Slave_Base::STATE_WAIT_FOR_CHK:
+  // optional statistics: gap to previous byte (or BREAK) within frame
+  if (this->state & (LIN_Slave_Base::STATE_WAIT_FOR_SYNC | LIN_Slave_Base::STATE_WAIT_FOR_PID | LIN_Slave_Base::STATE_RECEIVING_DATA |
+    LIN_Slave_Base::STATE_RECEIVING_ECHO | LIN_Slave_Base::STATE_WAIT_FOR_CHK))
+    this->_statAdd(LIN_Slave_Base::STAT_GAP, timeGap);
 
-        // calculate checksum for master request frame
-        chk_calc = this->_calculateChecksum(this->numData, this->bufData);
-        
-        // Checksum valid -> call user-defined callback function for this ID
-        if (byteReceived == chk_calc)
-        {
-          // call user-defined master request callback function. Only reachable if callback has been registered
-          this->callback[id].fct(numData, bufData);
-
-          // optional debug output (debug level 2)
-          #if defined(LIN_SLAVE_DEBUG_SERIAL) && (LIN_SLAVE_DEBUG_LEVEL >= 2)
-            LIN_SLAVE_DEBUG_SERIAL.print(this->nameLIN);
-            LIN_SLAVE_DEBUG_SERIAL.print(": LIN_Slave_Base::handler()");
-            LIN_SLAVE_DEBUG_SERIAL.print(": handle master request PID 0x");
-            LIN_SLAVE_DEBUG_SERIAL.println(this->pid, HEX);
-          #endif
-
-        } // if checksum ok
-        
-        // checksum error
-        else
-        {
-          // set error
-          this->error = (LIN_Slave_Base::error_t) ((int) this->error | (int) LIN_Slave_Base::ERROR_CHK);
-
-          // optional debug output (debug level 1)
-          #if defined(LIN_SLAVE_DEBUG_SERIAL) && (LIN_SLAVE_DEBUG_LEVEL >= 1)
-            LIN_SLAVE_DEBUG_SERIAL.print(this->nameLIN);
-            LIN_SLAVE_DEBUG_SERIAL.print(": LIN_Slave_Base::handler()");
-            LIN_SLAVE_DEBUG_SERIAL.print(": CHK error, received 0x");
-            LIN_SLAVE_DEBUG_SERIAL.print(byteReceived, HEX);
-            LIN_SLAVE_DEBUG_SERIAL.print(", calculated 0x");
-            LIN_SLAVE_DEBUG_SERIAL.println(chk_calc, HEX);
-          #endif
-
-        } // if checksum error
-
-        // frame is finished
-        this->state = LIN_Slave_Base::STATE_DONE;
+  // reset timeout timer
+  this->timeLastRx = TimeReceived;
 
-        // optionally disable RS485 transmitter
-        _disableTransmitter();
+  // optionally count received bytes
+  #if defined(LIN_SLAVE_ID_COUNTERS)
+    (this->counterBus.bytes)++;
+  #endif
 
-        break; // STATE_WAIT_FOR_CHK
+  // handle byte
+  switch (this->state)
+  {
+    // LIN interface disabled, do nothing
+    case LIN_Slave_Base::STATE_OFF:
+      break;
 
+    // no frame ongoing. Break is handled in _handleBreak(), here check for frame header without BREAK
+    case LIN_Slave_Base::STATE_WAIT_FOR_BREAK:
+      this->_resyncByte(byteReceived, TimeReceived, timeGap);
+      break;
 
-      // this should never happen -> error
-      default:
+    // frame is finished but not yet fetched via getFrame() -> keep frame, ignore bytes until BREAK or resetStateMachine()
+    case LIN_Slave_Base::STATE_DONE:
+      break;
 
+    // break has been received, waiting for sync field
+    case LIN_Slave_Base::STATE_WAIT_FOR_SYNC:
+      
+      // valid SYNC (=0x55) -> wait for ID
+      if (byteReceived == 0x55)
+      {
+        this->idxData = 0;
+        this->timeSync = this->timeLastRx;
+        this->state = LIN_Slave_Base::STATE_WAIT_FOR_PID;
+      } 
+
+      // invalid SYNC (!=0x55) -> error
+      else
+      {
         // set error and abort frame
-        this->error = (LIN_Slave_Base::error_t) ((int) this->error | (int) LIN_Slave_Base::LIN_Slave_Base::ERROR_STATE);
+        this->_setError(LIN_Slave_Base::ERROR_SYNC);
         this->state = LIN_Slave_Base::STATE_DONE;
 
+        // optional auto-baud: try next baudrate
+        this->_checkBaudrate(false);
+
+        // optionally count and log SYNC errors
+        #if defined(LIN_SLAVE_ID_COUNTERS)
+          LIN_Slave_Base::_countInc(this->counterBus.sync, 1);
+        #endif
+        this->_log(LIN_Slave_Base::LOG_SYNC_ERROR, byteReceived, TimeReceived);
+
         // optionally disable RS485 transmitter
         _disableTransmitter();
 
         // optional debug output (debug level 1)
         #if defined(LIN_SLAVE_DEBUG_SERIAL) && (LIN_SLAVE_DEBUG_LEVEL >= 1)
           LIN_SLAVE_DEBUG_SERIAL.print(this->nameLIN);
-          LIN_SLAVE_DEBUG_SERIAL.print(": LIN_Slave_Base::handler()");
-          LIN_SLAVE_DEBUG_SERIAL.print(": error: illegal state ");
-          LIN_SLAVE_DEBUG_SERIAL.print(this->state);
-          LIN_SLAVE_DEBUG_SERIAL.println(", this should never happen...");
+          LIN_SLAVE_DEBUG_SERIAL.print(": LIN_Slave_Base::_handleByte()");
+          LIN_SLAVE_DEBUG_SERIAL.print(": SYNC error, received 0x");
+          LIN_SLAVE_DEBUG_SERIAL.println(byteReceived, HEX);
         #endif
 
-    } // switch(state)
+      } // invalid SYNC
 
-  } // if byte received
+      break; // STATE_WAIT_FOR_SYNC
 
-} // LIN_Slave_Base::handler
+
+    // sync field has been received, waiting for protected ID
+    case LIN_Slave_Base::STATE_WAIT_FOR_PID:
+
+      this->pid = byteReceived;          // received (protected) ID
+      this->id  = byteReceived & 0x3F;   // extract ID, drop parity bits
+      this->timePID = this->timeLastRx;
+
+      // check PID parity bits 6+7 once. On error abort frame
+      if (!LIN_Slave_Protocol::isValidPID(this->pid))
+      {
+        // frame header found by resync -> was no frame, discard silently and continue search
+        if (this->scoreResync != 0)
+        {
+          this->scoreResync = 0;
+          this->state = LIN_Slave_Base::STATE_WAIT_FOR_BREAK;
+          break;
+        }
+
+        // baudrate may be wrong (optional auto-baud)
+        this->_checkBaudrate(false);
+
+        // set error and abort frame
+        this->_setError(LIN_Slave_Base::ERROR_PID);
+        this->state = LIN_Slave_Base::STATE_DONE;
+
+        // optionally update error counters of (corrupted) frame ID and log error
+        this->_countFrame();
+        this->_log(LIN_Slave_Base::LOG_PID_ERROR, byteReceived, TimeReceived);
+
+        // optionally disable RS485 transmitter
+        _disableTransmitter();
+
+        // optional debug output (debug level 1)
+        #if defined(LIN_SLAVE_DEBUG_SERIAL) && (LIN_SLAVE_DEBUG_LEVEL >= 1)
+          LIN_SLAVE_DEBUG_SERIAL.print(this->nameLIN);
+          LIN_SLAVE_DEBUG_SERIAL.print(": LIN_Slave_Base::_handleByte()");
+          LIN_SLAVE_DEBUG_SERIAL.print(": PID parity error, received 0x");
+          LIN_SLAVE_DEBUG_SERIAL.print(this->pid, HEX);
+          LIN_SLAVE_DEBUG_SERIAL.print(", calculated 0x");
+          LIN_SLAVE_DEBUG_SERIAL.println(this->_calculatePID(this->id), HEX);
+        #endif
+
+        break;
+        
+      } // PID error
+
+      // frame header found by resync is confirmed by valid PID -> optionally count and log resynchronization
+      if (this->scoreResync != 0)
+      {
+        #if defined(LIN_SLAVE_ID_COUNTERS)
+          LIN_Slave_Base::_countInc(this->counterBus.resync, 1);
+        #endif
+        this->_log(LIN_Slave_Base::LOG_RESYNC, this->scoreResync, this->timeFrameStart);
+        this->scoreResync = 0;
+      }
+
+      // valid PID confirms baudrate (optional auto-baud) and SYNC->PID byte period of master (clock trim)
+      this->_checkBaudrate(true);
+      this->_measureClock(this->timeLastRx - this->timeSync);
+
+      // get callback of validated ID
+      pCallback = this->_findCallback(this->id);
+
+      // monitor mode: capture frame without response. Length is inferred at frame end, see _monitorFrame()
+      if (this->flagMonitor)
+      {
+        this->numData      = 8;                                  // max. length for frame timeout
+        this->_checksumInit();
+        this->sumClassic   = 0x00;
+        this->maskEnhanced = 0x0000;
+        this->maskClassic  = 0x0000;
+        this->state = LIN_Slave_Base::STATE_RECEIVING_DATA;
+      }
+
+      // if slave response was published for ID, send it without callback. Data and checksum are already prepared
+      #if (LIN_SLAVE_NUM_RESPONSES > 0)
+        else if (((idxResponse = this->_findResponse(this->id)) < LIN_SLAVE_NUM_RESPONSES) && 
+          (this->response[idxResponse].numData[this->generation & 0x01] != 0))
+        {
+          // select active buffer of current generation
+          uint8_t   idxBuf = this->generation & 0x01;
+          uint8_t   *pBuf  = this->response[idxResponse].buf[idxBuf];
+
+          // set frame properties
+          this->type    = LIN_Slave_Base::SLAVE_RESPONSE;
+          this->numData = this->response[idxResponse].numData[idxBuf];
+
+          // optionally enable RS485 transmitter
+          _enableTransmitter();
+
+          // send slave response (data+chk)
+          this->_serialWrite(pBuf, this->numData+1);
+          this->_statAdd(LIN_Slave_Base::STAT_LATENCY, this->_statTime() - this->timePID);
+          this->_log(LIN_Slave_Base::LOG_RESPONSE, this->numData, TimeReceived);
+
+          // copy sent data for echo check and getFrame(). Full buffer, as copy of constant size is inlined
+          memcpy(this->bufData, pBuf, sizeof(this->bufData));
+
+          // advance state to receiving echo
+          this->state = LIN_Slave_Base::STATE_RECEIVING_ECHO;
+
+        } // if published slave response
+      #endif
+
+      // if slave response ID is registered, call callback function and send response
+      else if ((pCallback != nullptr) && (pCallback->type_numData & LIN_Slave_Base::SLAVE_RESPONSE))
+      {
+        // get type (high nibble) and number of response bytes (low nibble) from callback array
+        this->type = (LIN_Slave_Base::frame_t) (pCallback->type_numData & 0xF0);
+        this->numData = pCallback->type_numData & 0x0F;
+        
+        // call the user-defined callback function for this ID
+        timeStat = this->_statTime();
+        pCallback->fct(numData, this->bufData);
+        this->_statCallback(this->id, this->_statTime() - timeStat);
+
+        // attach frame checksum
+        this->_checksumInit();
+        for (uint8_t i = 0; i < this->numData; i++)
+          this->_checksumAdd(this->bufData[i]);
+        this->bufData[numData] = this->_checksumGet();
+
+        // optionally enable RS485 transmitter
+        _enableTransmitter();
+
+        // send slave response (data+chk)
+        this->_serialWrite(bufData, numData+1);
+        this->_statAdd(LIN_Slave_Base::STAT_LATENCY, this->_statTime() - this->timePID);
+        this->_log(LIN_Slave_Base::LOG_RESPONSE, this->numData, TimeReceived);
+
+        // advance state to receiving echo
+        this->state = LIN_Slave_Base::STATE_RECEIVING_ECHO;
+
+        // optional debug output (debug level 2)
+        #if defined(LIN_SLAVE_DEBUG_SERIAL) && (LIN_SLAVE_DEBUG_LEVEL >= 2)
+          LIN_SLAVE_DEBUG_SERIAL.print(this->nameLIN);
+          LIN_SLAVE_DEBUG_SERIAL.print(": LIN_Slave_Base::_handleByte()");
+          LIN_SLAVE_DEBUG_SERIAL.print(": handle slave response PID 0x");
+          LIN_SLAVE_DEBUG_SERIAL.println(this->pid, HEX);
+        #endif
+
+      } // if slave response frame
+      
+      // if master request ID is registered, get number of data bytes and advance state
+      else if ((pCallback != nullptr) && (pCallback->type_numData & LIN_Slave_Base::MASTER_REQUEST))
+      {
+        // get type (high nibble) and number of response bytes (low nibble) from callback array
+        this->type = (LIN_Slave_Base::frame_t) (pCallback->type_numData & 0xF0);
+        this->numData = pCallback->type_numData & 0x0F;
+        
+        // start checksum accumulation and advance state to receiving data
+        this->_checksumInit();
+        this->state = LIN_Slave_Base::STATE_RECEIVING_DATA;
+        this->_log(LIN_Slave_Base::LOG_REQUEST, this->numData, TimeReceived);
+      
+      } // if master request frame 
+        
+      // ID is not registered -> wait for next break
+      else
+      {
+        // optional debug output (debug level 2)
+        #if defined(LIN_SLAVE_DEBUG_SERIAL) && (LIN_SLAVE_DEBUG_LEVEL >= 2)
+          LIN_SLAVE_DEBUG_SERIAL.print(this->nameLIN);
+          LIN_SLAVE_DEBUG_SERIAL.print(": LIN_Slave_Base::_handleByte()");
+          LIN_SLAVE_DEBUG_SERIAL.print(": drop frame PID 0x");
+          LIN_SLAVE_DEBUG_SERIAL.println(this->pid, HEX);
+        #endif
+
+        // optionally count and log frames for other slaves
+        #if defined(LIN_SLAVE_ID_COUNTERS)
+          LIN_Slave_Base::_countInc(this->counterBus.other, 1);
+        #endif
+        this->_log(LIN_Slave_Base::LOG_IGNORE, this->pid, TimeReceived);
+
+        // reset state machine
+        this->state = LIN_Slave_Base::STATE_WAIT_FOR_BREAK;
+
+      } // if frame not registered
+
+      // frame length is known -> set frame timeout
+      if (this->state & (LIN_Slave_Base::STATE_RECEIVING_DATA | LIN_Slave_Base::STATE_RECEIVING_ECHO))
+        this->_setFrameTimeout();
+
+      break; // STATE_WAIT_FOR_PID
+
+
+    // receive master request data
+    case LIN_Slave_Base::STATE_RECEIVING_DATA:
+
+      // monitor mode: store byte of frame with unknown length. Evaluate frame after max. length (8 data + checksum)
+      if (this->flagMonitor)
+      {
+        this->_monitorByte(byteReceived);
+        if (this->idxData >= 9)
+          this->_monitorFrame();
+        break;
+      }
+
+      // store received data and update checksum
+      this->bufData[(this->idxData)++] = byteReceived;
+      this->_checksumAdd(byteReceived);
+      
+      // if data is finished, advance to checksum check
+      if (this->idxData >= this->numData)
+        this->state = LIN_Slave_Base::STATE_WAIT_FOR_CHK;
+
+      break; // STATE_RECEIVING_DATA
+
+
+    // receive slave response echo
+    case LIN_Slave_Base::STATE_RECEIVING_ECHO:
+
+      // compare received echo to sent data
+      if (this->bufData[(this->idxData)++] != byteReceived)
+      {
+        // set error and abort frame
+        this->_setError(LIN_Slave_Base::ERROR_ECHO);
+        this->state = LIN_Slave_Base::STATE_DONE;
+        this->_pushFrame();
+        this->_log(LIN_Slave_Base::LOG_ECHO_ERROR, byteReceived, TimeReceived);
+
+        // optionally disable RS485 transmitter
+        _disableTransmitter();
+
+        // optional debug output (debug level 1)
+        #if defined(LIN_SLAVE_DEBUG_SERIAL) && (LIN_SLAVE_DEBUG_LEVEL >= 1)
+          LIN_SLAVE_DEBUG_SERIAL.print(this->nameLIN);
+          LIN_SLAVE_DEBUG_SERIAL.print(": LIN_Slave_Base::_handleByte()");
+          LIN_SLAVE_DEBUG_SERIAL.print(": echo error, received 0x");
+          LIN_SLAVE_DEBUG_SERIAL.print(byteReceived, HEX);
+          LIN_SLAVE_DEBUG_SERIAL.print(", expected 0x");
+          LIN_SLAVE_DEBUG_SERIAL.println(this->bufData[(this->idxData)-1], HEX);
+        #endif
+
+      } // if echo error
+
+      // if data is finished, finish frame
+      else if (this->idxData >= this->numData+1)
+      {
+        this->state = LIN_Slave_Base::STATE_DONE;
+        this->_pushFrame();
+        this->_log(LIN_Slave_Base::LOG_FRAME_OK, this->numData, TimeReceived);
+
+        // optionally disable RS485 transmitter
+        _disableTransmitter();
+      }
+
+      break; // STATE_RECEIVING_ECHO
+
+
+    // Data has been received for master request frame, waiting for checksum
+    case LIN_Slave_Base::STATE_WAIT_FOR_CHK:
+
+      // Checksum valid -> call user-defined callback function for this ID. Checksum was accumulated during reception
+      if (byteReceived == this->_checksumGet())
+      {
+        // call user-defined master request callback function. Only reachable if callback has been registered
+        pCallback = this->_findCallback(this->id);
+        if (pCallback != nullptr)
+        {
+          timeStat = this->_statTime();
+          pCallback->fct(numData, bufData);
+          this->_statCallback(this->id, this->_statTime() - timeStat);
+        }
+        this->_log(LIN_Slave_Base::LOG_FRAME_OK, this->numData, TimeReceived);
+
+        // optional debug output (debug level 2)
+        #if defined(LIN_SLAVE_DEBUG_SERIAL) && (LIN_SLAVE_DEBUG_LEVEL >= 2)
+          LIN_SLAVE_DEBUG_SERIAL.print(this->nameLIN);
+          LIN_SLAVE_DEBUG_SERIAL.print(": LIN_Slave_Base::_handleByte()");
+          LIN_SLAVE_DEBUG_SERIAL.print(": handle master request PID 0x");
+          LIN_SLAVE_DEBUG_SERIAL.println(this->pid, HEX);
+        #endif
+
+      } // if checksum ok
+      
+      // checksum error
+      else
+      {
+        // set error
+        this->_setError(LIN_Slave_Base::ERROR_CHK);
+        this->_log(LIN_Slave_Base::LOG_CHK_ERROR, byteReceived, TimeReceived);
+
+        // optional debug output (debug level 1)
+        #if defined(LIN_SLAVE_DEBUG_SERIAL) && (LIN_SLAVE_DEBUG_LEVEL >= 1)
+          LIN_SLAVE_DEBUG_SERIAL.print(this->nameLIN);
+          LIN_SLAVE_DEBUG_SERIAL.print(": LIN_Slave_Base::_handleByte()");
+          LIN_SLAVE_DEBUG_SERIAL.print(": CHK error, received 0x");
+          LIN_SLAVE_DEBUG_SERIAL.print(byteReceived, HEX);
+          LIN_SLAVE_DEBUG_SERIAL.print(", calculated 0x");
+          LIN_SLAVE_DEBUG_SERIAL.println(this->_checksumGet(), HEX);
+        #endif
+
+      } // if checksum error
+
+      // frame is finished
+      this->state = LIN_Slave_Base::STATE_DONE;
+      this->_pushFrame();
+
+      // optionally disable RS485 transmitter
+      _disableTransmitter();
+
+      break; // STATE_WAIT_FOR_CHK
+
+
+    // this should never happen -> error
+    default:
+
+      // set error and abort frame
+      this->_setError(LIN_Slave_Base::ERROR_STATE);
+      this->state = LIN_Slave_Base::STATE_DONE;
+
+      // optionally disable RS485 transmitter
+      _disableTransmitter();
+
+      // optional debug output (debug level 1)
+      #if defined(LIN_SLAVE_DEBUG_SERIAL) && (LIN_SLAVE_DEBUG_LEVEL >= 1)
+        LIN_SLAVE_DEBUG_SERIAL.print(this->nameLIN);
+        LIN_SLAVE_DEBUG_SERIAL.print(": LIN_Slave_Base::_handleByte()");
+        LIN_SLAVE_DEBUG_SERIAL.print(": error: illegal state ");
+        LIN_SLAVE_DEBUG_SERIAL.print(this->state);
+        LIN_SLAVE_DEBUG_SERIAL.println(", this should never happen...");
+      #endif
+
+  } // switch(state)
+
+  // optional statistics: execution time for this byte
+  this->_statAdd(LIN_Slave_Base::STAT_HANDLER, this->_statTime() - timeEntry);
+
+} // LIN_Slave_Base::_handleByte()
+
+
+
+/**************************
+ * PUBLIC METHODS
+**************************/
+
+/**
+  \brief      LIN slave node constructor
+  \details    LIN slave node constructor. Initialize class variables to default values.
+              For an explanation of the LIN bus and protocol e.g. see https://en.wikipedia.org/wiki/Local_Interconnect_Network
+  \param[in]  Version     LIN protocol version (default = v2)
+  \param[in]  NameLIN     LIN node name (default = "Slave")
+  \param[in]  TimeoutRx   max. pause [us] between bytes in frame at 19200 Baud (default = 1500). Is stored in bit times, i.e. scales with baudrate. Frame timeout is derived from baudrate and frame length
+  \param[in]  PinTxEN     optional Tx enable pin (high active) e.g. for LIN via RS485 (default = -127/none)
+*/
+LIN_Slave_Base::LIN_Slave_Base(LIN_Slave_Base::version_t Version, const char NameLIN[], uint32_t TimeoutRx, const int8_t PinTxEN)
+{
+  // Debug serial initialized in begin() -> no debug output here
+
+  // store parameters in class variables
+  this->version = Version;                                    // LIN protocol version (required for checksum)
+  #if defined(LIN_SLAVE_NAME_POINTER)
+    this->nameLIN = NameLIN;                                  // node name e.g. for debug
+  #else
+    strncpy(this->nameLIN, NameLIN, LIN_SLAVE_BUFLEN_NAME-1); // node name e.g. for debug
+    this->nameLIN[LIN_SLAVE_BUFLEN_NAME-1] = '\0';
+  #endif
+  this->timeoutRx = TimeoutRx;                                // max. pause [us] between bytes in frame
+  this->bitsTimeoutRx = LIN_Slave_Base::_timeToBits(TimeoutRx); // same in bit times, for other baudrates
+  this->pinTxEN = PinTxEN;                                    // optional Tx enable pin for RS485
+
+  // initialize slave node properties
+  this->state     = LIN_Slave_Base::STATE_WAIT_FOR_BREAK;     // status of LIN state machine
+  this->error     = LIN_Slave_Base::NO_ERROR;                 // last LIN error. Is latched
+  this->flagBreak = false;                                    // no BREAK detected
+  this->pNextInstance = nullptr;                              // not in list of opened instances
+  this->tableFrame = nullptr;                                 // no frame table attached
+  this->indexFrame = nullptr;
+  this->callbackTable.type_numData = 0x00;
+  this->callbackTable.fct = nullptr;
+  #if (LIN_SLAVE_MAX_FRAMES > 0)
+    for (uint8_t i=0; i<8; i++)
+    {
+      this->maskFrame[i] = 0x00;                              // no ID registered
+      this->rankFrame[i] = 0;
+    }
+    this->numFrames = 0;
+  #endif
+  for (uint8_t i=0; i<((LIN_SLAVE_MAX_FRAMES > 0) ? LIN_SLAVE_MAX_FRAMES : 64); i++)
+  {
+    this->callback[i].type_numData = 0x00;                    // frame type (high nibble) and number of data bytes (low nibble)
+    this->callback[i].fct = nullptr;                          // user callback functions
+  }
+
+  // initialize frame properties
+  this->pid         = 0x00;                                   // protected frame identifier
+  this->id          = 0x00;                                   // unprotected frame identifier
+  this->numData     = 0;                                      // number of data bytes in frame
+  for (uint8_t i=0; i<9; i++)
+    this->bufData[i] = 0x00;                                  // init data bytes (max 8B) + chk
+  this->idxData    = 0;                                       // current index in bufData
+  this->sumData    = 0x00;                                    // running checksum of current frame
+  this->flagAutoBaud   = false;                               // use baudrate of begin()
+  this->flagBaudLocked = false;                               // baudrate not confirmed
+  this->flagBaudNext   = false;                               // no baudrate switch pending
+  this->idxBaud        = 0;                                   // first candidate baudrate
+  this->numBaudFail    = 0;                                   // no SYNC/PID errors
+  this->timeBaudSwitch = 0;                                   // time [us] of last baudrate change
+  this->scoreBreak     = 0;                                   // no evidence for BREAK
+  this->scoreResync    = 0;                                   // frame not found by resync
+  this->timeResync     = 0;                                   // time [us] of BREAK candidate
+  this->timePauseResync = 0;                                  // min. pause [us] for resync, is set in begin()
+  this->flagClockTrim  = false;                               // use nominal baudrate
+  this->timeByteNom    = 0;                                   // nominal byte period [us], is set in begin()
+  this->timeByteAvg    = 0;                                   // no clock measurement
+  this->baudrateTrim   = 0;                                   // trimmed baudrate, is set in begin()
+  this->flagMonitor  = false;                                 // normal slave operation
+  this->fctMonitor   = nullptr;                               // no monitor callback
+  this->sumClassic   = 0x00;                                  // running classic checksum in monitor mode
+  this->maskEnhanced = 0x0000;                                // possible frame ends (enhanced checksum) in monitor mode
+  this->maskClassic  = 0x0000;                                // possible frame ends (classic checksum) in monitor mode
+  this->timeLastRx = 0;                                       // time [ms] of last received byte in frame
+  this->errorFrame = LIN_Slave_Base::NO_ERROR;                // errors of current frame
+  this->timeFrameStart = 0;                                   // time [us] of BREAK of current frame
+  this->timeSync = 0;                                         // time [us] of SYNC of current frame
+  this->timePID = 0;                                          // time [us] of PID of current frame
+  this->timeBreak = 0;                                        // time [us] of last BREAK
+  this->timeoutFrame = 0;                                     // timeout [us] for current frame, set on BREAK and PID
+  this->flagTimeoutAdaptive = false;                          // use nominal frame timeout
+  this->baudrate = LIN_SLAVE_TIMING_BAUDRATE;                 // default baudrate until begin()
+  this->baudrateNormal = this->baudrate;                      // baudrate to restore after fast mode
+  this->flagFastMode = false;                                 // no fast mode
+
+  // initialize queue of completed frames
+  #if (LIN_SLAVE_FRAME_QUEUE > 0)
+    this->queueHead     = 0;                                  // write index, only changed by handler()
+    this->queueTail     = 0;                                  // read index, only changed by readFrame()
+    memset((void*) this->queueSeq, 0, sizeof(this->queueSeq));  // no record is being written
+    this->queueOverflow = 0;                                  // number of lost frames
+    this->queuePolicy   = LIN_Slave_Base::QUEUE_DROP_NEW;     // keep unread frames if queue is full
+  #endif
+
+  // initialize pre-published slave responses
+  #if (LIN_SLAVE_NUM_RESPONSES > 0)
+    for (uint8_t i=0; i<LIN_SLAVE_NUM_RESPONSES; i++)
+      this->response[i].id = 0xFF;                            // slot unused
+    this->generation  = 0;                                    // publish generation, bit 0 = active buffer
+    this->maskPending = 0x00;                                 // no pending updates
+    this->flagPublish = false;                                // no open publish transaction
+  #endif
+
+  // initialize deferred event log
+  #if (LIN_SLAVE_LOG_SIZE > 0)
+    this->logHead = 0;                                        // write index, only changed by handler()
+    this->logTail = 0;                                        // read index, only changed by readLog()
+    this->logLost = 0;                                        // number of lost entries
+  #endif
+
+  // initialize timing statistics
+  #if defined(LIN_SLAVE_STATISTICS)
+    this->resetStatistics();
+  #endif
+
+  // initialize traffic and error counters
+  #if defined(LIN_SLAVE_ID_COUNTERS)
+    this->resetCounters();
+  #endif
+
+  // initialize TxEN pin low (=transmitter off)
+  if (this->pinTxEN >= 0)
+  {
+    digitalWrite(this->pinTxEN, LOW);
+    pinMode(this->pinTxEN, OUTPUT);
+  }
+
+} // LIN_Slave_Base::LIN_Slave_Base()
+
+
+
+/**
+  \brief      Open serial interface
+  \details    Open serial interface with specified baudrate. Baudrates below LIN_SLAVE_MIN_BAUDRATE are clamped. Here dummy!
+  \param[in]  Baudrate    communication speed [Baud] (default = 19200)
+*/
+void LIN_Slave_Base::begin(uint32_t Baudrate)
+{
+  // For optional debugging
+  #if defined(LIN_SLAVE_DEBUG_SERIAL)
+    LIN_SLAVE_DEBUG_SERIAL.begin(115200);
+    while (!LIN_SLAVE_DEBUG_SERIAL);
+  #endif
+
+  // print debug message (debug level 2)
+  #if defined(LIN_SLAVE_DEBUG_SERIAL) && (LIN_SLAVE_DEBUG_LEVEL >= 2)
+    LIN_SLAVE_DEBUG_SERIAL.print(this->nameLIN);
+    LIN_SLAVE_DEBUG_SERIAL.print(": LIN_Slave_Base::begin(");
+    LIN_SLAVE_DEBUG_SERIAL.print((long) Baudrate);
+    LIN_SLAVE_DEBUG_SERIAL.println(")");
+  #endif
+
+  // avoid division by zero in timing calculation, e.g. _bitsToTime()
+  if (Baudrate < LIN_SLAVE_MIN_BAUDRATE)
+    Baudrate = LIN_SLAVE_MIN_BAUDRATE;
+
+  // store parameters in class variables. For auto-baud start with first candidate
+  this->baudrate   = (this->flagAutoBaud) ? LIN_Slave_Base::tableBaud[this->idxBaud] : Baudrate;  // communication baudrate [Baud]
+  this->timeBaudSwitch = micros();                              // time [us] of last baudrate change
+  this->baudrateNormal = this->baudrate;                        // baudrate to restore after fast mode
+  this->flagFastMode   = false;                                 // no fast mode
+  this->_updateTiming();                                        // timing parameters [us] for this baudrate
+
+  // initialize slave node properties
+  this->error = LIN_Slave_Base::NO_ERROR;                       // last LIN error. Is latched
+  this->state = LIN_Slave_Base::STATE_WAIT_FOR_BREAK;           // status of LIN state machine
+
+  // add to list of opened instances for serviceAll(), if not yet listed
+  LIN_Slave_Base  *pInstance = LIN_Slave_Base::pFirstInstance;
+  while ((pInstance != nullptr) && (pInstance != this))
+    pInstance = pInstance->pNextInstance;
+  if (pInstance == nullptr)
+  {
+    noInterrupts();
+    this->pNextInstance = LIN_Slave_Base::pFirstInstance;
+    LIN_Slave_Base::pFirstInstance = this;
+    interrupts();
+  }
+
+  // initialize optional TxEN pin to low (=transmitter off)
+  if (this->pinTxEN >= 0)
+  {
+    digitalWrite(this->pinTxEN, LOW);
+    pinMode(this->pinTxEN, OUTPUT);
+  }
+
+} // LIN_Slave_Base::begin()
+
+
+
+/**
+  \brief      Close serial interface
+  \details    Close serial interface. Here dummy!
+*/
+void LIN_Slave_Base::end()
+{
+  // optional debug output (debug level 2)
+  #if defined(LIN_SLAVE_DEBUG_SERIAL) && (LIN_SLAVE_DEBUG_LEVEL >= 2)
+    LIN_SLAVE_DEBUG_SERIAL.print(this->nameLIN);
+    LIN_SLAVE_DEBUG_SERIAL.println(": LIN_Slave_Base::end()");
+  #endif
+
+  // set slave node properties
+  this->error = LIN_Slave_Base::NO_ERROR;                     // last LIN error. Is latched
+  this->state = LIN_Slave_Base::STATE_OFF;                    // status of LIN state machine
+
+  // remove from list of opened instances for serviceAll()
+  noInterrupts();
+  for (LIN_Slave_Base **ppInstance = &(LIN_Slave_Base::pFirstInstance); *ppInstance != nullptr; ppInstance = &((*ppInstance)->pNextInstance))
+  {
+    if (*ppInstance == this)
+    {
+      *ppInstance = this->pNextInstance;
+      break;
+    }
+  }
+  if (LIN_Slave_Base::pNextService == this)
+    LIN_Slave_Base::pNextService = this->pNextInstance;
+  this->pNextInstance = nullptr;
+  interrupts();
+
+  // optionally disable RS485 transmitter
+  _disableTransmitter();
+
+} // LIN_Slave_Base::end()
+
+
+
+/**
+  \brief      Enable or disable auto-baud detection
+  \details    Enable or disable auto-baud detection from SYNC field. Candidate baudrates LIN_SLAVE_AUTOBAUD_RATES are tried in turn
+              until a frame header with valid SYNC (0x55) and PID parity is received at the current baudrate. Next candidate is
+              tried on SYNC or PID error, or if no valid header is received within LIN_SLAVE_AUTOBAUD_TIMEOUT despite bus activity.
+              Once locked, detection is only restarted after LIN_SLAVE_AUTOBAUD_RETRY consecutive SYNC/PID errors.
+              No response is sent before lock. Can be called before or after begin()
+  \param[in]  Enable    true: enable auto-baud, false: keep current baudrate
+*/
+void LIN_Slave_Base::setAutoBaud(bool Enable)
+{
+  // print debug message (debug level 2)
+  #if defined(LIN_SLAVE_DEBUG_SERIAL) && (LIN_SLAVE_DEBUG_LEVEL >= 2)
+    LIN_SLAVE_DEBUG_SERIAL.print(this->nameLIN);
+    LIN_SLAVE_DEBUG_SERIAL.print(": LIN_Slave_Base::setAutoBaud(): ");
+    LIN_SLAVE_DEBUG_SERIAL.println((int) Enable);
+  #endif
+
+  // set auto-baud parameters. For data consistency temporarily disable ISRs
+  noInterrupts();
+  this->flagAutoBaud   = Enable;
+  this->flagBaudLocked = false;
+  this->flagBaudNext   = false;
+  this->idxBaud        = 0;
+  this->numBaudFail    = 0;
+  interrupts();
+
+  // interface already open -> start with first candidate baudrate. Receive ISR ignores bytes during re-configuration, see _handleAutoBaud()
+  if ((Enable) && (this->state != LIN_Slave_Base::STATE_OFF))
+  {
+    noInterrupts();
+    this->state = LIN_Slave_Base::STATE_OFF;
+    interrupts();
+    this->baudrate = LIN_Slave_Base::tableBaud[0];
+    this->_updateTiming();
+    this->_setBaudrate(this->baudrate);
+    noInterrupts();
+    this->timeBaudSwitch = micros();
+    this->state = LIN_Slave_Base::STATE_WAIT_FOR_BREAK;
+    interrupts();
+  }
+
+} // LIN_Slave_Base::setAutoBaud()
+
+
+
+/**
+  \brief      Handle auto-baud detection
+  \details    Switch to next candidate baudrate if requested by _checkBaudrate(), or if bus is active but no valid
+              frame header was received since last switch. Is called by handler(), i.e. not from ISR.
+              As the state machine may run in the receive ISR (LIN_SLAVE_HANDLER_IN_ISR), the check and state change are done
+              with ISRs disabled, and the state is STATE_OFF during re-configuration, i.e. the receive ISR ignores bytes meanwhile
+*/
+void LIN_Slave_Base::_handleAutoBaud()
+{
+  bool      flagSwitch;
+
+  // no valid frame header within timeout despite received bytes, or switch requested -> try next baudrate.
+  // Flags, times and state are also written by receive ISR -> temporarily disable ISRs
+  noInterrupts();
+  flagSwitch = (this->flagBaudNext) ||
+    ((!(this->flagBaudLocked)) && ((int32_t) (this->timeLastRx - this->timeBaudSwitch) > (int32_t) LIN_SLAVE_AUTOBAUD_TIMEOUT));
+  if (flagSwitch)
+  {
+    this->flagBaudNext = false;
+    this->state = LIN_Slave_Base::STATE_OFF;
+  }
+  interrupts();
+
+  // no baudrate switch pending -> done
+  if (!flagSwitch)
+    return;
+
+  // select next candidate baudrate
+  this->idxBaud = this->idxBaud + 1;
+  if (this->idxBaud >= sizeof(LIN_Slave_Base::tableBaud) / sizeof(LIN_Slave_Base::tableBaud[0]))
+    this->idxBaud = 0;
+  this->baudrate = LIN_Slave_Base::tableBaud[this->idxBaud];
+  this->_updateTiming();
+  this->_setBaudrate(this->baudrate);
+
+  // discard bytes received at old baudrate
+  while (this->available())
+    this->_serialRead();
+
+  // wait for next frame at new baudrate
+  noInterrupts();
+  this->timeBaudSwitch = micros();
+  this->state = LIN_Slave_Base::STATE_WAIT_FOR_BREAK;
+  interrupts();
+
+  // optional debug output (debug level 2)
+  #if defined(LIN_SLAVE_DEBUG_SERIAL) && (LIN_SLAVE_DEBUG_LEVEL >= 2)
+    LIN_SLAVE_DEBUG_SERIAL.print(this->nameLIN);
+    LIN_SLAVE_DEBUG_SERIAL.print(": LIN_Slave_Base::_handleAutoBaud(): try ");
+    LIN_SLAVE_DEBUG_SERIAL.print((long) this->baudrate);
+    LIN_SLAVE_DEBUG_SERIAL.println(" Baud");
+  #endif
+
+} // LIN_Slave_Base::_handleAutoBaud()
+
+
+
+/**
+  \brief      Update timing parameters
+  \details    Update timing parameters [us] from bit times, and reset clock measurement and trim after change of nominal
+              baudrate, e.g. in begin(), by auto-baud or fast mode. Derived classes with own timing parameters must call this method
+*/
+void LIN_Slave_Base::_updateTiming()
+{
+  // timing parameters [us] for new baudrate. For data consistency temporarily disable ISRs
+  noInterrupts();
+  this->timeoutRx    = this->_bitsToTime(this->bitsTimeoutRx);
+  this->timePauseResync = this->_bitsToTime(LIN_SLAVE_RESYNC_PAUSE);
+  this->timeByteNom  = (uint16_t) (10000000L / this->baudrate);
+  this->timeByteAvg  = 0;
+  this->baudrateTrim = this->baudrate;
+  interrupts();
+
+} // LIN_Slave_Base::_updateTiming()
+
+
+
+/**
+  \brief      Trim UART baudrate to master clock
+  \details    Trim UART baudrate to measured byte period of master SYNC->PID, which is measured with the local clock.
+              E.g. if local clock is 5% fast, the byte period measures 5% long and the UART baudrate is set 5% lower,
+              which results in the nominal baudrate on the bus. To avoid frequent re-configuration, UART is only changed if the
+              trimmed baudrate deviates by >1/2^LIN_SLAVE_CLOCK_HYSTERESIS from the current value, and only between frames.
+              Is called by handler(), i.e. not from ISR. As the state machine may run in the receive ISR (LIN_SLAVE_HANDLER_IN_ISR),
+              the idle check and state change are done with ISRs disabled, see _handleAutoBaud()
+*/
+void LIN_Slave_Base::_handleClockTrim()
+{
+  uint32_t                  timeByte;
+  uint32_t                  baudrateNew, baudrateDiff;
+  LIN_Slave_Base::state_t   stateIdle;
+
+  // get filtered byte period. For data consistency temporarily disable ISRs
+  noInterrupts();
+  timeByte = this->timeByteAvg;
+  interrupts();
+
+  // no measurement yet -> do nothing
+  if (timeByte == 0)
+    return;
+
+  // baudrate [Baud] for measured byte period, i.e. 10 bits * 1e6us * 16 / byte period [us/16]
+  baudrateNew  = 160000000L / timeByte;
+  baudrateDiff = (baudrateNew > this->baudrateTrim) ? (baudrateNew - this->baudrateTrim) : (this->baudrateTrim - baudrateNew);
+
+  // change within hysteresis -> keep UART configuration
+  if (baudrateDiff <= (this->baudrate >> LIN_SLAVE_CLOCK_HYSTERESIS))
+    return;
+
+  // only re-configure between frames. Receive ISR ignores bytes in STATE_OFF -> no frame can start meanwhile
+  noInterrupts();
+  stateIdle = this->state;
+  if (stateIdle & (LIN_Slave_Base::STATE_WAIT_FOR_BREAK | LIN_Slave_Base::STATE_DONE))
+    this->state = LIN_Slave_Base::STATE_OFF;
+  interrupts();
+  if (!(stateIdle & (LIN_Slave_Base::STATE_WAIT_FOR_BREAK | LIN_Slave_Base::STATE_DONE)))
+    return;
+
+  // re-configure UART and restore state, e.g. STATE_DONE until next BREAK
+  this->baudrateTrim = baudrateNew;
+  this->_setBaudrate(this->baudrateTrim);
+  noInterrupts();
+  this->state = stateIdle;
+  interrupts();
+
+  // optional debug output (debug level 2)
+  #if defined(LIN_SLAVE_DEBUG_SERIAL) && (LIN_SLAVE_DEBUG_LEVEL >= 2)
+    LIN_SLAVE_DEBUG_SERIAL.print(this->nameLIN);
+    LIN_SLAVE_DEBUG_SERIAL.print(": LIN_Slave_Base::_handleClockTrim(): trim to ");
+    LIN_SLAVE_DEBUG_SERIAL.print((long) this->baudrateTrim);
+    LIN_SLAVE_DEBUG_SERIAL.println(" Baud");
+  #endif
+
+} // LIN_Slave_Base::_handleClockTrim()
+
+
+
+/**
+  \brief      Enable or disable trimming of UART baudrate to master clock
+  \details    Enable or disable trimming of UART baudrate to master clock, e.g. for boards with RC oscillator.
+              The byte period of the master is measured between SYNC and PID reception of each valid frame header, and
+              the UART baudrate (for SoftwareSerial the bit delay) is trimmed accordingly in handler().
+              Requires accurate receive timestamps, i.e. back-to-back header bytes and handler() calls faster than a byte period
+              if timestamps are not captured in the receive ISR. Implausible measurements (>12.5% from nominal) are ignored.
+              When disabled, the nominal baudrate is restored
+  \param[in]  Enable    true: trim baudrate to master clock, false: use nominal baudrate
+*/
+void LIN_Slave_Base::setClockTrim(bool Enable)
+{
+  // print debug message (debug level 2)
+  #if defined(LIN_SLAVE_DEBUG_SERIAL) && (LIN_SLAVE_DEBUG_LEVEL >= 2)
+    LIN_SLAVE_DEBUG_SERIAL.print(this->nameLIN);
+    LIN_SLAVE_DEBUG_SERIAL.print(": LIN_Slave_Base::setClockTrim(): ");
+    LIN_SLAVE_DEBUG_SERIAL.println((int) Enable);
+  #endif
+
+  // store setting
+  this->flagClockTrim = Enable;
+
+  // on disable restore nominal baudrate if interface is open and trimmed. Receive ISR ignores bytes during re-configuration, see _handleClockTrim()
+  if ((!Enable) && (this->state != LIN_Slave_Base::STATE_OFF) && (this->baudrateTrim != this->baudrate))
+  {
+    LIN_Slave_Base::state_t   stateOld;
+
+    noInterrupts();
+    stateOld = this->state;
+    this->state = LIN_Slave_Base::STATE_OFF;
+    interrupts();
+    this->baudrateTrim = this->baudrate;
+    this->_setBaudrate(this->baudrate);
+    noInterrupts();
+    this->state = stateOld;
+    interrupts();
+  }
+
+} // LIN_Slave_Base::setClockTrim()
+
+
+
+/**
+  \brief      Getter for measured clock deviation
+  \details    Getter for measured deviation of local clock vs. master clock, measured via byte period SYNC->PID.
+              Positive values mean that the local clock is fast. Measurement is independent of setClockTrim()
+  \return     filtered clock deviation [0.01%], or 0 if not yet measured
+*/
+int16_t LIN_Slave_Base::getClockDeviation()
+{
+  int32_t   timeByte, timeNom;
+
+  // get filtered byte period [us/16]. For data consistency temporarily disable ISRs
+  noInterrupts();
+  timeByte = (int32_t) this->timeByteAvg;
+  interrupts();
+
+  // no measurement yet
+  if (timeByte == 0)
+    return 0;
+
+  // relative deviation from nominal byte period. Measurement is limited to +/-12.5% -> no overflow
+  timeNom = 16L * (int32_t) this->timeByteNom;
+  return (int16_t) (((timeByte - timeNom) * 10000L) / timeNom);
+
+} // LIN_Slave_Base::getClockDeviation()
+
+
+
+/**
+  \brief      Switch to or from fast mode
+  \details    Switch to or from fast mode with higher baudrate (e.g. 57600..250000 Baud), e.g. for bulk data transfer or flashing.
+              All timing parameters are stored in bit times and are scaled to the new baudrate. Auto-baud detection is disabled.
+              On exit the previous nominal baudrate is restored. A pending frame is aborted and received bytes are discarded.
+              Master must switch baudrate accordingly, e.g. after a diagnostic request
+  \param[in]  Enable    true: switch to fast mode, false: restore normal baudrate
+  \param[in]  Baudrate  fast mode baudrate [Baud], min. LIN_SLAVE_MIN_BAUDRATE (default = LIN_SLAVE_FAST_BAUDRATE)
+*/
+void LIN_Slave_Base::setFastMode(bool Enable, uint32_t Baudrate)
+{
+  // print debug message (debug level 2)
+  #if defined(LIN_SLAVE_DEBUG_SERIAL) && (LIN_SLAVE_DEBUG_LEVEL >= 2)
+    LIN_SLAVE_DEBUG_SERIAL.print(this->nameLIN);
+    LIN_SLAVE_DEBUG_SERIAL.print(": LIN_Slave_Base::setFastMode(): ");
+    LIN_SLAVE_DEBUG_SERIAL.print((int) Enable);
+    LIN_SLAVE_DEBUG_SERIAL.print(", ");
+    LIN_SLAVE_DEBUG_SERIAL.println((long) Baudrate);
+  #endif
+
+  // enter fast mode: store normal baudrate for later restore. Auto-baud would switch back to normal rates
+  if (Enable)
+  {
+    if (!(this->flagFastMode))
+      this->baudrateNormal = this->baudrate;
+    this->flagAutoBaud = false;
+    this->baudrate     = (Baudrate < LIN_SLAVE_MIN_BAUDRATE) ? LIN_SLAVE_MIN_BAUDRATE : Baudrate;
+  }
+
+  // exit fast mode: restore normal baudrate
+  else if (this->flagFastMode)
+    this->baudrate = this->baudrateNormal;
+
+  // not in fast mode -> nothing to restore
+  else
+    return;
+  this->flagFastMode = Enable;
+
+  // scale timing parameters to new baudrate
+  this->_updateTiming();
+
+  // interface already open -> change baudrate, discard received bytes and wait for next frame
+  if (this->state != LIN_Slave_Base::STATE_OFF)
+  {
+    this->_setBaudrate(this->baudrate);
+    while (this->available())
+      this->_serialRead();
+    this->state = LIN_Slave_Base::STATE_WAIT_FOR_BREAK;
+  }
+
+} // LIN_Slave_Base::setFastMode()
+
+
+
+/**
+  \brief      Enable or disable passive monitor mode
+  \details    In monitor mode all frames on the bus are captured, independent of registered callbacks. Data length is inferred
+              at frame end (next BREAK, timeout or 8 data bytes) and validated via classic or enhanced checksum, see _monitorFrame().
+              A response is never sent. Captured frames are stored in the frame queue (if enabled, see readFrame()) and
+              passed to the optional monitor callback function. Frame type is MONITOR_CLASSIC or MONITOR_ENHANCED
+  \param[in]  Enable    true: enable monitor mode, false: normal slave operation
+  \param[in]  Fct       optional callback function for captured frames (default = none)
+*/
+void LIN_Slave_Base::setMonitorMode(bool Enable, LIN_Slave_Base::LinMonitorCallback Fct)
+{
+  // print debug message (debug level 2)
+  #if defined(LIN_SLAVE_DEBUG_SERIAL) && (LIN_SLAVE_DEBUG_LEVEL >= 2)
+    LIN_SLAVE_DEBUG_SERIAL.print(this->nameLIN);
+    LIN_SLAVE_DEBUG_SERIAL.print(": LIN_Slave_Base::setMonitorMode(): ");
+    LIN_SLAVE_DEBUG_SERIAL.println((int) Enable);
+  #endif
+
+  // set mode and abort current frame. For data consistency temporarily disable ISRs
+  noInterrupts();
+  this->flagMonitor = Enable;
+  this->fctMonitor  = Fct;
+  if (this->state != LIN_Slave_Base::STATE_OFF)
+    this->state = LIN_Slave_Base::STATE_WAIT_FOR_BREAK;
+  interrupts();
+
+  // disable RS485 transmitter
+  _disableTransmitter();
+
+} // LIN_Slave_Base::setMonitorMode()
+
+
+
+/**
+  \brief      Attach user callback function for master request frame
+  \details    Attach user callback function for master request frame. Callback functions are called by handler() after reception of a master request frame
+  \param[in]  ID        frame ID (protected or unprotected)
+  \param[in]  Fct       user callback function
+  \param[in]  NumData   number of frame data bytes (1..8)
+  \return     true if callback was registered, false if NumData or Fct is invalid or table is full
+*/
+bool LIN_Slave_Base::registerMasterRequestHandler(uint8_t ID, LIN_Slave_Base::LinMessageCallback Fct, uint8_t NumData)
+{  
+  // drop parity bits -> non-protected ID = 0..63
+  ID &= 0x3F;
+
+  // invalid frame length -> abort
+  if ((NumData < 1) || (NumData > 8))
+  {
+    // optional debug output (debug level 1)
+    #if defined(LIN_SLAVE_DEBUG_SERIAL) && (LIN_SLAVE_DEBUG_LEVEL >= 1)
+      LIN_SLAVE_DEBUG_SERIAL.print(this->nameLIN);
+      LIN_SLAVE_DEBUG_SERIAL.print(": LIN_Slave_Base::registerMasterRequestHandler()");
+      LIN_SLAVE_DEBUG_SERIAL.print(": invalid length ");
+      LIN_SLAVE_DEBUG_SERIAL.println(NumData);
+    #endif
+
+    return false;
+  }
+
+  // register user callback function for master request frame
+  if (!(this->_storeCallback(ID, LIN_Slave_Base::MASTER_REQUEST | NumData, Fct)))
+    return false;
+
+  // optional debug output (debug level 2)
+  #if defined(LIN_SLAVE_DEBUG_SERIAL) && (LIN_SLAVE_DEBUG_LEVEL >= 2)
+    LIN_SLAVE_DEBUG_SERIAL.print(this->nameLIN);
+    LIN_SLAVE_DEBUG_SERIAL.print(": LIN_Slave_Base::registerMasterRequestHandler()");
+    LIN_SLAVE_DEBUG_SERIAL.print(": registered ID 0x");
+    LIN_SLAVE_DEBUG_SERIAL.println(ID, HEX);
+  #endif
+
+  // callback was registered
+  return true;
+
+} // LIN_Slave_Base::registerMasterRequestHandler
+
+
+
+/**
+  \brief      Attach user callback function for slave response frame
+  \details    Attach user callback function for slave response frame. Callback functions are called by handler() after reception of a PID
+  \param[in]  ID        frame ID (protected or unprotected)
+  \param[in]  Fct       user callback function
+  \param[in]  NumData   number of frame data bytes (1..8)
+  \return     true if callback was registered, false if NumData or Fct is invalid or table is full
+*/
+bool LIN_Slave_Base::registerSlaveResponseHandler(uint8_t ID, LIN_Slave_Base::LinMessageCallback Fct, uint8_t NumData)
+{
+  // drop parity bits -> non-protected ID = 0..63
+  ID &= 0x3F;
+
+  // invalid frame length -> abort
+  if ((NumData < 1) || (NumData > 8))
+  {
+    // optional debug output (debug level 1)
+    #if defined(LIN_SLAVE_DEBUG_SERIAL) && (LIN_SLAVE_DEBUG_LEVEL >= 1)
+      LIN_SLAVE_DEBUG_SERIAL.print(this->nameLIN);
+      LIN_SLAVE_DEBUG_SERIAL.print(": LIN_Slave_Base::registerSlaveResponseHandler()");
+      LIN_SLAVE_DEBUG_SERIAL.print(": invalid length ");
+      LIN_SLAVE_DEBUG_SERIAL.println(NumData);
+    #endif
+
+    return false;
+  }
+
+  // register user callback function for slave response frame
+  if (!(this->_storeCallback(ID, LIN_Slave_Base::SLAVE_RESPONSE | NumData, Fct)))
+    return false;
+
+  // optional debug output (debug level 2)
+  #if defined(LIN_SLAVE_DEBUG_SERIAL) && (LIN_SLAVE_DEBUG_LEVEL >= 2)
+    LIN_SLAVE_DEBUG_SERIAL.print(this->nameLIN);
+    LIN_SLAVE_DEBUG_SERIAL.print(": LIN_Slave_Base::registerSlaveResponseHandler()");
+    LIN_SLAVE_DEBUG_SERIAL.print(": registered ID 0x");
+    LIN_SLAVE_DEBUG_SERIAL.println(ID, HEX);
+  #endif
+
+  // callback was registered
+  return true;
+
+} // LIN_Slave_Base::registerSlaveResponseHandler
+
+
+
+#if (LIN_SLAVE_FRAME_QUEUE > 0)
+  /**
+    \brief      Read oldest completed frame from queue
+    \details    Read oldest completed frame from queue (single consumer). Frames are stored by handler() incl. errors and timestamps,
+                independent of getFrame() and STATE_DONE, so back-to-back frames are not lost if the application is late.
+                Requires no interrupt lock: if the record was overwritten while copying (policy QUEUE_OVERWRITE_OLD), read is repeated.
+    \param[out] Frame   oldest completed frame
+    \return     true if a frame was read, false if queue is empty
+  */
+  bool LIN_Slave_Base::readFrame(LIN_Slave_Base::frame_record_t &Frame)
+  {
+    uint8_t   head, tail, depth, idx, seq;
+
+    // usable queue depth. For overwrite, the record at write index is reserved
+    depth = LIN_SLAVE_FRAME_QUEUE - ((this->queuePolicy == LIN_Slave_Base::QUEUE_OVERWRITE_OLD) ? 1 : 0);
+
+    do
+    {
+      // get current indices
+      head = this->queueHead;
+      tail = this->queueTail;
+
+      // queue empty
+      if (head == tail)
+        return false;
+
+      // oldest records were overwritten -> skip to oldest valid record
+      if ((uint8_t) (head - tail) > depth)
+        tail = (uint8_t) (head - depth);
+
+      // copy record between two reads of its sequence number
+      idx = tail & (LIN_SLAVE_FRAME_QUEUE-1);
+      seq = this->queueSeq[idx];
+      LIN_SLAVE_BARRIER();
+      memcpy(&Frame, (const void*) &(this->queue[idx]), sizeof(Frame));
+      LIN_SLAVE_BARRIER();
+
+    // repeat if record was written during copy or oldest records were overwritten meanwhile
+    } while ((seq & 0x01) || (seq != this->queueSeq[idx]) || ((uint8_t) (this->queueHead - tail) > depth));
+
+    // release record
+    this->queueTail = tail + 1;
+
+    // return success
+    return true;
+
+  } // LIN_Slave_Base::readFrame()
+
+
+
+  /**
+    \brief      Getter for number of lost frames
+    \details    Getter for number of frames lost due to full queue (saturating). Read without interrupt lock
+    \return     number of lost frames
+  */
+  uint16_t LIN_Slave_Base::getQueueOverflow(void)
+  {
+    uint16_t  num;
+
+    // read until consistent (16-bit access is not atomic on 8-bit CPUs)
+    do
+    {
+      num = this->queueOverflow;
+    } while (num != this->queueOverflow);
+
+    // return number of lost frames
+    return num;
+
+  } // LIN_Slave_Base::getQueueOverflow()
+#endif // LIN_SLAVE_FRAME_QUEUE
+
+
+
+#if (LIN_SLAVE_LOG_SIZE > 0)
+  /**
+    \brief      Read oldest entry from deferred log
+    \details    Read oldest entry from deferred log (single consumer). Events are stored by handler() with constant runtime
+                instead of blocking debug output, so logging doesn't affect LIN timing. Requires no interrupt lock
+    \param[out] Entry   oldest log entry
+    \return     true if an entry was read, false if log is empty
+  */
+  bool LIN_Slave_Base::readLog(LIN_Slave_Base::log_entry_t &Entry)
+  {
+    uint8_t   tail = this->logTail;
+
+    // log empty
+    if (tail == this->logHead)
+      return false;
+
+    // copy entry. Is not overwritten by handler() before release
+    LIN_SLAVE_BARRIER();
+    memcpy(&Entry, (const void*) &(this->logEntry[tail & (LIN_SLAVE_LOG_SIZE-1)]), sizeof(Entry));
+    LIN_SLAVE_BARRIER();
+
+    // release entry
+    this->logTail = tail + 1;
+
+    // return success
+    return true;
+
+  } // LIN_Slave_Base::readLog()
+
+
+
+  /**
+    \brief      Write log entry as binary record
+    \details    Write log entry as 8-byte binary record with fixed byte order:
+                LIN_SLAVE_LOG_MARKER, event, ID, data, time [us] (32-bit little endian)
+    \param[in]  Out     output stream, e.g. Serial
+    \param[in]  Entry   log entry to write
+  */
+  void LIN_Slave_Base::_writeLogEntry(Print &Out, const LIN_Slave_Base::log_entry_t &Entry)
+  {
+    uint8_t   buf[8];
+
+    // serialize record
+    buf[0] = LIN_SLAVE_LOG_MARKER;
+    buf[1] = (uint8_t) Entry.event;
+    buf[2] = Entry.id;
+    buf[3] = Entry.data;
+    buf[4] = (uint8_t) (Entry.time);
+    buf[5] = (uint8_t) (Entry.time >> 8);
+    buf[6] = (uint8_t) (Entry.time >> 16);
+    buf[7] = (uint8_t) (Entry.time >> 24);
+
+    // write record
+    Out.write(buf, 8);
+
+  } // LIN_Slave_Base::_writeLogEntry()
+
+
+
+  /**
+    \brief      Write entries of deferred log as binary records
+    \details    Write entries of deferred log as 8-byte binary records to an output, e.g. Serial, see _writeLogEntry(). 
+                Call from loop() or a low-priority task. If entries were lost, a LOG_LOST record is written after the logged entries.
+                Decode on PC via extras/logging/decode_log.py
+    \param[in]  Out         output stream, e.g. Serial
+    \param[in]  MaxEntries  max. number of entries to write in this call, e.g. to limit blocking on full Tx buffer (default = 255)
+    \return     number of written entries
+  */
+  uint8_t LIN_Slave_Base::drainLog(Print &Out, uint8_t MaxEntries)
+  {
+    LIN_Slave_Base::log_entry_t   entry;
+    uint8_t                       numEntries = 0;
+
+    // write logged entries one by one
+    while ((numEntries < MaxEntries) && (this->readLog(entry)))
+    {
+      LIN_Slave_Base::_writeLogEntry(Out, entry);
+      numEntries++;
+    }
+
+    // newer entries were lost -> write number of lost entries. For data consistency temporarily disable ISRs
+    if ((numEntries < MaxEntries) && (this->logLost != 0))
+    {
+      noInterrupts();
+      entry.data = this->logLost;
+      this->logLost = 0;
+      interrupts();
+      entry.event = LIN_Slave_Base::LOG_LOST;
+      entry.id    = 0x00;
+      entry.time  = micros();
+      LIN_Slave_Base::_writeLogEntry(Out, entry);
+      numEntries++;
+    }
+
+    // return number of written entries
+    return numEntries;
+
+  } // LIN_Slave_Base::drainLog()
+#endif // LIN_SLAVE_LOG_SIZE
+
+
+
+#if defined(LIN_SLAVE_STATISTICS)
+  /**
+    \brief      Getter for timing histogram
+    \details    Copy timing histogram with log2 bins: bin 0 = 0us, bin k = 2^(k-1)..2^k-1 us, last bin also counts larger times.
+                Counters saturate at 0xFFFF, see resetStatistics()
+    \param[in]  Type        statistics to read, see statistics_t
+    \param[out] Histogram   copy of histogram
+  */
+  void LIN_Slave_Base::getHistogram(LIN_Slave_Base::statistics_t Type, LIN_Slave_Base::histogram_t &Histogram)
+  {
+    // invalid statistics -> return empty histogram
+    if (Type >= LIN_Slave_Base::STAT_NUM)
+    {
+      memset(&Histogram, 0, sizeof(Histogram));
+      return;
+    }
+
+    // copy histogram. For data consistency temporarily disable ISRs
+    noInterrupts();
+    memcpy(&Histogram, &(this->histogram[Type]), sizeof(Histogram));
+    interrupts();
+
+  } // LIN_Slave_Base::getHistogram()
+
+
+
+  /**
+    \brief      Getter for max. callback execution time of an ID
+    \details    Getter for max. execution time [us] of callback function for a frame ID (saturating)
+    \param[in]  ID    frame ID (protected or unprotected)
+    \return     max. callback execution time [us]
+  */
+  uint16_t LIN_Slave_Base::getCallbackTimeMax(uint8_t ID)
+  {
+    uint16_t  time;
+
+    // read time. For data consistency temporarily disable ISRs
+    noInterrupts();
+    time = this->timeCallbackMax[ID & 0x3F];
+    interrupts();
+
+    // return max. time
+    return time;
+
+  } // LIN_Slave_Base::getCallbackTimeMax()
+
+
+
+  /**
+    \brief      Reset all timing statistics
+    \details    Clear all timing histograms and max. callback times per ID
+  */
+  void LIN_Slave_Base::resetStatistics(void)
+  {
+    // clear statistics. For data consistency temporarily disable ISRs
+    noInterrupts();
+    memset(this->histogram, 0, sizeof(this->histogram));
+    memset(this->timeCallbackMax, 0, sizeof(this->timeCallbackMax));
+    interrupts();
+
+  } // LIN_Slave_Base::resetStatistics()
+#endif // LIN_SLAVE_STATISTICS
+
+
+
+#if defined(LIN_SLAVE_ID_COUNTERS)
+  /**
+    \brief      Getter for traffic and error counters of a frame ID
+    \details    Copy saturating counters of frames without error, checksum, echo, PID and timeout errors, plus health of a frame ID.
+                Health is a moving average of frame success (255=all ok, 0=all failed), i.e. decreases on recurring errors
+    \param[in]  ID          frame ID (protected or unprotected)
+    \param[out] Counters    copy of counters
+  */
+  void LIN_Slave_Base::getCounters(uint8_t ID, LIN_Slave_Base::id_counters_t &Counters)
+  {
+    // copy counters. For data consistency temporarily disable ISRs
+    noInterrupts();
+    memcpy(&Counters, &(this->counterID[ID & 0x3F]), sizeof(Counters));
+    interrupts();
+
+  } // LIN_Slave_Base::getCounters()
+
+
+
+  /**
+    \brief      Getter for bus level counters
+    \details    Copy counters of received bytes, BREAKs, SYNC errors, timeouts before PID and frames with unregistered ID
+    \param[out] Counters    copy of counters
+  */
+  void LIN_Slave_Base::getBusCounters(LIN_Slave_Base::bus_counters_t &Counters)
+  {
+    // copy counters. For data consistency temporarily disable ISRs
+    noInterrupts();
+    memcpy(&Counters, &(this->counterBus), sizeof(Counters));
+    interrupts();
+
+  } // LIN_Slave_Base::getBusCounters()
+
+
+
+  /**
+    \brief      Reset all traffic and error counters
+    \details    Clear counters of all frame IDs and bus level counters. Health of all IDs is set to 255 (=all ok)
+  */
+  void LIN_Slave_Base::resetCounters(void)
+  {
+    // clear counters. For data consistency temporarily disable ISRs
+    noInterrupts();
+    memset(this->counterID, 0, sizeof(this->counterID));
+    for (uint8_t i=0; i<64; i++)
+      this->counterID[i].health = 255;
+    memset(&(this->counterBus), 0, sizeof(this->counterBus));
+    interrupts();
+
+  } // LIN_Slave_Base::resetCounters()
+#endif // LIN_SLAVE_ID_COUNTERS
+
+
+
+#if (LIN_SLAVE_NUM_RESPONSES > 0)
+  /**
+    \brief      Publish slave response data for an ID
+    \details    Publish slave response data for an ID. On reception of the PID the data is sent directly, without calling a callback function.
+                Data is stored in the inactive buffer of a double buffer incl. checksum, so it can be called anytime. 
+                The new data becomes active immediately, or together with other IDs on commitPublish() if called after beginPublish().
+                Published responses take precedence over a registered slave response callback for the same ID.
+    \param[in]  ID        frame ID (protected or unprotected)
+    \param[in]  Data      response data bytes
+    \param[in]  NumData   number of data bytes (1..8)
+    \return     true on success, false if no free slot or invalid length
+  */
+  bool LIN_Slave_Base::publishResponse(uint8_t ID, const uint8_t Data[], uint8_t NumData)
+  {
+    uint8_t   idx, idxBuf;
+
+    // drop parity bits -> non-protected ID = 0..63
+    ID &= 0x3F;
+
+    // assert valid frame length
+    if ((NumData < 1) || (NumData > 8))
+      return false;
+
+    // find slot of this ID or a free slot
+    idx = this->_findResponse(ID);
+    if (idx >= LIN_SLAVE_NUM_RESPONSES)
+      idx = this->_findResponse(0xFF);
+    if (idx >= LIN_SLAVE_NUM_RESPONSES)
+      return false;
+
+    // write data and checksum to inactive buffer. Active buffer may be sent in parallel
+    idxBuf = (this->generation & 0x01) ^ 0x01;
+    memcpy(this->response[idx].buf[idxBuf], Data, NumData);
+    this->response[idx].buf[idxBuf][NumData] = this->_calculateChecksum(NumData, this->response[idx].buf[idxBuf], this->_calculatePID(ID));
+    this->response[idx].numData[idxBuf] = NumData;
+    LIN_SLAVE_BARRIER();
+
+    // mark slot as updated. A new slot is ignored by handler() until commit (active length = 0), i.e. clear length before ID
+    if (this->response[idx].id != ID)
+    {
+      this->response[idx].numData[idxBuf ^ 0x01] = 0;
+      LIN_SLAVE_BARRIER();
+      this->response[idx].id = ID;
+    }
+    this->maskPending |= (uint8_t) (0x01 << idx);
+
+    // activate immediately, if no publish transaction is open
+    if (this->flagPublish == false)
+      this->commitPublish();
+
+    // optional debug output (debug level 2)
+    #if defined(LIN_SLAVE_DEBUG_SERIAL) && (LIN_SLAVE_DEBUG_LEVEL >= 2)
+      LIN_SLAVE_DEBUG_SERIAL.print(this->nameLIN);
+      LIN_SLAVE_DEBUG_SERIAL.print(": LIN_Slave_Base::publishResponse()");
+      LIN_SLAVE_DEBUG_SERIAL.print(": published ID 0x");
+      LIN_SLAVE_DEBUG_SERIAL.println(ID, HEX);
+    #endif
+
+    // return success
+    return true;
+
+  } // LIN_Slave_Base::publishResponse()
+
+
+
+  /**
+    \brief      Activate all slave responses published since beginPublish() at once
+    \details    Activate all slave responses published since beginPublish() at once by toggling the active buffer of all slots
+                via a single byte write. Therefore no interrupt lock is required, and a PID always sees a consistent snapshot.
+                Afterwards the new data is copied to the now inactive buffers, to keep both buffers in sync for the next publish.
+  */
+  void LIN_Slave_Base::commitPublish(void)
+  {
+    uint8_t   idxBuf;
+
+    // toggle active buffer of all slots (atomic byte write), after all writes to inactive buffers
+    LIN_SLAVE_BARRIER();
+    this->generation = this->generation + 1;
+    idxBuf = this->generation & 0x01;
+
+    // sync now inactive buffers of updated slots with new data
+    for (uint8_t idx = 0; idx < LIN_SLAVE_NUM_RESPONSES; idx++)
+    {
+      if (this->maskPending & (uint8_t) (0x01 << idx))
+      {
+        this->response[idx].numData[idxBuf ^ 0x01] = this->response[idx].numData[idxBuf];
+        memcpy(this->response[idx].buf[idxBuf ^ 0x01], this->response[idx].buf[idxBuf], this->response[idx].numData[idxBuf]+1);
+      }
+    }
+
+    // close transaction
+    this->maskPending = 0x00;
+    this->flagPublish = false;
+
+  } // LIN_Slave_Base::commitPublish()
+#endif // LIN_SLAVE_NUM_RESPONSES
+
+
+
+/**
+  \brief      Handle frame timeout
+  \details    Abort current frame on frame timeout or on receive timeout between bytes. Is called by handler(), or
+              from receive ISR before handling the next byte or BREAK, see _handleReceiveISR().
+              Rx buffer is not flushed, as the check is skipped while a byte is pending. Late bytes of the aborted frame are
+              ignored in STATE_DONE until the next BREAK
+  \param[in]  FlagPending   a received byte is pending in Rx buffer -> skip timeout check, as handler() may be late
+  \param[in]  TimeNow       current time [us], e.g. receive time of next byte in ISR
+*/
+void LIN_Slave_Base::_handleTimeout(bool FlagPending, uint32_t TimeNow)
+{
+  // on frame timeout or receive timeout [us] within frame abort frame. Check only if no byte is pending, as handler() may be late
+  if ((this->state & (LIN_Slave_Base::STATE_WAIT_FOR_SYNC | LIN_Slave_Base::STATE_WAIT_FOR_PID | LIN_Slave_Base::STATE_RECEIVING_DATA | 
+    LIN_Slave_Base::STATE_RECEIVING_ECHO | LIN_Slave_Base::STATE_WAIT_FOR_CHK)) && (!FlagPending) &&
+    (((TimeNow - this->timeFrameStart) > this->timeoutFrame) || ((TimeNow - this->timeLastRx) > this->timeoutRx)))
+  {
+    // monitor mode: end of frame with unknown length -> evaluate frame instead of timeout error
+    if ((this->flagMonitor) && (this->state == LIN_Slave_Base::STATE_RECEIVING_DATA))
+    {
+      this->_monitorFrame();
+      return;
+    }
+
+    // frame header found by resync without PID -> was no frame, discard silently and continue search
+    if (this->scoreResync != 0)
+    {
+      this->scoreResync = 0;
+      this->state = LIN_Slave_Base::STATE_WAIT_FOR_BREAK;
+      return;
+    }
+
+    // set error and abort frame. Store frame only if ID is already known
+    this->_setError(LIN_Slave_Base::ERROR_TIMEOUT);
+    this->_log(LIN_Slave_Base::LOG_TIMEOUT, (uint8_t) this->state, TimeNow);
+    if (this->state & (LIN_Slave_Base::STATE_RECEIVING_DATA | LIN_Slave_Base::STATE_RECEIVING_ECHO | LIN_Slave_Base::STATE_WAIT_FOR_CHK))
+      this->_pushFrame();
+    #if defined(LIN_SLAVE_ID_COUNTERS)
+      else
+        LIN_Slave_Base::_countInc(this->counterBus.timeout, 1);
+    #endif
+    this->state = LIN_Slave_Base::STATE_DONE;
+
+    // optionally disable RS485 transmitter
+    _disableTransmitter();
+
+    // optional debug output (debug level 1)
+    #if defined(LIN_SLAVE_DEBUG_SERIAL) && (LIN_SLAVE_DEBUG_LEVEL >= 1)
+      LIN_SLAVE_DEBUG_SERIAL.print(this->nameLIN);
+      LIN_SLAVE_DEBUG_SERIAL.print(": LIN_Slave_Base::_handleTimeout()");
+      LIN_SLAVE_DEBUG_SERIAL.print(": error: frame timeout after ");
+      LIN_SLAVE_DEBUG_SERIAL.print((long) (TimeNow - this->timeFrameStart));
+      LIN_SLAVE_DEBUG_SERIAL.println("us");
+    #endif
+
+  } // if frame receive timeout
+
+} // LIN_Slave_Base::_handleTimeout()
+
+
+
+/**
+  \brief      Handle a received byte or BREAK in receive ISR
+  \details    Handle a received byte or BREAK directly in receive ISR, i.e. LIN state machine doesn't run in handler().
+              Frame timeout is then checked here with the receive time of the new byte, before handling it. This keeps all
+              accesses to frame state, frame queue and log in ISR context, i.e. handler() never races with the ISR.
+              Consequently a truncated frame is aborted (and queued and logged) when the next byte or BREAK is received
+  \param[in]  byteReceived  received byte. Is ignored for BREAK
+  \param[in]  FlagBreak     byte is a BREAK, e.g. 0x00 with framing error
+  \param[in]  TimeReceived  time [us] of reception, captured in ISR
+*/
+void LIN_Slave_Base::_handleReceiveISR(uint8_t byteReceived, bool FlagBreak, uint32_t TimeReceived)
+{
+  // interface closed or baudrate is re-configured by handler(), see _handleAutoBaud() -> ignore byte
+  if (this->state == LIN_Slave_Base::STATE_OFF)
+    return;
+
+  // abort current frame on timeout. Byte is handled in ISR, i.e. is never pending
+  this->_handleTimeout(false, TimeReceived);
+
+  // start new frame or handle byte
+  if (FlagBreak)
+    this->_handleBreak(TimeReceived);
+  else
+    this->_handleByte(byteReceived, TimeReceived);
+
+} // LIN_Slave_Base::_handleReceiveISR()
+
+
+
+/**
+  \brief      Handle LIN protocol and call user-defined frame callback functions
+  \details    Handle LIN protocol and call user-defined frame callback functions, both for slave request and slave response frames
+*/
+void LIN_Slave_Base::handler()
+{
+  // handle LIN protocol, serial interface methods are called via vtable
+  this->_handlerCore(LIN_Slave_Base::virtual_binding_t{*this});
+
+} // LIN_Slave_Base::handler
+
+
+
+/**
+  \brief      Get wrap-safe 64-bit time [us]
+  \details    Extend 32-bit micros() to 64 bit by counting wrap-arounds. Is interrupt-safe.
+              Requires a call at least every 71 minutes, which is done by handler()
+  \return     time [us] since start
+*/
+uint64_t LIN_Slave_Base::getMicros64()
+{
+  uint32_t  timeNow;
+  uint64_t  time64;
+
+  // for data consistency temporarily disable ISRs. On AVR restore previous state -> also callable from ISR
+  #if defined(__AVR__)
+    uint8_t   sreg = SREG;
+  #endif
+  noInterrupts();
+
+  // on wrap-around of micros() increment upper 32 bit
+  timeNow = micros();
+  if (timeNow < LIN_Slave_Base::timeLow)
+    (LIN_Slave_Base::timeHigh)++;
+  LIN_Slave_Base::timeLow = timeNow;
+  time64 = (((uint64_t) LIN_Slave_Base::timeHigh) << 32) | (uint64_t) timeNow;
+
+  // restore ISRs
+  #if defined(__AVR__)
+    SREG = sreg;
+  #else
+    interrupts();
+  #endif
+
+  // return 64-bit time
+  return time64;
+
+} // LIN_Slave_Base::getMicros64()
+
+
+
+/**
+  \brief      Convert a past 32-bit timestamp [us] to 64-bit
+  \details    Convert a 32-bit timestamp from micros() to 64-bit time. Timestamp must be less than 71 minutes old
+  \param[in]  Time    timestamp [us] from micros()
+  \return     64-bit timestamp [us], see getMicros64()
+*/
+uint64_t LIN_Slave_Base::_toMicros64(uint32_t Time)
+{
+  uint64_t  timeNow = LIN_Slave_Base::getMicros64();
+
+  // subtract age of timestamp. Unsigned 32-bit difference is wrap-safe
+  return timeNow - (uint64_t) ((uint32_t) timeNow - Time);
+
+} // LIN_Slave_Base::_toMicros64()
+
+
+
+/**
+  \brief      Call handler() of all opened LIN instances
+  \details    Call handler() once for each LIN instance opened via begin(). To serve all instances fairly, the instance
+              which is serviced first is rotated with each call. Allows running several LIN slaves from one call in loop()
+*/
+void LIN_Slave_Base::serviceAll()
+{
+  LIN_Slave_Base  *pStart;
+  LIN_Slave_Base  *pInstance;
+
+  // no instance opened -> nothing to do
+  if (LIN_Slave_Base::pFirstInstance == nullptr)
+    return;
+
+  // start with next instance in round-robin order
+  pStart = (LIN_Slave_Base::pNextService != nullptr) ? LIN_Slave_Base::pNextService : LIN_Slave_Base::pFirstInstance;
+
+  // advance round-robin start for next call
+  LIN_Slave_Base::pNextService = pStart->pNextInstance;
+
+  // service all instances once, wrap around at end of list
+  pInstance = pStart;
+  do
+  {
+    pInstance->handler();
+    pInstance = (pInstance->pNextInstance != nullptr) ? pInstance->pNextInstance : LIN_Slave_Base::pFirstInstance;
+  } while (pInstance != pStart);
+
+} // LIN_Slave_Base::serviceAll()
+
+
+
+/**
+  \brief      Handle all pending Rx bytes, stop after a completed frame
+  \details    Handle all bytes currently available in the Rx buffer by repeatedly calling handler(). This allows calling
+              the handler less often than once per byte, e.g. from a slower task, without overflowing the Rx buffer.
+              BREAK detection and state transitions are handled between bytes as for single calls.
+              Processing stops when a frame is completed (-> STATE_DONE), so that the application can read it via getFrame().
+              Note: for sync on inter-frame pause (HardwareSerial, SoftwareSerial) the pause is measured at handling time.
+              Therefore the Rx buffer must be drained before the next BREAK arrives.
+  \param[in]  MaxBytes  max. number of bytes to handle in this call (default = 255)
+  \return     number of handled bytes
+*/
+uint8_t LIN_Slave_Base::handlerDrain(uint8_t MaxBytes)
+{
+  // handle pending bytes via handler(), which is called via vtable
+  return this->_handlerDrainCore(LIN_Slave_Base::virtual_binding_t{*this}, MaxBytes);
+
+} // LIN_Slave_Base::handlerDrain
 
 /*-----------------------------------------------------------------------------
     END OF FILE
@@ -21,6 +21,90 @@
 // misc parameters
 #define LIN_SLAVE_BUFLEN_NAME   30            //!< max. length of node name
 
+// store only pointer to node name instead of a copy -> saves LIN_SLAVE_BUFLEN_NAME bytes RAM. Name string must be static, e.g. a literal
+//#define LIN_SLAVE_NAME_POINTER
+
+// max. number of registered frames. Use 0 for a table of all 64 IDs (3B/ID on AVR, 8B/ID on 32-bit), else a sparse table (17B + 3B/8B per frame)
+#if !defined(LIN_SLAVE_MAX_FRAMES)
+  #define LIN_SLAVE_MAX_FRAMES      0         //!< max. number of registered frames (0=all 64 IDs, or 1..63)
+#endif
+#if (LIN_SLAVE_MAX_FRAMES > 63)
+  #error LIN_SLAVE_MAX_FRAMES must be 0..63
+#endif
+
+// number of slots for pre-published slave responses, see publishResponse(). Each slot requires 21B RAM. Use 0 to disable
+#if !defined(LIN_SLAVE_NUM_RESPONSES)
+  #define LIN_SLAVE_NUM_RESPONSES   0         //!< max. number of pre-published slave responses (0..8)
+#endif
+#if (LIN_SLAVE_NUM_RESPONSES > 8)
+  #error LIN_SLAVE_NUM_RESPONSES must be 0..8
+#endif
+
+// depth of queue for completed frames, see readFrame(). Each entry requires sizeof(frame_record_t)+1 = 37B (AVR) or 41B (32-bit) RAM. Use 0 to disable
+#if !defined(LIN_SLAVE_FRAME_QUEUE)
+  #define LIN_SLAVE_FRAME_QUEUE     0         //!< number of queued frames (0 or power of 2 up to 64)
+#endif
+#if (LIN_SLAVE_FRAME_QUEUE > 64) || ((LIN_SLAVE_FRAME_QUEUE & (LIN_SLAVE_FRAME_QUEUE-1)) != 0)
+  #error LIN_SLAVE_FRAME_QUEUE must be 0 or a power of 2 up to 64
+#endif
+
+// candidate baudrates for auto-baud detection, see setAutoBaud(). First is used after enabling
+#if !defined(LIN_SLAVE_AUTOBAUD_RATES)
+  #define LIN_SLAVE_AUTOBAUD_RATES    19200, 10417, 9600      //!< comma separated list of candidate baudrates [Baud]
+#endif
+#define LIN_SLAVE_AUTOBAUD_RETRY      3                       //!< number of consecutive SYNC/PID errors to re-start detection after lock
+#define LIN_SLAVE_AUTOBAUD_TIMEOUT    100000L                 //!< time [us] with bus activity but no valid frame to try next baudrate
+
+// timing parameters in constructor (e.g. TimeoutRx) are given in [us] at this baudrate and are stored in bit times,
+// i.e. they scale with the actual baudrate
+#define LIN_SLAVE_TIMING_BAUDRATE     19200L                  //!< reference baudrate [Baud] for timing parameters in [us]
+
+// timing parameters are derived by division by baudrate -> lower baudrates (incl. 0) are clamped in begin() and setFastMode()
+#define LIN_SLAVE_MIN_BAUDRATE        1000L                   //!< min. baudrate [Baud], see LIN2.x spec
+
+// default baudrate for fast mode, see setFastMode()
+#if !defined(LIN_SLAVE_FAST_BAUDRATE)
+  #define LIN_SLAVE_FAST_BAUDRATE     115200L                 //!< fast mode baudrate [Baud], e.g. for flashing
+#endif
+
+// resynchronization on bytes in STATE_WAIT_FOR_BREAK, e.g. after a missed BREAK or a SYNC/PID error. A 0x55 starts a frame header
+// if its evidence score reaches LIN_SLAVE_RESYNC_SCORE, and is confirmed by a valid PID. Weights: 0x55 = 2, preceding 0x00 = 1,
+// pause before 0x00 or 0x55 = 1 each. Default requires a pause, as 0x00 0x55 may also occur in (back-to-back) data bytes
+#if !defined(LIN_SLAVE_RESYNC_SCORE)
+  #define LIN_SLAVE_RESYNC_SCORE      4                       //!< min. score for resynchronization (max. 5). Use 6 to disable
+#endif
+#define LIN_SLAVE_RESYNC_PAUSE        13                      //!< min. time [bit times] between receive of 2 bytes to count as pause (back-to-back = 10, BREAK->SYNC >= 14)
+
+// clock trim to master SYNC field, see setClockTrim()
+#define LIN_SLAVE_CLOCK_FILTER        3                       //!< IIR filter of measured byte period, weight of new value = 1/2^N (max. 4)
+#define LIN_SLAVE_CLOCK_HYSTERESIS    7                       //!< re-configure UART only if trimmed baudrate changes by >1/2^N
+
+// compiler memory barrier. Orders record accesses relative to indices of lock-free queues (see readFrame(), readLog()), and response data
+// relative to activation of published responses (see publishResponse())
+#define LIN_SLAVE_BARRIER()       __asm__ __volatile__ ("" ::: "memory")
+
+// storage class of static library state (instance list, 64-bit time). Host builds with one simulated cluster per thread
+// define it as thread_local, see extras/simulator. Default is empty, i.e. process-global like on single-core targets
+#if !defined(LIN_SLAVE_THREAD_LOCAL)
+  #define LIN_SLAVE_THREAD_LOCAL
+#endif
+
+// depth of ring buffer for deferred binary event log, see drainLog(). Each entry requires 7B RAM (AVR). Use 0 to disable
+#if !defined(LIN_SLAVE_LOG_SIZE)
+  #define LIN_SLAVE_LOG_SIZE        0         //!< number of log entries (0 or power of 2 up to 128)
+#endif
+#if (LIN_SLAVE_LOG_SIZE > 128) || ((LIN_SLAVE_LOG_SIZE & (LIN_SLAVE_LOG_SIZE-1)) != 0)
+  #error LIN_SLAVE_LOG_SIZE must be 0 or a power of 2 up to 128
+#endif
+#define LIN_SLAVE_LOG_MARKER      0xA5        //!< first byte of each record written by drainLog()
+
+// optionally collect timing statistics in log2 histograms, see getHistogram(). Requires 4*34B + 128B RAM
+//#define LIN_SLAVE_STATISTICS
+#define LIN_SLAVE_STAT_BINS       16          //!< number of histogram bins. Bin 0 = 0us, bin k = 2^(k-1)..2^k-1 us, last bin is open
+
+// optionally count frames and errors per ID and on bus level, see getCounters(). Requires 64*7B + 10B RAM (AVR)
+//#define LIN_SLAVE_ID_COUNTERS
+
 // required for CI test environment. Call arduino-cli with "-DINCLUDE_NEOHWSERIAL"
 #if defined(INCLUDE_NEOHWSERIAL)
   #include <NeoHWSerial.h>
@@ -44,6 +128,9 @@
 // generic Arduino functions
 #include <Arduino.h>
 
+// LIN protocol kernel (PID, checksum)
+#include "LIN_slave_Protocol.h"
+
 
 /*-----------------------------------------------------------------------------
   GLOBAL CLASS
@@ -71,7 +158,9 @@ class LIN_Slave_Base
     typedef enum : uint8_t
     {
       MASTER_REQUEST        = 0x10,             //!< LIN master request frame
-      SLAVE_RESPONSE        = 0x20              //!< LIN slave response frame
+      SLAVE_RESPONSE        = 0x20,             //!< LIN slave response frame
+      MONITOR_CLASSIC       = 0x40,             //!< frame captured in monitor mode with classic checksum, see setMonitorMode()
+      MONITOR_ENHANCED      = 0x80              //!< frame captured in monitor mode with enhanced checksum, see setMonitorMode()
     } frame_t;
 
 
@@ -103,11 +192,132 @@ class LIN_Slave_Base
     } error_t;
 
 
+    /// Type for frame callback function
+    typedef void (*LinMessageCallback)(uint8_t numData, uint8_t* data);
+
+
+    /// Entry of compile-time frame table, see attachFrameTable()
+    typedef struct
+    {
+      uint8_t                 id;               //!< frame ID (unprotected)
+      uint8_t                 type_numData;     //!< frame type (high nibble) and number of data bytes (low nibble)
+      LinMessageCallback      fct;              //!< frame callback function
+    } frame_entry_t;
+
+    /// Index of compile-time frame table by ID, see makeFrameIndex() and attachFrameTable()
+    typedef struct
+    {
+      uint8_t                 idx[64];          //!< index in frame table per ID, 0xFF = ID not in table
+    } frame_index_t;
+
+
+
+    /// Completed LIN frame as stored in frame queue, see readFrame()
+    typedef struct
+    {
+      uint8_t                 id;               //!< frame ID (unprotected)
+      LIN_Slave_Base::frame_t type;             //!< frame type (master request or slave response)
+      uint8_t                 numData;          //!< number of data bytes
+      uint8_t                 data[8];          //!< frame data bytes
+      LIN_Slave_Base::error_t error;            //!< errors of this frame
+      uint64_t                timeStart;        //!< time [us] of BREAK, see getMicros64()
+      uint64_t                timePID;          //!< time [us] of PID reception
+      uint64_t                timeEnd;          //!< time [us] of frame end
+    } frame_record_t;
+
+
+    /// Behavior of frame queue if full
+    typedef enum : uint8_t
+    {
+      QUEUE_DROP_NEW        = 0,                //!< keep unread frames, drop new frame
+      QUEUE_OVERWRITE_OLD   = 1                 //!< overwrite oldest unread frame. Usable depth is reduced by 1
+    } queue_policy_t;
+
+
+    /// Type for monitor callback function, see setMonitorMode()
+    typedef void (*LinMonitorCallback)(const LIN_Slave_Base::frame_record_t &Frame);
+
+
+    /// Event codes of deferred log, see readLog() and drainLog(). Keep in sync with extras/logging/decode_log.py
+    typedef enum : uint8_t
+    {
+      LOG_BREAK             = 0x01,             //!< BREAK detected. Data = 0x00
+      LOG_SYNC_ERROR        = 0x02,             //!< invalid SYNC. Data = received byte
+      LOG_PID_ERROR         = 0x03,             //!< PID parity error. Data = received PID
+      LOG_IGNORE            = 0x04,             //!< frame ID not registered. Data = PID
+      LOG_REQUEST           = 0x05,             //!< start receiving master request. Data = number of data bytes
+      LOG_RESPONSE          = 0x06,             //!< slave response sent. Data = number of data bytes
+      LOG_ECHO_ERROR        = 0x07,             //!< slave response echo error. Data = received byte
+      LOG_CHK_ERROR         = 0x08,             //!< checksum error. Data = received checksum
+      LOG_FRAME_OK          = 0x09,             //!< frame completed without error. Data = number of data bytes
+      LOG_TIMEOUT           = 0x0A,             //!< frame timeout. Data = state of LIN state machine
+      LOG_LOST              = 0x0B,             //!< log entries lost due to full buffer. Data = number of lost entries (saturating)
+      LOG_RESYNC            = 0x0C              //!< frame header found without BREAK, see LIN_SLAVE_RESYNC_SCORE. Data = evidence score
+    } log_event_t;
+
+
+    /// Entry of deferred log, see readLog()
+    typedef struct
+    {
+      LIN_Slave_Base::log_event_t event;        //!< event code
+      uint8_t                 id;               //!< frame ID (unprotected). Is ID of previous frame for LOG_BREAK and LOG_SYNC_ERROR
+      uint8_t                 data;             //!< event specific data, see log_event_t
+      uint32_t                time;             //!< time [us] of event, from micros()
+    } log_entry_t;
+
+
+    /// Timing statistics, see getHistogram()
+    typedef enum : uint8_t
+    {
+      STAT_LATENCY          = 0,                //!< time [us] from PID reception to first Tx byte of slave response, incl. delay until handler() call
+      STAT_HANDLER          = 1,                //!< execution time [us] of handling one received byte incl. callback
+      STAT_CALLBACK         = 2,                //!< execution time [us] of user callback functions (all IDs)
+      STAT_GAP              = 3,                //!< time [us] between received bytes of a frame, starting with BREAK. Based on receive times, see _getReceiveTime()
+      STAT_NUM              = 4                 //!< number of statistics
+    } statistics_t;
+
+
+    /// Log2 histogram of times [us], see getHistogram()
+    typedef struct
+    {
+      uint16_t                count[LIN_SLAVE_STAT_BINS];   //!< number of samples per bin (saturating)
+      uint16_t                max;              //!< max. time [us] (saturating)
+    } histogram_t;
+
+
+    /// Traffic and error counters of a frame ID, see getCounters(). Counters are saturating
+    typedef struct
+    {
+      uint16_t                ok;               //!< number of frames without error
+      uint8_t                 chk;              //!< number of checksum errors
+      uint8_t                 echo;             //!< number of slave response echo errors
+      uint8_t                 pid;              //!< number of PID parity errors. Note: ID is taken from received, i.e. corrupted PID
+      uint8_t                 timeout;          //!< number of timeouts after PID
+      uint8_t                 health;           //!< moving average of frame success with weight 1/8 (255=all ok, 0=all failed)
+    } id_counters_t;
+
+
+    /// Bus level counters, see getBusCounters(). Counters are saturating, except number of bytes
+    typedef struct
+    {
+      uint32_t                bytes;            //!< number of received bytes (free running)
+      uint16_t                breaks;           //!< number of detected BREAKs
+      uint16_t                sync;             //!< number of SYNC errors
+      uint16_t                timeout;          //!< number of timeouts before PID
+      uint16_t                other;            //!< number of frames with unregistered ID, e.g. for other slaves
+      uint16_t                resync;           //!< number of frame headers found by resynchronization, i.e. without BREAK
+    } bus_counters_t;
+
+
   // PROTECTED TYPEDEFS
   protected:
 
-    /// Type for frame callback function
-    typedef void (*LinMessageCallback)(uint8_t numData, uint8_t* data);
+    /// Compile-time sequence of IDs for makeFrameIndex(), like std::index_sequence (C++14)
+    template <uint8_t... I> struct id_sequence_t {};
+
+    /// Generate id_sequence_t<0,..,N-1> via recursion
+    template <uint8_t N, uint8_t... I> struct id_range_t : id_range_t<N-1, N-1, I...> {};
+    template <uint8_t... I> struct id_range_t<0, I...> { typedef id_sequence_t<I...> type; };
 
     /// User-defined callback function with data length
     typedef struct
@@ -116,18 +326,79 @@ class LIN_Slave_Base
       LinMessageCallback      fct;              //!< frame callback function
     } callback_t;
 
+    /// Pre-published slave response. Double-buffered, active buffer is selected by bit 0 of generation counter
+    typedef struct
+    {
+      uint8_t                 id;               //!< frame ID (0xFF = slot unused)
+      uint8_t                 numData[2];       //!< number of data bytes for each buffer
+      uint8_t                 buf[2][9];        //!< data bytes (max. 8B) + precomputed checksum
+    } response_t;
+
+    /// Binding of serial interface for _handlerCore() and _handlerDrainCore(). Calls methods via vtable, see LIN_Slave_Static for static binding
+    struct virtual_binding_t
+    {
+      LIN_Slave_Base          &node;            //!< LIN node
+
+      static const bool       flagHandlerISR = false; //!< LIN state machine runs in receive ISR, i.e. not in handler()
+
+      inline bool available(void) { return this->node.available(); }               //!< check if a byte is available in Rx buffer
+      inline bool getBreakFlag(void) { return this->node._getBreakFlag(); }        //!< get break detection flag
+      inline void resetBreakFlag(void) { this->node._resetBreakFlag(); }           //!< clear break detection flag
+      inline uint8_t read(void) { return this->node._serialRead(); }               //!< read next byte from Rx buffer
+      inline uint32_t receiveTime(void) { return this->node._getReceiveTime(); }   //!< receive time [us] of next byte in Rx buffer
+      inline void handler(void) { this->node.handler(); }                          //!< handle one byte incl. BREAK detection
+    };
+
 
   // PROTECTED VARIABLES
   protected:
 
     // node properties
     int8_t                    pinTxEN;          //!< optional Tx direction pin, e.g. for LIN via RS485 
-    uint16_t                  baudrate;         //!< communication baudrate [Baud]
+    uint32_t                  baudrate;         //!< communication baudrate [Baud]
+    uint32_t                  baudrateNormal;   //!< baudrate [Baud] to restore after fast mode
+    bool                      flagFastMode;     //!< fast mode active, see setFastMode()
     LIN_Slave_Base::version_t version;          //!< LIN protocol version
     LIN_Slave_Base::state_t   state;            //!< status of LIN state machine
     LIN_Slave_Base::error_t   error;            //!< error state. Is latched until cleared
-    bool                      flagBreak;        //!< flag for BREAK detected. Needs to be set in Rx-ISR 
-    LIN_Slave_Base::callback_t  callback[64];   //!< array of user callback functions for IDs 0x00..0x3F
+    volatile bool             flagBreak;        //!< flag for BREAK detected. Is set by derived class, e.g. in Rx-ISR
+
+    // auto-baud detection
+    bool                      flagAutoBaud;     //!< auto-baud detection enabled, see setAutoBaud()
+    bool                      flagBaudLocked;   //!< baudrate is confirmed by valid SYNC and PID
+    volatile bool             flagBaudNext;     //!< switch to next candidate baudrate in handler()
+    uint8_t                   idxBaud;          //!< index of current candidate baudrate
+    uint8_t                   numBaudFail;      //!< number of consecutive SYNC/PID errors after lock
+    uint32_t                  timeBaudSwitch;   //!< time [us] of last baudrate change
+    static const uint32_t     tableBaud[];      //!< candidate baudrates, see LIN_SLAVE_AUTOBAUD_RATES
+
+    // resynchronization without BREAK
+    uint8_t                   scoreBreak;       //!< evidence score that previous byte was a BREAK, see _resyncByte()
+    uint8_t                   scoreResync;      //!< evidence score of current frame header if found by resync, else 0
+    uint32_t                  timeResync;       //!< time [us] of previous byte 0x00, i.e. start of resynchronized frame
+    uint32_t                  timePauseResync;  //!< min. pause [us] as evidence for frame start, see LIN_SLAVE_RESYNC_PAUSE
+
+    // clock trim to master SYNC field
+    bool                      flagClockTrim;    //!< trim UART baudrate to measured master clock, see setClockTrim()
+    uint16_t                  timeByteNom;      //!< nominal byte period [us] at baudrate
+    uint32_t                  timeByteAvg;      //!< filtered byte period of master SYNC->PID [us/16], 0 = no measurement
+    uint32_t                  baudrateTrim;     //!< currently configured (trimmed) UART baudrate [Baud]
+
+    // list of opened LIN instances for serviceAll()
+    static LIN_SLAVE_THREAD_LOCAL LIN_Slave_Base *pFirstInstance;  //!< first opened LIN instance
+    static LIN_SLAVE_THREAD_LOCAL LIN_Slave_Base *pNextService;    //!< instance to service first in next call of serviceAll()
+    LIN_Slave_Base            *pNextInstance;   //!< next opened LIN instance
+    const LIN_Slave_Base::frame_entry_t *tableFrame;  //!< optional frame table in flash, sorted by ID. See attachFrameTable()
+    const LIN_Slave_Base::frame_index_t *indexFrame;  //!< index of tableFrame by ID in flash, see makeFrameIndex()
+    LIN_Slave_Base::callback_t  callbackTable;  //!< RAM copy of callback found in tableFrame
+    #if (LIN_SLAVE_MAX_FRAMES > 0)
+      uint8_t                 maskFrame[8];     //!< registered IDs. Bit (ID & 0x07) of byte (ID >> 3)
+      uint8_t                 rankFrame[8];     //!< number of registered IDs in preceeding bytes of maskFrame[]
+      uint8_t                 numFrames;        //!< number of registered frames
+      LIN_Slave_Base::callback_t  callback[LIN_SLAVE_MAX_FRAMES]; //!< user callback functions of registered IDs, sorted by ID
+    #else
+      LIN_Slave_Base::callback_t  callback[64]; //!< array of user callback functions for IDs 0x00..0x3F
+    #endif
 
     // latest frame properties
     uint8_t                   pid;              //!< protected frame identifier
@@ -136,14 +407,74 @@ class LIN_Slave_Base
     uint8_t                   numData;          //!< number of data bytes in frame
     uint8_t                   bufData[9];       //!< buffer for data bytes (max. 8B) + checksum
     uint8_t                   idxData;          //!< current index in bufData
-    uint32_t                  timeoutRx;        //!< timeout [us] for bytes in frame
+    uint8_t                   sumData;          //!< running (non-inverted) checksum of current frame, see _checksumInit()
+
+    // passive monitor mode
+    bool                      flagMonitor;      //!< capture all frames without response, see setMonitorMode()
+    LIN_Slave_Base::LinMonitorCallback  fctMonitor; //!< optional callback for captured frames
+    uint8_t                   sumClassic;       //!< running classic checksum of current frame in monitor mode
+    uint16_t                  maskEnhanced;     //!< bit i set if bufData[i] is enhanced checksum of preceeding bytes
+    uint16_t                  maskClassic;      //!< bit i set if bufData[i] is classic checksum of preceeding bytes
+    uint16_t                  bitsTimeoutRx;    //!< max. pause [bit times] between bytes in frame
+    uint32_t                  timeoutRx;        //!< max. pause [us] between bytes in frame, derived from bitsTimeoutRx and baudrate
+    uint32_t                  timeoutFrame;     //!< timeout [us] for current frame since BREAK, depends on baudrate and length
+    bool                      flagTimeoutAdaptive;  //!< adapt frame timeout to measured byte period of master
     uint32_t                  timeLastRx;       //!< time [us] of last received byte in frame
+    LIN_Slave_Base::error_t   errorFrame;       //!< errors of current frame, for frame queue
+    uint32_t                  timeFrameStart;   //!< time [us] of BREAK of current frame
+    uint32_t                  timeSync;         //!< time [us] of SYNC of current frame
+    uint32_t                  timePID;          //!< time [us] of PID of current frame
+    volatile uint32_t         timeBreak;        //!< time [us] of last BREAK. Is set by derived class together with flagBreak
+    static LIN_SLAVE_THREAD_LOCAL uint32_t timeHigh; //!< upper 32 bit of 64-bit time, see getMicros64()
+    static LIN_SLAVE_THREAD_LOCAL uint32_t timeLow;  //!< last lower 32 bit of 64-bit time, for wrap-around detection
+
+    // queue of completed frames (single producer, single consumer)
+    #if (LIN_SLAVE_FRAME_QUEUE > 0)
+      LIN_Slave_Base::frame_record_t  queue[LIN_SLAVE_FRAME_QUEUE];   //!< completed frames
+      volatile uint8_t          queueHead;      //!< write index (free running), only changed by handler()
+      volatile uint8_t          queueTail;      //!< read index (free running), only changed by readFrame()
+      volatile uint8_t          queueSeq[LIN_SLAVE_FRAME_QUEUE];  //!< sequence number per record, odd while written. Detects overwrite in readFrame()
+      volatile uint16_t         queueOverflow;  //!< number of lost frames (saturating)
+      LIN_Slave_Base::queue_policy_t  queuePolicy;  //!< behavior if queue is full
+    #endif
+
+    // pre-published slave responses
+    #if (LIN_SLAVE_NUM_RESPONSES > 0)
+      LIN_Slave_Base::response_t  response[LIN_SLAVE_NUM_RESPONSES];  //!< pre-published slave responses
+      volatile uint8_t          generation;     //!< publish generation. Bit 0 selects active buffer of all responses
+      uint8_t                   maskPending;    //!< responses updated since beginPublish(), bit i = response[i]
+      bool                      flagPublish;    //!< publish transaction is open, see beginPublish()
+    #endif
+
+    // deferred event log (single producer, single consumer)
+    #if (LIN_SLAVE_LOG_SIZE > 0)
+      LIN_Slave_Base::log_entry_t logEntry[LIN_SLAVE_LOG_SIZE];   //!< logged events
+      volatile uint8_t          logHead;        //!< write index (free running), only changed by handler()
+      volatile uint8_t          logTail;        //!< read index (free running), only changed by readLog()
+      volatile uint8_t          logLost;        //!< number of lost entries (saturating)
+    #endif
+
+    // timing statistics
+    #if defined(LIN_SLAVE_STATISTICS)
+      LIN_Slave_Base::histogram_t histogram[LIN_Slave_Base::STAT_NUM];  //!< timing histograms
+      uint16_t                  timeCallbackMax[64];  //!< max. callback execution time [us] per ID (saturating)
+    #endif
+
+    // traffic and error counters
+    #if defined(LIN_SLAVE_ID_COUNTERS)
+      LIN_Slave_Base::id_counters_t   counterID[64];  //!< counters per frame ID
+      LIN_Slave_Base::bus_counters_t  counterBus;     //!< bus level counters
+    #endif
 
 
   // PUBLIC VARIABLES
   public:
 
-    char                      nameLIN[LIN_SLAVE_BUFLEN_NAME];   //!< LIN node name, e.g. for debug
+    #if defined(LIN_SLAVE_NAME_POINTER)
+      const char              *nameLIN;         //!< LIN node name, e.g. for debug
+    #else
+      char                    nameLIN[LIN_SLAVE_BUFLEN_NAME];   //!< LIN node name, e.g. for debug
+    #endif
 
 
   // PROTECTED METHODS
@@ -153,7 +484,31 @@ class LIN_Slave_Base
     uint8_t _calculatePID(uint8_t ID);
   
     /// @brief Calculate LIN frame checksum
-    uint8_t _calculateChecksum(uint8_t NumData, uint8_t Data[]);
+    uint8_t _calculateChecksum(uint8_t NumData, uint8_t Data[], uint8_t PID);
+
+    /// @brief Find callback for a frame ID
+    LIN_Slave_Base::callback_t *_findCallback(uint8_t ID);
+
+    /// @brief Store callback for a frame ID
+    bool _storeCallback(uint8_t ID, uint8_t Type_NumData, LIN_Slave_Base::LinMessageCallback Fct);
+
+    /// @brief Get index of ID in frame table via recursion (C++11 constexpr), 0xFF if not found. Is used by makeFrameIndex()
+    template <size_t N> static constexpr uint8_t _findFrameEntry(const LIN_Slave_Base::frame_entry_t (&Table)[N], uint8_t ID, size_t Idx = 0)
+    {
+      return (Idx >= N) ? 0xFF : ((Table[Idx].id == ID) ? (uint8_t) Idx : _findFrameEntry(Table, ID, Idx+1));
+    }
+
+    /// @brief Build index for all IDs 0..63 via pack expansion. Is used by makeFrameIndex()
+    template <size_t N, uint8_t... I> static constexpr LIN_Slave_Base::frame_index_t _makeFrameIndex(const LIN_Slave_Base::frame_entry_t (&Table)[N],
+      LIN_Slave_Base::id_sequence_t<I...>)
+    {
+      return {{ _findFrameEntry(Table, I)... }};
+    }
+
+    #if (LIN_SLAVE_NUM_RESPONSES > 0)
+      /// @brief Find slot of pre-published slave response
+      uint8_t _findResponse(uint8_t ID);
+    #endif
 
     /// @brief Get break detection flag. Is hardware dependent
     virtual bool _getBreakFlag(void);
@@ -161,6 +516,356 @@ class LIN_Slave_Base
     /// @brief Clear break detection flag. Is hardware dependent
     virtual void _resetBreakFlag(void);
 
+    /// @brief Set error bit(s) in latched error and error of current frame
+    inline void _setError(LIN_Slave_Base::error_t Error)
+    {
+      this->error      = (LIN_Slave_Base::error_t) ((int) this->error | (int) Error);
+      this->errorFrame = (LIN_Slave_Base::error_t) ((int) this->errorFrame | (int) Error);
+    }
+
+    /// @brief Start checksum accumulation for current frame. Seed is PID (LIN2.x) or 0 (LIN1.x, diagnostic frames)
+    inline void _checksumInit(void)
+    {
+      this->sumData = LIN_Slave_Protocol::getSeed(this->id, (this->version != LIN_Slave_Base::LIN_V1));
+    }
+
+    /// @brief Add byte to checksum of current frame
+    inline void _checksumAdd(uint8_t Byte)
+    {
+      this->sumData = LIN_Slave_Protocol::checksumAdd(this->sumData, Byte);
+    }
+
+    /// @brief Get final checksum of current frame
+    inline uint8_t _checksumGet(void)
+    {
+      return (uint8_t) (~(this->sumData));
+    }
+
+    /// @brief Store event in deferred log. Constant runtime, drops event if log is full. Is empty if log is disabled
+    inline void _log(LIN_Slave_Base::log_event_t Event, uint8_t Data, uint32_t Time)
+    {
+      #if (LIN_SLAVE_LOG_SIZE > 0)
+        uint8_t                       head = this->logHead;
+        LIN_Slave_Base::log_entry_t   *pEntry;
+
+        // log is full -> count lost entry
+        if ((uint8_t) (head - this->logTail) >= LIN_SLAVE_LOG_SIZE)
+        {
+          if (this->logLost != 0xFF)
+            this->logLost = this->logLost + 1;
+          return;
+        }
+
+        // fill entry and publish it (atomic byte write)
+        pEntry = &(this->logEntry[head & (LIN_SLAVE_LOG_SIZE-1)]);
+        pEntry->event = Event;
+        pEntry->id    = this->id;
+        pEntry->data  = Data;
+        pEntry->time  = Time;
+        LIN_SLAVE_BARRIER();
+        this->logHead = head + 1;
+      #else
+        (void) Event;
+        (void) Data;
+        (void) Time;
+      #endif
+    }
+
+    #if (LIN_SLAVE_LOG_SIZE > 0)
+      /// @brief Write log entry as binary record
+      static void _writeLogEntry(Print &Out, const LIN_Slave_Base::log_entry_t &Entry);
+    #endif
+
+    /// @brief Get time [us] for statistics. Returns 0 if statistics are disabled, i.e. call is optimized out
+    inline uint32_t _statTime(void)
+    {
+      #if defined(LIN_SLAVE_STATISTICS)
+        return micros();
+      #else
+        return 0;
+      #endif
+    }
+
+    /// @brief Add time [us] to timing histogram. Is empty if statistics are disabled
+    inline void _statAdd(LIN_Slave_Base::statistics_t Type, uint32_t Time)
+    {
+      #if defined(LIN_SLAVE_STATISTICS)
+        LIN_Slave_Base::histogram_t   *pHist = &(this->histogram[Type]);
+        uint16_t  value = (Time > 0xFFFF) ? 0xFFFF : (uint16_t) Time;
+        uint8_t   bin = (value == 0) ? 0 : (uint8_t) (8*sizeof(unsigned int) - __builtin_clz(value));   // = bit length of value
+
+        // update histogram (saturating)
+        if (bin >= LIN_SLAVE_STAT_BINS)
+          bin = LIN_SLAVE_STAT_BINS-1;
+        if (pHist->count[bin] != 0xFFFF)
+          (pHist->count[bin])++;
+        if (value > pHist->max)
+          pHist->max = value;
+      #else
+        (void) Type;
+        (void) Time;
+      #endif
+    }
+
+    /// @brief Add callback execution time [us] to histogram and max. time per ID. Is empty if statistics are disabled
+    inline void _statCallback(uint8_t ID, uint32_t Time)
+    {
+      #if defined(LIN_SLAVE_STATISTICS)
+        this->_statAdd(LIN_Slave_Base::STAT_CALLBACK, Time);
+        if (Time > this->timeCallbackMax[ID & 0x3F])
+          this->timeCallbackMax[ID & 0x3F] = (Time > 0xFFFF) ? 0xFFFF : (uint16_t) Time;
+      #else
+        (void) ID;
+        (void) Time;
+      #endif
+    }
+
+    #if defined(LIN_SLAVE_ID_COUNTERS)
+
+      /// @brief Branch-free saturating increment of 8-bit counter if Flag is 1
+      static inline void _countInc(uint8_t &Counter, uint8_t Flag) { Counter += (uint8_t) (Flag & (Counter != 0xFF)); }
+
+      /// @brief Branch-free saturating increment of 16-bit counter if Flag is 1
+      static inline void _countInc(uint16_t &Counter, uint8_t Flag) { Counter += (uint16_t) (Flag & (Counter != 0xFFFF)); }
+
+    #endif // LIN_SLAVE_ID_COUNTERS
+
+    /// @brief Update counters and health of current frame ID from frame errors. Is empty if counters are disabled
+    inline void _countFrame(void)
+    {
+      #if defined(LIN_SLAVE_ID_COUNTERS)
+        LIN_Slave_Base::id_counters_t   *pCnt = &(this->counterID[this->id & 0x3F]);
+        uint8_t   err = this->errorFrame;
+        uint8_t   flagOk = (err == LIN_Slave_Base::NO_ERROR);
+
+        // update counters without branches: increment is 0 or 1
+        LIN_Slave_Base::_countInc(pCnt->ok, flagOk);
+        LIN_Slave_Base::_countInc(pCnt->chk, (uint8_t) ((err & LIN_Slave_Base::ERROR_CHK) != 0));
+        LIN_Slave_Base::_countInc(pCnt->echo, (uint8_t) ((err & LIN_Slave_Base::ERROR_ECHO) != 0));
+        LIN_Slave_Base::_countInc(pCnt->pid, (uint8_t) ((err & LIN_Slave_Base::ERROR_PID) != 0));
+        LIN_Slave_Base::_countInc(pCnt->timeout, (uint8_t) ((err & LIN_Slave_Base::ERROR_TIMEOUT) != 0));
+
+        // update health: h = 7/8*h + 1/8*255*ok, as decay of distance to target (h on error, 255-h if ok) by 1/8 rounded up.
+        // Rounding up ensures that 255 and 0 are reached, instead of getting stuck at 248 or 7. No branch, no overflow
+        uint8_t   mask = (uint8_t) (-flagOk);
+        uint8_t   dist = (uint8_t) (pCnt->health ^ mask);
+        dist = (uint8_t) (dist - ((dist + 7) >> 3));
+        pCnt->health = (uint8_t) (dist ^ mask);
+      #endif
+    }
+
+    /// @brief Copy current frame to frame record
+    void _getRecord(LIN_Slave_Base::frame_record_t &Record);
+
+    /// @brief Store completed frame in queue
+    void _pushFrame(void);
+
+    /// @brief Store received byte of frame with unknown length in monitor mode
+    inline void _monitorByte(uint8_t Byte)
+    {
+      uint8_t   idx = this->idxData;
+
+      // mark if byte matches checksum of preceeding bytes, i.e. frame may end here
+      this->maskEnhanced |= (uint16_t) (Byte == (uint8_t) ~(this->sumData)) << idx;
+      this->maskClassic  |= (uint16_t) (Byte == (uint8_t) ~(this->sumClassic)) << idx;
+
+      // store byte and update both checksums
+      this->bufData[idx] = Byte;
+      this->idxData      = idx + 1;
+      this->sumData      = LIN_Slave_Protocol::checksumAdd(this->sumData, Byte);
+      this->sumClassic   = LIN_Slave_Protocol::checksumAdd(this->sumClassic, Byte);
+    }
+
+    /// @brief Evaluate captured frame in monitor mode
+    void _monitorFrame(void);
+
+    /// @brief Get max. frame duration [us] for given number of response bytes
+    uint32_t _getFrameTimeMax(uint8_t NumBytes);
+
+    /// @brief Set timeout for current frame after PID reception
+    void _setFrameTimeout(void);
+
+    /// @brief Check result of SYNC and PID reception for auto-baud detection
+    inline void _checkBaudrate(bool FlagValid)
+    {
+      // auto-baud disabled -> do nothing
+      if (!(this->flagAutoBaud))
+        return;
+
+      // valid frame header -> lock baudrate
+      if (FlagValid)
+      {
+        this->flagBaudLocked = true;
+        this->numBaudFail    = 0;
+      }
+
+      // SYNC or PID error -> try next baudrate. If locked, only after several errors
+      else if ((!(this->flagBaudLocked)) || (++(this->numBaudFail) >= LIN_SLAVE_AUTOBAUD_RETRY))
+      {
+        this->flagBaudLocked = false;
+        this->flagBaudNext   = true;
+      }
+    }
+
+    /// @brief Handle auto-baud detection, i.e. switch baudrate. Is called by handler()
+    void _handleAutoBaud(void);
+
+    /// @brief Measure byte period of master SYNC->PID (in local clock) for clock trim
+    inline void _measureClock(uint32_t TimeByte)
+    {
+      // ignore implausible values, e.g. due to inter-byte space or polling latency
+      if ((TimeByte <= (uint32_t) (this->timeByteNom - (this->timeByteNom >> 3))) ||
+          (TimeByte >= (uint32_t) (this->timeByteNom + (this->timeByteNom >> 3))))
+        return;
+
+      // IIR filter of byte period [us/16]. Initialize with first measurement
+      if (this->timeByteAvg == 0)
+        this->timeByteAvg = TimeByte << 4;
+      else
+        this->timeByteAvg = this->timeByteAvg - (this->timeByteAvg >> LIN_SLAVE_CLOCK_FILTER) + (TimeByte << (4 - LIN_SLAVE_CLOCK_FILTER));
+    }
+
+    /// @brief Convert time [us] at LIN_SLAVE_TIMING_BAUDRATE to bit times (rounded, saturated)
+    static inline uint16_t _timeToBits(uint32_t Time)
+    {
+      uint32_t  bits = (Time < 20000000L) ? (uint32_t) ((Time * (LIN_SLAVE_TIMING_BAUDRATE / 100L) + 5000L) / 10000L) : 0xFFFF;
+      return (bits > 0xFFFF) ? 0xFFFF : (uint16_t) bits;
+    }
+
+    /// @brief Convert bit times to time [us] at current baudrate. Max. 0.5% error for >=9600 Baud, no overflow. Requires baudrate >= LIN_SLAVE_MIN_BAUDRATE
+    inline uint32_t _bitsToTime(uint16_t Bits) { return (uint32_t) ((uint32_t) Bits * 15625L / (this->baudrate >> 6)); }
+
+    /// @brief Update timing parameters [us] and reset clock measurement after change of nominal baudrate
+    virtual void _updateTiming(void);
+
+    /// @brief Trim UART baudrate to measured master clock. Is called by handler()
+    void _handleClockTrim(void);
+
+    /// @brief Check byte outside frame for frame header without BREAK. Is called by _handleByte()
+    void _resyncByte(uint8_t byteReceived, uint32_t TimeReceived, uint32_t TimeGap);
+
+    /// @brief Handle frame timeout. Is called by handler() or from receive ISR, see _handleReceiveISR()
+    void _handleTimeout(bool FlagPending, uint32_t TimeNow);
+
+    /// @brief Handle a received BREAK. Is called by handler() or from receive ISR
+    void _handleBreak(uint32_t TimeBreak);
+
+    /// @brief Handle a received byte in LIN state machine. Is called by handler() or from receive ISR
+    void _handleByte(uint8_t byteReceived, uint32_t TimeReceived);
+
+    /// @brief Handle a received byte or BREAK incl. timeout check in receive ISR, i.e. without handler()
+    void _handleReceiveISR(uint8_t byteReceived, bool FlagBreak, uint32_t TimeReceived);
+
+    /// @brief Convert a past 32-bit timestamp [us] to 64-bit
+    static uint64_t _toMicros64(uint32_t Time);
+
+
+    /**
+      \brief      Common part of handler() with given binding of serial interface
+      \details    Handle LIN protocol and call user-defined frame callback functions. Is called by LIN_Slave_Base::handler()
+                  with virtual_binding_t and by LIN_Slave_Static::handler() with static binding, i.e. the per-byte path exists once
+      \param[in]  Interface binding of serial interface, e.g. virtual_binding_t
+    */
+    template <class Binding> inline void _handlerCore(Binding Interface)
+    {
+      // keep 64-bit time up to date, requires a call at least every 71 minutes
+      LIN_Slave_Base::getMicros64();
+
+      // optionally switch baudrate for auto-baud detection
+      if (this->flagAutoBaud)
+        this->_handleAutoBaud();
+
+      // optionally trim baudrate to master clock
+      if (this->flagClockTrim)
+        this->_handleClockTrim();
+
+      // on frame timeout abort frame. Check only if no byte is pending, as handler() may be late.
+      // If LIN state machine runs in receive ISR, timeout is checked there, see _handleReceiveISR()
+      if (!Binding::flagHandlerISR)
+        this->_handleTimeout(Interface.available(), micros());
+
+
+      // detected LIN BREAK (=0x00 with framing error or inter-frame pause detected)
+      // Note: received BREAK byte is consumed by child class to support also sync on SYNC byte.
+      if (Interface.getBreakFlag() == true)
+      {
+        // clear BREAK flag again
+        Interface.resetBreakFlag();
+
+        // start frame reception
+        this->_handleBreak(this->timeBreak);
+
+      } // if BREAK detected
+
+
+      // A byte was received -> handle it
+      if (Interface.available())
+      {
+        // receive time of byte, i.e. ISR time if captured by derived class, else poll time. Must be fetched before read
+        uint32_t timeReceived = Interface.receiveTime();
+
+        // read received byte
+        uint8_t byteReceived = Interface.read();
+
+        // optional debug output (debug level 3)
+        #if defined(LIN_SLAVE_DEBUG_SERIAL) && (LIN_SLAVE_DEBUG_LEVEL >= 3)
+          LIN_SLAVE_DEBUG_SERIAL.print(this->nameLIN);
+          LIN_SLAVE_DEBUG_SERIAL.print(": LIN_Slave_Base::handler()");
+          if (Interface.getBreakFlag() == true)
+            LIN_SLAVE_DEBUG_SERIAL.print(": BRK, Rx=0x");
+          else
+            LIN_SLAVE_DEBUG_SERIAL.print(": Rx=0x");
+          LIN_SLAVE_DEBUG_SERIAL.println(byteReceived, HEX);
+        #endif
+
+        // handle byte
+        this->_handleByte(byteReceived, timeReceived);
+
+      } // if byte received
+
+    } // _handlerCore()
+
+
+    /**
+      \brief      Common part of handlerDrain() with given binding of serial interface
+      \details    Handle all pending Rx bytes via handler() of the binding, stop after a completed frame.
+                  Is called by LIN_Slave_Base::handlerDrain() and LIN_Slave_Static::handlerDrain()
+      \param[in]  Interface binding of serial interface, e.g. virtual_binding_t
+      \param[in]  MaxBytes  max. number of bytes to handle in this call
+      \return     number of handled bytes
+    */
+    template <class Binding> inline uint8_t _handlerDrainCore(Binding Interface, uint8_t MaxBytes)
+    {
+      LIN_Slave_Base::state_t   statePrev;
+      uint8_t                   numBytes = 0;
+
+      // handle pending bytes one by one
+      while ((numBytes < MaxBytes) && (Interface.available()))
+      {
+        // handle next byte incl. BREAK detection of derived class
+        statePrev = this->state;
+        Interface.handler();
+        numBytes++;
+
+        // stop on frame completion to avoid overwriting frame data before getFrame()
+        if ((this->state == LIN_Slave_Base::STATE_DONE) && (statePrev != LIN_Slave_Base::STATE_DONE))
+          break;
+
+      } // while bytes pending
+
+      // optional debug output (debug level 3)
+      #if defined(LIN_SLAVE_DEBUG_SERIAL) && (LIN_SLAVE_DEBUG_LEVEL >= 3)
+        LIN_SLAVE_DEBUG_SERIAL.print(this->nameLIN);
+        LIN_SLAVE_DEBUG_SERIAL.print(": LIN_Slave_Base::handlerDrain(): handled ");
+        LIN_SLAVE_DEBUG_SERIAL.print((int) numBytes);
+        LIN_SLAVE_DEBUG_SERIAL.println(" bytes");
+      #endif
+
+      // return number of handled bytes
+      return numBytes;
+
+    } // _handlerDrainCore()
+
 
     /// @brief peek next byte from Rx buffer. Here dummy
     virtual inline uint8_t _serialPeek(void) { return 0x00; }
@@ -168,8 +873,14 @@ class LIN_Slave_Base
     /// @brief read next byte from Rx buffer. Here dummy
     virtual inline uint8_t _serialRead(void) { return 0x00; }
 
+    /// @brief receive time [us] of next byte in Rx buffer, i.e. before _serialRead(). Here poll time, is overridden if Rx ISR captures time
+    virtual inline uint32_t _getReceiveTime(void) { return micros(); }
+
     /// @brief write bytes to Tx buffer. Here dummy
     virtual inline void _serialWrite(uint8_t buf[], uint8_t num) { (void) buf; (void) num; }
+
+    /// @brief change baudrate of opened serial interface. Here dummy
+    virtual inline void _setBaudrate(uint32_t Baudrate) { (void) Baudrate; }
     
 
     /// @brief Enable RS485 transmitter (DE=high)
@@ -213,7 +924,7 @@ class LIN_Slave_Base
 
 
     /// @brief Open serial interface
-    virtual void begin(uint16_t Baudrate = 19200);
+    virtual void begin(uint32_t Baudrate = 19200);
     
     /// @brief Close serial interface
     virtual void end(void);
@@ -222,6 +933,30 @@ class LIN_Slave_Base
     virtual inline bool available(void) { return false; }
 
     
+    /// @brief Enable or disable auto-baud detection from SYNC field
+    void setAutoBaud(bool Enable);
+
+    /// @brief Getter for current nominal baudrate [Baud]
+    inline uint32_t getBaudrate(void) { return this->baudrate; }
+
+    /// @brief Switch to or from fast mode with higher baudrate, e.g. for flashing
+    void setFastMode(bool Enable, uint32_t Baudrate = LIN_SLAVE_FAST_BAUDRATE);
+
+    /// @brief Getter for fast mode
+    inline bool getFastMode(void) { return this->flagFastMode; }
+
+    /// @brief Getter for auto-baud lock, i.e. if current baudrate is confirmed by a valid frame header
+    inline bool getBaudLocked(void) { return this->flagBaudLocked; }
+
+    /// @brief Enable or disable trimming of UART baudrate to master clock (default = off)
+    void setClockTrim(bool Enable);
+
+    /// @brief Getter for measured deviation of local clock vs. master clock [0.01%]
+    int16_t getClockDeviation(void);
+
+    /// @brief Enable or disable passive monitor mode for all frame IDs
+    void setMonitorMode(bool Enable, LIN_Slave_Base::LinMonitorCallback Fct = nullptr);
+
     /// @brief Reset LIN state machine
     inline void resetStateMachine(void)
     {
@@ -262,6 +997,9 @@ class LIN_Slave_Base
 
     } // resetError()
     
+    /// @brief Adapt frame timeout to measured byte period of master (default = off)
+    inline void setTimeoutAdaptive(bool Adaptive) { this->flagTimeoutAdaptive = Adaptive; }
+
     /// @brief Getter for LIN state machine error
     inline LIN_Slave_Base::error_t getError(void)
     {
@@ -295,15 +1033,173 @@ class LIN_Slave_Base
 
 
     /// @brief Attach user callback function for master request frame
-    void registerMasterRequestHandler(uint8_t ID, LIN_Slave_Base::LinMessageCallback Fct, uint8_t NumData);
+    bool registerMasterRequestHandler(uint8_t ID, LIN_Slave_Base::LinMessageCallback Fct, uint8_t NumData);
 
     /// @brief Attach user callback function for slave response frame
-    void registerSlaveResponseHandler(uint8_t ID, LIN_Slave_Base::LinMessageCallback Fct, uint8_t NumData);
+    bool registerSlaveResponseHandler(uint8_t ID, LIN_Slave_Base::LinMessageCallback Fct, uint8_t NumData);
+
+
+    /// @brief Create master request entry for frame table, see attachFrameTable()
+    static constexpr LIN_Slave_Base::frame_entry_t entryMasterRequest(uint8_t ID, LIN_Slave_Base::LinMessageCallback Fct, uint8_t NumData)
+    {
+      return { ID, (uint8_t) (LIN_Slave_Base::MASTER_REQUEST | NumData), Fct };
+    }
+
+    /// @brief Create slave response entry for frame table, see attachFrameTable()
+    static constexpr LIN_Slave_Base::frame_entry_t entrySlaveResponse(uint8_t ID, LIN_Slave_Base::LinMessageCallback Fct, uint8_t NumData)
+    {
+      return { ID, (uint8_t) (LIN_Slave_Base::SLAVE_RESPONSE | NumData), Fct };
+    }
+
+    /**
+      \brief      Check frame table at compile time
+      \details    Check that IDs are 0..0x3F and strictly ascending (i.e. no duplicates), frame lengths are 1..8 and a callback is attached.
+                  Use as static_assert(LIN_Slave_Base::checkFrameTable(Table), "invalid LIN frame table")
+      \param[in]  Table   frame table
+      \param[in]  Idx     first entry to check (for recursion)
+      \return     true if table is valid
+    */
+    template <size_t N> static constexpr bool checkFrameTable(const LIN_Slave_Base::frame_entry_t (&Table)[N], size_t Idx = 0)
+    {
+      return (Idx >= N) || ((N <= 64) &&
+        (Table[Idx].id <= 0x3F) && ((Idx == 0) || (Table[Idx-1].id < Table[Idx].id)) &&
+        (((Table[Idx].type_numData & 0xF0) == LIN_Slave_Base::MASTER_REQUEST) || ((Table[Idx].type_numData & 0xF0) == LIN_Slave_Base::SLAVE_RESPONSE)) &&
+        ((Table[Idx].type_numData & 0x0F) >= 1) && ((Table[Idx].type_numData & 0x0F) <= 8) &&
+        (Table[Idx].fct != nullptr) && checkFrameTable(Table, Idx+1));
+    }
+
+    /**
+      \brief      Build index of frame table by ID at compile time
+      \details    Build index of frame table by ID at compile time, i.e. the callback of an ID is found with one table access.
+                  Use as constexpr LIN_Slave_Base::frame_index_t Index PROGMEM = LIN_Slave_Base::makeFrameIndex(Table)
+      \param[in]  Table   frame table, checked via checkFrameTable()
+      \return     index in Table per ID, 0xFF for IDs not in Table
+    */
+    template <size_t N> static constexpr LIN_Slave_Base::frame_index_t makeFrameIndex(const LIN_Slave_Base::frame_entry_t (&Table)[N])
+    {
+      return _makeFrameIndex(Table, typename LIN_Slave_Base::id_range_t<64>::type());
+    }
+
+    /**
+      \brief      Check frame index at compile time
+      \details    Check that index was built from frame table, i.e. each ID maps to its table entry or 0xFF.
+                  Use as static_assert(LIN_Slave_Base::checkFrameIndex(Table, Index), "invalid LIN frame index")
+      \param[in]  Table   frame table
+      \param[in]  Index   index of frame table, see makeFrameIndex()
+      \param[in]  ID      first ID to check (for recursion)
+      \return     true if index matches table
+    */
+    template <size_t N> static constexpr bool checkFrameIndex(const LIN_Slave_Base::frame_entry_t (&Table)[N], const LIN_Slave_Base::frame_index_t &Index,
+      uint8_t ID = 0)
+    {
+      return (ID >= 64) || ((Index.idx[ID] == _findFrameEntry(Table, ID)) && checkFrameIndex(Table, Index, ID+1));
+    }
+
+    /**
+      \brief      Attach compile-time frame table
+      \details    Attach constant frame table and its index by ID, e.g. in flash via PROGMEM on AVR. No registration at runtime is required.
+                  Table and index must be checked via checkFrameTable() and checkFrameIndex() at compile time. Entries take precedence
+                  over registered callbacks
+      \param[in]  Table   frame table, sorted by ID
+      \param[in]  Index   index of frame table by ID, see makeFrameIndex()
+    */
+    template <size_t N> inline void attachFrameTable(const LIN_Slave_Base::frame_entry_t (&Table)[N], const LIN_Slave_Base::frame_index_t &Index)
+    {
+      static_assert((N > 0) && (N <= 64), "LIN frame table must have 1..64 entries");
+
+      noInterrupts();                         // for data consistency temporarily disable ISRs
+      this->tableFrame = Table;
+      this->indexFrame = &Index;
+      interrupts();                           // re-enable ISRs
+
+    } // attachFrameTable()
+
+
+    #if (LIN_SLAVE_FRAME_QUEUE > 0)
+
+      /// @brief Read oldest completed frame from queue
+      bool readFrame(LIN_Slave_Base::frame_record_t &Frame);
+
+      /// @brief Set behavior of frame queue if full
+      inline void setQueuePolicy(LIN_Slave_Base::queue_policy_t Policy) { this->queuePolicy = Policy; }
+
+      /// @brief Getter for number of lost frames
+      uint16_t getQueueOverflow(void);
+
+    #endif // LIN_SLAVE_FRAME_QUEUE
+
+
+    #if (LIN_SLAVE_NUM_RESPONSES > 0)
+
+      /// @brief Publish slave response data for an ID. Is sent on next PID without calling a callback
+      bool publishResponse(uint8_t ID, const uint8_t Data[], uint8_t NumData);
+
+      /// @brief Start publishing several slave responses as one consistent snapshot
+      inline void beginPublish(void) { this->flagPublish = true; }
+
+      /// @brief Activate all slave responses published since beginPublish() at once
+      void commitPublish(void);
+
+      /// @brief Getter for publish generation. Is incremented on each activation of published responses
+      inline uint8_t getPublishGeneration(void) { return this->generation; }
+
+    #endif // LIN_SLAVE_NUM_RESPONSES
+
+
+    #if (LIN_SLAVE_LOG_SIZE > 0)
+
+      /// @brief Read oldest entry from deferred log
+      bool readLog(LIN_Slave_Base::log_entry_t &Entry);
+
+      /// @brief Write entries of deferred log as binary records, e.g. to Serial. Call from loop()
+      uint8_t drainLog(Print &Out, uint8_t MaxEntries = 0xFF);
+
+    #endif // LIN_SLAVE_LOG_SIZE
+
+
+    #if defined(LIN_SLAVE_STATISTICS)
+
+      /// @brief Getter for timing histogram
+      void getHistogram(LIN_Slave_Base::statistics_t Type, LIN_Slave_Base::histogram_t &Histogram);
+
+      /// @brief Getter for max. callback execution time [us] of an ID
+      uint16_t getCallbackTimeMax(uint8_t ID);
+
+      /// @brief Reset all timing statistics
+      void resetStatistics(void);
+
+    #endif // LIN_SLAVE_STATISTICS
+
+
+    #if defined(LIN_SLAVE_ID_COUNTERS)
+
+      /// @brief Getter for traffic and error counters of a frame ID
+      void getCounters(uint8_t ID, LIN_Slave_Base::id_counters_t &Counters);
+
+      /// @brief Getter for health of a frame ID (255=all ok, 0=all failed)
+      inline uint8_t getHealth(uint8_t ID) { return this->counterID[ID & 0x3F].health; }
+
+      /// @brief Getter for bus level counters
+      void getBusCounters(LIN_Slave_Base::bus_counters_t &Counters);
+
+      /// @brief Reset all traffic and error counters
+      void resetCounters(void);
+
+    #endif // LIN_SLAVE_ID_COUNTERS
 
 
     /// @brief Handle LIN protocol and call user-defined frame callbacks
     virtual void handler(void);
 
+    /// @brief Get wrap-safe 64-bit time [us]
+    static uint64_t getMicros64(void);
+
+    /// @brief Call handler() of all opened LIN instances
+    static void serviceAll(void);
+
+    /// @brief Handle all pending Rx bytes, stop after a completed frame
+    uint8_t handlerDrain(uint8_t MaxBytes = 0xFF);
+
 }; // class LIN_Slave_Base
 
 /*-----------------------------------------------------------------------------
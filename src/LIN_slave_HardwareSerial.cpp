@@ -45,6 +45,36 @@ void LIN_Slave_HardwareSerial::_resetBreakFlag()
 
 
 
+/**
+  \brief      Change baudrate of open serial interface
+  \details    Change baudrate of open serial interface, e.g. for auto-baud detection or clock trim. Nominal baudrate is not changed
+  \param[in]  Baudrate   new communication baudrate [Baud]
+*/
+void LIN_Slave_HardwareSerial::_setBaudrate(uint32_t Baudrate)
+{
+  // re-open serial interface with new baudrate
+  pSerial->begin(Baudrate);
+
+} // LIN_Slave_HardwareSerial::_setBaudrate()
+
+
+
+/**
+  \brief      Update timing parameters
+  \details    Update timing parameters [us] from bit times after change of nominal baudrate, incl. min. inter-frame pause
+*/
+void LIN_Slave_HardwareSerial::_updateTiming()
+{
+  // call base class method
+  LIN_Slave_Base::_updateTiming();
+
+  // min. inter-frame pause [us] for new baudrate
+  this->minFramePause = this->_bitsToTime(this->bitsFramePause);
+
+} // LIN_Slave_HardwareSerial::_updateTiming()
+
+
+
 /**************************
  * PUBLIC METHODS
 **************************/
@@ -53,21 +83,23 @@ void LIN_Slave_HardwareSerial::_resetBreakFlag()
   \brief      Constructor for LIN node class using generic HardwareSerial
   \details    Constructor for LIN node class for using generic HardwareSerial. Inherit all methods from LIN_Slave_Base, only different constructor
   \param[in]  Interface       serial interface for LIN
-  \param[in]  MinFramePause   min. inter-frame pause [us] to detect new frame (default = 1000)
+  \param[in]  MinFramePause   min. inter-frame pause [us] to detect new frame at 19200 Baud, scales with baudrate (default = 1000)
   \param[in]  Version         LIN protocol version (default = v2)
   \param[in]  NameLIN         LIN node name (default = "Slave")
-  \param[in]  TimeoutRx       timeout [us] for bytes in frame (default = 1500)
+  \param[in]  TimeoutRx       timeout [us] for bytes in frame at 19200 Baud, scales with baudrate (default = 1500)
   \param[in]  PinTxEN     optional Tx enable pin (high active) e.g. for LIN via RS485 (default = -127/none)
 */
 LIN_Slave_HardwareSerial::LIN_Slave_HardwareSerial(HardwareSerial &Interface, uint16_t MinFramePause, 
   LIN_Slave_Base::version_t Version, const char NameLIN[], uint32_t TimeoutRx, const int8_t PinTxEN) : 
-  LIN_Slave_Base::LIN_Slave_Base(Version, NameLIN, TimeoutRx, PinTxEN)
+  LIN_Slave_Static<LIN_Slave_HardwareSerial>(Version, NameLIN, TimeoutRx, PinTxEN)
 {  
   // Debug serial initialized in begin() -> no debug output here
 
   // store parameters in class variables
   this->pSerial       = &Interface;
   this->minFramePause = MinFramePause;
+  this->bitsFramePause = LIN_Slave_Base::_timeToBits(MinFramePause);
+  this->timeLastByte  = 0;
   
   // must not open connection here, else (at least) ESP32 and ESP8266 fail
 
@@ -80,7 +112,7 @@ LIN_Slave_HardwareSerial::LIN_Slave_HardwareSerial(HardwareSerial &Interface, ui
   \details    Open serial interface with specified baudrate
   \param[in]  Baudrate    communication speed [Baud] (default = 19200)
 */
-void LIN_Slave_HardwareSerial::begin(uint16_t Baudrate)
+void LIN_Slave_HardwareSerial::begin(uint32_t Baudrate)
 {
   // call base class method
   LIN_Slave_Base::begin(Baudrate);  
@@ -132,27 +164,30 @@ void LIN_Slave_HardwareSerial::end()
 */
 void LIN_Slave_HardwareSerial::handler()
 {
-  // sync frames based on inter-frame pause (not standard compliant!) 
-  static uint32_t   usLastByte = 0;
-  
+  // sync frames based on inter-frame pause (not standard compliant!). No Rx-ISR hook -> time is captured when polled
+  uint32_t  timeNow;
+
   // byte received -> check it
   if (pSerial->available())
   {
+    timeNow = micros();
+
     // if 0x00 received and long time since last byte, start new frame and remove 0x00 from queue
-    if ((pSerial->peek() == 0x00) && ((micros() - usLastByte) > this->minFramePause))
+    if ((pSerial->peek() == 0x00) && ((timeNow - this->timeLastByte) > this->minFramePause))
     {
+      this->timeBreak = timeNow;
       this->flagBreak = true;
       pSerial->read();
     }
 
     // store time of this receive
-    usLastByte = micros();
-
-    // call base-class handler
-    LIN_Slave_Base::handler();
+    this->timeLastByte = timeNow;
 
   } // if byte received
 
+  // call base-class handler. Also without received byte for timeout check
+  LIN_Slave_Static<LIN_Slave_HardwareSerial>::handler();
+
 } // LIN_Slave_HardwareSerial::handler()
 
 #endif // !ARDUINO_ARCH_AVR
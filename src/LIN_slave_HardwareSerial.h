@@ -26,7 +26,7 @@
 -----------------------------------------------------------------------------*/
 
 // include required libraries
-#include <LIN_slave_Base.h>
+#include <LIN_slave_Static.h>
 
 
 /*-----------------------------------------------------------------------------
@@ -38,14 +38,18 @@
 
   \details LIN slave node class via generic HardwareSerial.
 */
-class LIN_Slave_HardwareSerial : public LIN_Slave_Base
+class LIN_Slave_HardwareSerial : public LIN_Slave_Static<LIN_Slave_HardwareSerial>
 {
+  // static binding of serial interface methods in handler()
+  friend class LIN_Slave_Static<LIN_Slave_HardwareSerial>;
+
   // PROTECTED VARIABLES
   protected:
 
     HardwareSerial        *pSerial;             //!< pointer to serial interface used for LIN
-    bool                  flagBreak;            //!< a break was detected, is set in handle
-    uint16_t              minFramePause;        //!< min. inter-frame pause [us] to start new frame (not standard compliant!)
+    uint16_t              bitsFramePause;       //!< min. inter-frame pause [bit times] to start new frame (not standard compliant!)
+    uint32_t              minFramePause;        //!< min. inter-frame pause [us], derived from bitsFramePause and baudrate
+    uint32_t              timeLastByte;         //!< time [us] of last received byte, for inter-frame pause detection
 
 
   // PROTECTED METHODS
@@ -67,6 +71,12 @@ class LIN_Slave_HardwareSerial : public LIN_Slave_Base
     /// @brief write bytes to Tx buffer
     inline void _serialWrite(uint8_t buf[], uint8_t num) { pSerial->write(buf, num); }
 
+    /// @brief Change baudrate of open serial interface, e.g. for auto-baud
+    virtual void _setBaudrate(uint32_t Baudrate);
+
+    /// @brief Update timing parameters [us] after change of nominal baudrate
+    virtual void _updateTiming(void);
+
 
   // PUBLIC METHODS
   public:
@@ -76,7 +86,7 @@ class LIN_Slave_HardwareSerial : public LIN_Slave_Base
       LIN_Slave_Base::version_t Version = LIN_Slave_Base::LIN_V2, const char NameLIN[] = "Slave", uint32_t TimeoutRx = 1500L, const int8_t PinTxEN = INT8_MIN);
      
     /// @brief Open serial interface
-    void begin(uint16_t Baudrate = 19200);
+    void begin(uint32_t Baudrate = 19200);
     
     /// @brief Close serial interface
     void end(void);
@@ -14,7 +14,7 @@
 #include <LIN_slave_HardwareSerial_ESP32.h>
 
 // definition of static class variables (see https://stackoverflow.com/a/51091696)
-bool LIN_Slave_HardwareSerial_ESP32::flagBreak[LIN_SLAVE_ESP32_MAX_SERIAL];
+LIN_Slave_HardwareSerial_ESP32 *LIN_Slave_HardwareSerial_ESP32::pInstance[LIN_SLAVE_ESP32_MAX_SERIAL];
 
 
 
@@ -22,66 +22,31 @@ bool LIN_Slave_HardwareSerial_ESP32::flagBreak[LIN_SLAVE_ESP32_MAX_SERIAL];
  * PRIVATE METHODS
 **************************/
 
-#if (LIN_SLAVE_ESP32_MAX_SERIAL >= 1)
-  /**
-    \brief      Static callback function for ESP32 Serial0 error
-    \details    Static callback function for ESP32 Serial0 error. For a BRK this is called after onReceiveFunction() -> use polling in loop()
-                Note: received BREAK byte is consumed here to support also sync on SYNC byte. 
-    \param[in]  Err   type of UART error
-  */
-  void LIN_Slave_HardwareSerial_ESP32::_onSerialReceiveError0(hardwareSerial_error_t Err)
-  {
-    // on BREAK (=0x00 with framing error) set class variable and remove 0x00 from queue
-    if ((Serial.peek() == 0x00) && (Err == UART_BREAK_ERROR))
-    {
-      (LIN_Slave_HardwareSerial_ESP32::flagBreak)[0] = true;
-      Serial.read();
-    }
-
-  } // LIN_Slave_HardwareSerial_ESP32::_onSerialReceiveError0()
-#endif
-
-
-
-#if (LIN_SLAVE_ESP32_MAX_SERIAL >= 2)
-  /**
-    \brief      Static callback function for ESP32 Serial1 error
-    \details    Static callback function for ESP32 Serial1 error. For a BRK this is called after onReceiveFunction() -> use polling in loop()
-                Note: received BREAK byte is consumed here to support also sync on SYNC byte. 
-    \param[in]  Err   type of UART error
-  */
-  void LIN_Slave_HardwareSerial_ESP32::_onSerialReceiveError1(hardwareSerial_error_t Err)
-  {
-    // on BREAK (=0x00 with framing error) set class variable and remove 0x00 from queue
-    if ((Serial1.peek() == 0x00) && (Err == UART_BREAK_ERROR))
-    {
-      (LIN_Slave_HardwareSerial_ESP32::flagBreak)[1] = true;
-      Serial1.read();
-    }
-
-  } // LIN_Slave_HardwareSerial_ESP32::_onSerialReceiveError1()
-#endif
-
+/**
+  \brief      Static callback function for ESP32 Serialx error
+  \details    Static callback function for ESP32 Serialx error. One function is generated per Serialx and dispatches to the attached LIN instance.
+              For a BRK this is called after onReceiveFunction() -> use polling in loop()
+              Note: received BREAK byte is consumed here to support also sync on SYNC byte. 
+  \tparam     IDX   index of Serialx, i.e. in pInstance[]
+  \param[in]  Err   type of UART error
+*/
+template <uint8_t IDX> void LIN_Slave_HardwareSerial_ESP32::_onSerialReceiveError(hardwareSerial_error_t Err)
+{
+  LIN_Slave_HardwareSerial_ESP32  *pLIN = (LIN_Slave_HardwareSerial_ESP32::pInstance)[IDX];
 
+  // no LIN instance attached -> do nothing
+  if (pLIN == nullptr)
+    return;
 
-#if (LIN_SLAVE_ESP32_MAX_SERIAL >= 3)
-  /**
-    \brief      Static callback function for ESP32 Serial2 error
-    \details    Static callback function for ESP32 Serial2 error. For a BRK this is called after onReceiveFunction() -> use polling in loop()
-                Note: received BREAK byte is consumed here to support also sync on SYNC byte. 
-    \param[in]  Err   type of UART error
-  */
-  void LIN_Slave_HardwareSerial_ESP32::_onSerialReceiveError2(hardwareSerial_error_t Err)
+  // on BREAK (=0x00 with framing error) set instance flag and remove 0x00 from queue
+  if ((pLIN->pSerial->peek() == 0x00) && (Err == UART_BREAK_ERROR))
   {
-    // on BREAK (=0x00 with framing error) set class variable and remove 0x00 from queue
-    if ((Serial2.peek() == 0x00) && (Err == UART_BREAK_ERROR))
-    {
-      (LIN_Slave_HardwareSerial_ESP32::flagBreak)[2] = true;
-      Serial2.read();
-    }
+    pLIN->timeBreak = micros();
+    pLIN->flagBreak = true;
+    pLIN->pSerial->read();
+  }
 
-  } // LIN_Slave_HardwareSerial_ESP32::_onSerialReceiveError2()
-#endif
+} // LIN_Slave_HardwareSerial_ESP32::_onSerialReceiveError()
 
 
 
@@ -96,8 +61,8 @@ bool LIN_Slave_HardwareSerial_ESP32::flagBreak[LIN_SLAVE_ESP32_MAX_SERIAL];
 */
 bool LIN_Slave_HardwareSerial_ESP32::_getBreakFlag()
 {
-  // return BREAK detection flag of respective Serialx
-  return (LIN_Slave_HardwareSerial_ESP32::flagBreak)[LIN_Slave_HardwareSerial_ESP32::idxSerial];
+  // return BREAK detection flag, is set in error callback
+  return this->flagBreak;
 
 } // LIN_Slave_HardwareSerial_ESP32::_getBreakFlag()
 
@@ -109,13 +74,27 @@ bool LIN_Slave_HardwareSerial_ESP32::_getBreakFlag()
 */
 void LIN_Slave_HardwareSerial_ESP32::_resetBreakFlag()
 {
-  // clear BREAK detection flag of respective Serialx
-  (LIN_Slave_HardwareSerial_ESP32::flagBreak)[LIN_Slave_HardwareSerial_ESP32::idxSerial] = false;
+  // clear BREAK detection flag
+  this->flagBreak = false;
 
 } // LIN_Slave_HardwareSerial_ESP32::_resetBreakFlag()
 
 
 
+/**
+  \brief      Change baudrate of open serial interface
+  \details    Change baudrate of open serial interface, e.g. for auto-baud detection or clock trim. Nominal baudrate is not changed
+  \param[in]  Baudrate   new communication baudrate [Baud]
+*/
+void LIN_Slave_HardwareSerial_ESP32::_setBaudrate(uint32_t Baudrate)
+{
+  // change baudrate without re-initializing interface, which would detach Rx error callback
+  pSerial->updateBaudRate(Baudrate);
+
+} // LIN_Slave_HardwareSerial_ESP32::_setBaudrate()
+
+
+
 /**************************
  * PUBLIC METHODS
 **************************/
@@ -129,11 +108,11 @@ void LIN_Slave_HardwareSerial_ESP32::_resetBreakFlag()
   \param[in]  Version     LIN protocol version (default = v2)
   \param[in]  NameLIN     LIN node name (default = "Slave")
   \param[in]  PinTxEN     optional Tx enable pin (high active) e.g. for LIN via RS485 (default = -127/none)
-  \param[in]  TimeoutRx   timeout [us] for bytes in frame (default = 1500)
+  \param[in]  TimeoutRx   timeout [us] for bytes in frame at 19200 Baud, scales with baudrate (default = 1500)
 */
 LIN_Slave_HardwareSerial_ESP32::LIN_Slave_HardwareSerial_ESP32(HardwareSerial &Interface, uint8_t PinRx, uint8_t PinTx,
   LIN_Slave_Base::version_t Version, const char NameLIN[], uint32_t TimeoutRx, const int8_t PinTxEN) : 
-  LIN_Slave_Base::LIN_Slave_Base(Version, NameLIN, TimeoutRx, PinTxEN)
+  LIN_Slave_Static<LIN_Slave_HardwareSerial_ESP32>(Version, NameLIN, TimeoutRx, PinTxEN)
 {
   // Debug serial initialized in begin() -> no debug output here
 
@@ -141,6 +120,7 @@ LIN_Slave_HardwareSerial_ESP32::LIN_Slave_HardwareSerial_ESP32(HardwareSerial &I
   this->pSerial    = &Interface;          // pointer to used HW serial
   this->pinRx      = PinRx;               // receive pin
   this->pinTx      = PinTx;               // transmit pin
+  this->idxSerial  = 0;                   // index of Serialx, is set in begin()
 
 } // LIN_Slave_HardwareSerial_ESP32::LIN_Slave_HardwareSerial_ESP32()
 
@@ -151,7 +131,7 @@ LIN_Slave_HardwareSerial_ESP32::LIN_Slave_HardwareSerial_ESP32(HardwareSerial &I
   \details    Open serial interface with specified baudrate
   \param[in]  Baudrate    communication speed [Baud] (default = 19200)
 */
-void LIN_Slave_HardwareSerial_ESP32::begin(uint16_t Baudrate)
+void LIN_Slave_HardwareSerial_ESP32::begin(uint32_t Baudrate)
 {
   // call base class method
   LIN_Slave_Base::begin(Baudrate);  
@@ -161,28 +141,33 @@ void LIN_Slave_HardwareSerial_ESP32::begin(uint16_t Baudrate)
   pSerial->begin(this->baudrate, SERIAL_8N1, this->pinRx, this->pinTx);
   while(!(*pSerial)) { }
 
-  // Attach corresponding error callback to Serialx receive handler
-  #if (LIN_SLAVE_ESP32_MAX_SERIAL >= 1)
-    if (pSerial == &Serial0)
-    { 
-      LIN_Slave_HardwareSerial_ESP32::idxSerial = 0;
-      pSerial->onReceiveError(LIN_Slave_HardwareSerial_ESP32::_onSerialReceiveError0);
-    }
-  #endif
-  #if (LIN_SLAVE_ESP32_MAX_SERIAL >= 2)
-    if (pSerial == &Serial1)
-    { 
-      LIN_Slave_HardwareSerial_ESP32::idxSerial = 1;
-      pSerial->onReceiveError(LIN_Slave_HardwareSerial_ESP32::_onSerialReceiveError1);
-    }
-  #endif
-  #if (LIN_SLAVE_ESP32_MAX_SERIAL >= 3)
-    if (pSerial == &Serial2)
-    { 
-      LIN_Slave_HardwareSerial_ESP32::idxSerial = 2;
-      pSerial->onReceiveError(LIN_Slave_HardwareSerial_ESP32::_onSerialReceiveError2);
+  // table of Serialx and corresponding error callbacks
+  static const struct
+  {
+    HardwareSerial  *pSerial;
+    void            (*fct)(hardwareSerial_error_t);
+  } tablePort[LIN_SLAVE_ESP32_MAX_SERIAL] =
+  {
+    { &Serial0, LIN_Slave_HardwareSerial_ESP32::_onSerialReceiveError<0> },
+    #if (LIN_SLAVE_ESP32_MAX_SERIAL >= 2)
+      { &Serial1, LIN_Slave_HardwareSerial_ESP32::_onSerialReceiveError<1> },
+    #endif
+    #if (LIN_SLAVE_ESP32_MAX_SERIAL >= 3)
+      { &Serial2, LIN_Slave_HardwareSerial_ESP32::_onSerialReceiveError<2> },
+    #endif
+  };
+
+  // attach this instance and corresponding error callback to Serialx receive handler
+  for (uint8_t idx = 0; idx < LIN_SLAVE_ESP32_MAX_SERIAL; idx++)
+  {
+    if (pSerial == tablePort[idx].pSerial)
+    {
+      this->idxSerial = idx;
+      (LIN_Slave_HardwareSerial_ESP32::pInstance)[idx] = this;
+      pSerial->onReceiveError(tablePort[idx].fct);
+      break;
     }
-  #endif
+  }
 
   // initialize variables
   this->_resetBreakFlag();
@@ -209,6 +194,10 @@ void LIN_Slave_HardwareSerial_ESP32::end()
   // close serial interface
   pSerial->end();
 
+  // detach instance from error callback
+  if ((LIN_Slave_HardwareSerial_ESP32::pInstance)[this->idxSerial] == this)
+    (LIN_Slave_HardwareSerial_ESP32::pInstance)[this->idxSerial] = nullptr;
+
   // optional debug output (debug level 2)
   #if defined(LIN_SLAVE_DEBUG_SERIAL) && (LIN_SLAVE_DEBUG_LEVEL >= 2)
     LIN_SLAVE_DEBUG_SERIAL.print(this->nameLIN);
@@ -22,7 +22,7 @@
 -----------------------------------------------------------------------------*/
 
 // include required libraries
-#include <LIN_slave_Base.h>
+#include <LIN_slave_Static.h>
 
 
 /*-----------------------------------------------------------------------------
@@ -50,35 +50,30 @@
 
   \details LIN slave node class via ESP32 HardwareSerial.
 */
-class LIN_Slave_HardwareSerial_ESP32 : public LIN_Slave_Base
+class LIN_Slave_HardwareSerial_ESP32 : public LIN_Slave_Static<LIN_Slave_HardwareSerial_ESP32>
 {
+  // static binding of serial interface methods in handler()
+  friend class LIN_Slave_Static<LIN_Slave_HardwareSerial_ESP32>;
+
   // PRIVATE VARIABLES
   public:
 
     HardwareSerial        *pSerial;                              //!< pointer to serial interface used for LIN
     uint8_t               pinRx;                                 //!< pin used for receive
     uint8_t               pinTx;                                 //!< pin used for transmit
-    uint8_t               idxSerial;                             //!< index to flagBreak[] of this instance
-    static bool           flagBreak[LIN_SLAVE_ESP32_MAX_SERIAL]; //!< break flags for Serial0..N
+    uint8_t               idxSerial;                             //!< index of Serialx used by this instance
+    static LIN_Slave_HardwareSerial_ESP32 *pInstance[LIN_SLAVE_ESP32_MAX_SERIAL];  //!< LIN instances attached to Serial0..N, for error callback
 
 
   // PRIVATE METHODS
   private:
   
-    #if (LIN_SLAVE_ESP32_MAX_SERIAL >= 1)
-      /// @brief Static callback function for ESP32 Serial0 error
-      static void _onSerialReceiveError0(hardwareSerial_error_t Err);
-	  #else
+    #if (LIN_SLAVE_ESP32_MAX_SERIAL < 1)
       #error no HardwareSerial available for this board
     #endif
-    #if (LIN_SLAVE_ESP32_MAX_SERIAL >= 2)
-      /// @brief Static callback function for ESP32 Serial1 error
-      static void _onSerialReceiveError1(hardwareSerial_error_t Err);
-    #endif
-    #if (LIN_SLAVE_ESP32_MAX_SERIAL >= 3)
-      /// @brief Static callback function for ESP32 Serial2 error
-      static void _onSerialReceiveError2(hardwareSerial_error_t Err);
-    #endif
+
+    /// @brief Static callback function for ESP32 Serialx error. Is generated per Serialx index IDX
+    template <uint8_t IDX> static void _onSerialReceiveError(hardwareSerial_error_t Err);
   
 
   // PROTECTED METHODS
@@ -100,6 +95,9 @@ class LIN_Slave_HardwareSerial_ESP32 : public LIN_Slave_Base
     /// @brief write bytes to Tx buffer
     inline void _serialWrite(uint8_t buf[], uint8_t num) { pSerial->write(buf, num); }
 
+    /// @brief Change baudrate of open serial interface, e.g. for auto-baud
+    virtual void _setBaudrate(uint32_t Baudrate);
+
 
   // PUBLIC METHODS
   public:
@@ -109,7 +107,7 @@ class LIN_Slave_HardwareSerial_ESP32 : public LIN_Slave_Base
       LIN_Slave_Base::version_t Version = LIN_Slave_Base::LIN_V2, const char NameLIN[] = "Slave", uint32_t TimeoutRx = 1500L, const int8_t PinTxEN = INT8_MIN);
      
     /// @brief Open serial interface
-    void begin(uint16_t Baudrate = 19200);
+    void begin(uint32_t Baudrate = 19200);
     
     /// @brief Close serial interface
     void end(void);
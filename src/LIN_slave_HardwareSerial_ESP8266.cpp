@@ -17,6 +17,24 @@
 
 
 
+/**************************
+ * PROTECTED METHODS
+**************************/
+
+/**
+  \brief      Change baudrate of open serial interface
+  \details    Change baudrate of open serial interface, e.g. for auto-baud detection or clock trim. Nominal baudrate is not changed
+  \param[in]  Baudrate   new communication baudrate [Baud]
+*/
+void LIN_Slave_HardwareSerial_ESP8266::_setBaudrate(uint32_t Baudrate)
+{
+  // use updateBaudRate() to avoid bus glitch of Serial.begin()
+  pSerial->updateBaudRate(Baudrate);
+
+} // LIN_Slave_HardwareSerial_ESP8266::_setBaudrate()
+
+
+
 /**************************
  * PUBLIC METHODS
 **************************/
@@ -25,10 +43,10 @@
   \brief      Constructor for LIN node class using ESP8266 HardwareSerial 0
   \details    Constructor for LIN node class for using ESP8266 HardwareSerial 0. Inherit all methods from LIN_Slave_HardwareSerial, only different constructor
   \param[in]  SwapPins        use alternate Serial2 Rx/Tx pins (default = false)
-  \param[in]  MinFramePause   min. inter-frame pause [us] to detect new frame (default = 1000)
+  \param[in]  MinFramePause   min. inter-frame pause [us] to detect new frame at 19200 Baud, scales with baudrate (default = 1000)
   \param[in]  Version         LIN protocol version (default = v2)
   \param[in]  NameLIN         LIN node name (default = "Slave")
-  \param[in]  TimeoutRx       timeout [us] for bytes in frame (default = 1500)
+  \param[in]  TimeoutRx       timeout [us] for bytes in frame at 19200 Baud, scales with baudrate (default = 1500)
   \param[in]  PinTxEN         optional Tx enable pin (high active) e.g. for LIN via RS485 (default = -127/none)
 */
 LIN_Slave_HardwareSerial_ESP8266::LIN_Slave_HardwareSerial_ESP8266(bool SwapPins, uint16_t MinFramePause, 
@@ -49,7 +67,7 @@ LIN_Slave_HardwareSerial_ESP8266::LIN_Slave_HardwareSerial_ESP8266(bool SwapPins
   \details    Open serial interface with specified baudrate. Optionally use Serial2 pins
   \param[in]  Baudrate    communication speed [Baud] (default = 19200)
 */
-void LIN_Slave_HardwareSerial_ESP8266::begin(uint16_t Baudrate)
+void LIN_Slave_HardwareSerial_ESP8266::begin(uint32_t Baudrate)
 {
   // call parent class method
   LIN_Slave_HardwareSerial::begin(Baudrate);
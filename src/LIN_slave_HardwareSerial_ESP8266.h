@@ -42,6 +42,13 @@ class LIN_Slave_HardwareSerial_ESP8266 : public LIN_Slave_HardwareSerial
     bool                  swapPins;           //!< use alternate pins for Serial0
 
 
+  // PROTECTED METHODS
+  protected:
+
+    /// @brief Change baudrate of open serial interface, e.g. for auto-baud
+    virtual void _setBaudrate(uint32_t Baudrate);
+
+
   // PUBLIC METHODS
   public:
 
@@ -50,7 +57,7 @@ class LIN_Slave_HardwareSerial_ESP8266 : public LIN_Slave_HardwareSerial
       LIN_Slave_Base::version_t Version = LIN_Slave_Base::LIN_V2, const char NameLIN[] = "Slave", uint32_t TimeoutRx = 1500L, const int8_t PinTxEN = INT8_MIN);
           
     /// @brief Open serial interface
-    void begin(uint16_t Baudrate = 19200);
+    void begin(uint32_t Baudrate = 19200);
     
     /// @brief Close serial interface
     void end(void);
@@ -14,154 +14,70 @@
 #if defined(_LIN_SLAVE_NEOHWSERIAL_AVR_H_)
 
 // definition of static class variables (see https://stackoverflow.com/a/51091696)
-bool LIN_Slave_NeoHWSerial_AVR::flagBreak[];
+LIN_Slave_NeoHWSerial_AVR *LIN_Slave_NeoHWSerial_AVR::pInstance[];
 
 
 /**************************
  * PRIVATE METHODS
 **************************/
 
-#if defined(HAVE_HWSERIAL0)
-  /**
-    \brief      Static callback function for AVR Serial0 error
-    \details    Static callback function for AVR Serial0 error
-                Note: received BREAK byte is consumed here to support also sync on SYNC byte. 
-    \param[in]  byte    received data
-    \param[in]  status  UART status byte
-  */
-  bool LIN_Slave_NeoHWSerial_AVR::_onSerialReceive0(uint8_t byte, uint8_t status)
-  {
-    // optional debug output (debug level 3)
-    #if defined(LIN_SLAVE_DEBUG_SERIAL) && (LIN_SLAVE_DEBUG_LEVEL >= 3)
-      LIN_SLAVE_DEBUG_SERIAL.print("LIN_Slave_NeoHWSerial_AVR::_onSerialReceive0()");
-      LIN_SLAVE_DEBUG_SERIAL.print(": Rx = 0x");
-      LIN_SLAVE_DEBUG_SERIAL.print(byte, HEX);
-      if (status & (0x01<< FE0))
-        LIN_SLAVE_DEBUG_SERIAL.println(", BREAK");
-      else
-        LIN_SLAVE_DEBUG_SERIAL.println();
-    #endif
-
-    // on BREAK (=0x00 with framing error) set class variable and don't store in queue (return false)
-    if ((byte ==0x00) && (status & (0x01<< FE0)))
-    {
-      (LIN_Slave_NeoHWSerial_AVR::flagBreak)[0] = true;
-      return false;
-    }
-
-    // return true -> byte is stored in Serial0 buffer
-    return true;
-
-  } // LIN_Slave_NeoHWSerial_AVR::_onSerialReceive0()
-#endif
-
-
-
-#if defined(HAVE_HWSERIAL1)
-  /**
-    \brief      Static callback function for AVR Serial1 error
-    \details    Static callback function for AVR Serial1 error
-                Note: received BREAK byte is consumed here to support also sync on SYNC byte. 
-    \param[in]  byte    received data
-    \param[in]  status  UART status byte
-  */
-  bool LIN_Slave_NeoHWSerial_AVR::_onSerialReceive1(uint8_t byte, uint8_t status)
-  { 
-    // optional debug output (debug level 3)
-    #if defined(LIN_SLAVE_DEBUG_SERIAL) && (LIN_SLAVE_DEBUG_LEVEL >= 3)
-      LIN_SLAVE_DEBUG_SERIAL.print("LIN_Slave_NeoHWSerial_AVR::_onSerialReceive1()");
-      LIN_SLAVE_DEBUG_SERIAL.print(": Rx = 0x");
-      LIN_SLAVE_DEBUG_SERIAL.print(byte, HEX);
-      if (status & (0x01<< FE1))
-        LIN_SLAVE_DEBUG_SERIAL.println(", BREAK");
-      else
-        LIN_SLAVE_DEBUG_SERIAL.println();
-    #endif
-
-    // on BREAK (=0x00 with framing error) set class variable and don't store in queue (return false)
-    if ((byte ==0x00) && (status & (0x01<< FE1)))
-    {
-      (LIN_Slave_NeoHWSerial_AVR::flagBreak)[1] = true;
-      return false;
-    }
+/**
+  \brief      Static callback function for AVR Serialx receive ISR
+  \details    Static callback function for AVR Serialx receive ISR. One function is generated per Serialx and dispatches to the attached LIN instance.
+              The receive time of each byte is captured here, i.e. independent of loop() jitter, see _getReceiveTime().
+              Note: received BREAK byte is consumed here to support also sync on SYNC byte. 
+  \tparam     IDX     index of Serialx, i.e. in pInstance[]
+  \tparam     FE      framing error bit in UART status byte
+  \param[in]  byte    received data
+  \param[in]  status  UART status byte
+  \return     true -> store byte in Serialx buffer, false -> drop byte
+*/
+template <uint8_t IDX, uint8_t FE> bool LIN_Slave_NeoHWSerial_AVR::_onSerialReceive(uint8_t byte, uint8_t status)
+{
+  LIN_Slave_NeoHWSerial_AVR   *pLIN = (LIN_Slave_NeoHWSerial_AVR::pInstance)[IDX];
+  uint32_t                    timeRx = micros();          // capture Rx time first, independent of loop() jitter
+
+  // optional debug output (debug level 3)
+  #if defined(LIN_SLAVE_DEBUG_SERIAL) && (LIN_SLAVE_DEBUG_LEVEL >= 3)
+    LIN_SLAVE_DEBUG_SERIAL.print("LIN_Slave_NeoHWSerial_AVR::_onSerialReceive<");
+    LIN_SLAVE_DEBUG_SERIAL.print((int) IDX);
+    LIN_SLAVE_DEBUG_SERIAL.print(">(): Rx = 0x");
+    LIN_SLAVE_DEBUG_SERIAL.print(byte, HEX);
+    if (status & (0x01 << FE))
+      LIN_SLAVE_DEBUG_SERIAL.println(", BREAK");
+    else
+      LIN_SLAVE_DEBUG_SERIAL.println();
+  #endif
 
-    // return true -> byte is stored in Serial1 buffer
+  // no LIN instance attached -> store byte in Serialx buffer
+  if (pLIN == nullptr)
     return true;
 
-  } // LIN_Slave_NeoHWSerial_AVR::_onSerialReceive1()
-#endif
-
-
+  // optionally handle byte or BREAK (=0x00 with framing error) incl. timeout in ISR. Don't store in queue (return false)
+  #if defined(LIN_SLAVE_HANDLER_IN_ISR)
+    pLIN->_handleReceiveISR(byte, (byte == 0x00) && (status & (0x01 << FE)), timeRx);
+    return false;
+  #else
 
-#if defined(HAVE_HWSERIAL2)
-  /**
-    \brief      Static callback function for AVR Serial2 error
-    \details    Static callback function for AVR Serial2 error
-                Note: received BREAK byte is consumed here to support also sync on SYNC byte. 
-    \param[in]  byte    received data
-    \param[in]  status  UART status byte
-  */
-  bool LIN_Slave_NeoHWSerial_AVR::_onSerialReceive2(uint8_t byte, uint8_t status)
-  {
-    // optional debug output (debug level 3)
-    #if defined(LIN_SLAVE_DEBUG_SERIAL) && (LIN_SLAVE_DEBUG_LEVEL >= 3)
-      LIN_SLAVE_DEBUG_SERIAL.print("LIN_Slave_NeoHWSerial_AVR::_onSerialReceive2()");
-      LIN_SLAVE_DEBUG_SERIAL.print(": Rx = 0x");
-      LIN_SLAVE_DEBUG_SERIAL.print(byte, HEX);
-      if (status & (0x01<< FE2))
-        LIN_SLAVE_DEBUG_SERIAL.println(", BREAK");
-      else
-        LIN_SLAVE_DEBUG_SERIAL.println();
-    #endif
-
-    // on BREAK (=0x00 with framing error) set class variable and don't store in queue (return false)
-    if ((byte ==0x00) && (status & (0x01<< FE2)))
+    // on BREAK set instance flag. Don't store in queue (return false)
+    if ((byte == 0x00) && (status & (0x01 << FE)))
     {
-      (LIN_Slave_NeoHWSerial_AVR::flagBreak)[2] = true;
+      pLIN->timeBreak = timeRx;
+      pLIN->flagBreak = true;
       return false;
     }
 
-    // return true -> byte is stored in Serial2 buffer
-    return true;
-
-  } // LIN_Slave_NeoHWSerial_AVR::_onSerialReceive2()
-#endif
-
-
-
-#if defined(HAVE_HWSERIAL3)
-  /**
-    \brief      Static callback function for AVR Serial3 error
-    \details    Static callback function for AVR Serial3 error
-                Note: received BREAK byte is consumed here to support also sync on SYNC byte. 
-    \param[in]  byte    received data
-    \param[in]  status  UART status byte
-  */
-  bool LIN_Slave_NeoHWSerial_AVR::_onSerialReceive3(uint8_t byte, uint8_t status)
-  {
-    // optional debug output (debug level 3)
-    #if defined(LIN_SLAVE_DEBUG_SERIAL) && (LIN_SLAVE_DEBUG_LEVEL >= 3)
-      LIN_SLAVE_DEBUG_SERIAL.print("LIN_Slave_NeoHWSerial_AVR::_onSerialReceive3()");
-      LIN_SLAVE_DEBUG_SERIAL.print(": Rx = 0x");
-      LIN_SLAVE_DEBUG_SERIAL.print(byte, HEX);
-      if (status & (0x01<< FE3))
-        LIN_SLAVE_DEBUG_SERIAL.println(", BREAK");
-      else
-        LIN_SLAVE_DEBUG_SERIAL.println();
+    // store receive time parallel to Serialx buffer. If full, oldest time is overwritten, see _getReceiveTime()
+    #if (LIN_SLAVE_AVR_RX_TIMES > 0)
+      pLIN->timeRx[pLIN->idxTimeRxWrite & (LIN_SLAVE_AVR_RX_TIMES-1)] = timeRx;
+      pLIN->idxTimeRxWrite = pLIN->idxTimeRxWrite + 1;
     #endif
 
-    // on BREAK (=0x00 with framing error) set class variable and don't store in queue (return false)
-    if ((byte ==0x00) && (status & (0x01<< FE3)))
-    {
-      (LIN_Slave_NeoHWSerial_AVR::flagBreak)[3] = true;
-      return false;
-    }
-
-    // return true -> byte is stored in Serial3 buffer
+    // return true -> byte is stored in Serialx buffer
     return true;
+  #endif
 
-  } // LIN_Slave_NeoHWSerial_AVR::_onSerialReceive3()
-#endif
+} // LIN_Slave_NeoHWSerial_AVR::_onSerialReceive()
 
 
 
@@ -176,8 +92,8 @@ bool LIN_Slave_NeoHWSerial_AVR::flagBreak[];
 */
 bool LIN_Slave_NeoHWSerial_AVR::_getBreakFlag()
 {
-  // return BREAK detection flag of respective Serialx
-  return (LIN_Slave_NeoHWSerial_AVR::flagBreak)[LIN_Slave_NeoHWSerial_AVR::idxSerial];
+  // return BREAK detection flag, is set in receive ISR
+  return this->flagBreak;
 
 } // LIN_Slave_NeoHWSerial_AVR::_getBreakFlag()
 
@@ -189,13 +105,91 @@ bool LIN_Slave_NeoHWSerial_AVR::_getBreakFlag()
 */
 void LIN_Slave_NeoHWSerial_AVR::_resetBreakFlag()
 {
-  // clear BREAK detection flag of respective Serialx
-  (LIN_Slave_NeoHWSerial_AVR::flagBreak)[LIN_Slave_NeoHWSerial_AVR::idxSerial] = false;
+  // clear BREAK detection flag
+  this->flagBreak = false;
 
 } // LIN_Slave_NeoHWSerial_AVR::_resetBreakFlag()
 
 
 
+/**
+  \brief      Read next byte from Rx buffer
+  \details    Read next byte from Rx buffer and drop its receive time. If the Rx buffer is empty afterwards, the receive times
+              are re-aligned to the Rx buffer, e.g. after a byte was dropped by NeoHWSerial due to a full buffer
+  \return     received byte
+*/
+uint8_t LIN_Slave_NeoHWSerial_AVR::_serialRead()
+{
+  uint8_t   byteReceived = pSerial->read();
+
+  // drop receive time of this byte
+  #if (LIN_SLAVE_AVR_RX_TIMES > 0) && !defined(LIN_SLAVE_HANDLER_IN_ISR)
+    (this->idxTimeRxRead)++;
+    noInterrupts();
+    if (!(pSerial->available()))
+      this->idxTimeRxRead = this->idxTimeRxWrite;
+    interrupts();
+  #endif
+
+  // return received byte
+  return byteReceived;
+
+} // LIN_Slave_NeoHWSerial_AVR::_serialRead()
+
+
+
+/**
+  \brief      Get receive time of next byte
+  \details    Get receive time [us] of next byte in Rx buffer as captured in receive ISR, i.e. must be called before _serialRead().
+              If the time was already overwritten (more than LIN_SLAVE_AVR_RX_TIMES bytes pending) or LIN_SLAVE_AVR_RX_TIMES is 0,
+              use the current time instead
+  \return     receive time [us]
+*/
+uint32_t LIN_Slave_NeoHWSerial_AVR::_getReceiveTime()
+{
+  #if (LIN_SLAVE_AVR_RX_TIMES > 0) && !defined(LIN_SLAVE_HANDLER_IN_ISR)
+    uint8_t   numPending;
+    uint32_t  time;
+
+    // 32-bit time is written in ISR -> read atomically
+    noInterrupts();
+    numPending = (uint8_t) (this->idxTimeRxWrite - this->idxTimeRxRead);
+    time = this->timeRx[this->idxTimeRxRead & (LIN_SLAVE_AVR_RX_TIMES-1)];
+    interrupts();
+
+    // time of next byte is still buffered
+    if ((numPending > 0) && (numPending <= LIN_SLAVE_AVR_RX_TIMES))
+      return time;
+  #endif
+
+  // fallback: poll time
+  return micros();
+
+} // LIN_Slave_NeoHWSerial_AVR::_getReceiveTime()
+
+
+
+/**
+  \brief      Change baudrate of open serial interface
+  \details    Change baudrate of open serial interface, e.g. for auto-baud detection or clock trim. Nominal baudrate is not changed
+  \param[in]  Baudrate   new communication baudrate [Baud]
+*/
+void LIN_Slave_NeoHWSerial_AVR::_setBaudrate(uint32_t Baudrate)
+{
+  // re-open serial interface with new baudrate. Rx ISR remains attached
+  pSerial->begin(Baudrate);
+
+  // Rx buffer is cleared -> also drop receive times
+  #if (LIN_SLAVE_AVR_RX_TIMES > 0) && !defined(LIN_SLAVE_HANDLER_IN_ISR)
+    noInterrupts();
+    this->idxTimeRxRead = this->idxTimeRxWrite;
+    interrupts();
+  #endif
+
+} // LIN_Slave_NeoHWSerial_AVR::_setBaudrate()
+
+
+
 /**************************
  * PUBLIC METHODS
 **************************/
@@ -206,17 +200,22 @@ void LIN_Slave_NeoHWSerial_AVR::_resetBreakFlag()
   \param[in]  Interface       serial interface for LIN. Use NeoHWSerial for attachInterrupt() support
   \param[in]  Version         LIN protocol version (default = v2)
   \param[in]  NameLIN         LIN node name (default = "Slave")
-  \param[in]  TimeoutRx       timeout [us] for bytes in frame (default = 1500)
+  \param[in]  TimeoutRx       timeout [us] for bytes in frame at 19200 Baud, scales with baudrate (default = 1500)
   \param[in]  PinTxEN     optional Tx enable pin (high active) e.g. for LIN via RS485 (default = -127/none)
 */
 LIN_Slave_NeoHWSerial_AVR::LIN_Slave_NeoHWSerial_AVR(NeoHWSerial &Interface, 
   LIN_Slave_Base::version_t Version, const char NameLIN[], uint32_t TimeoutRx, const int8_t PinTxEN) : 
-  LIN_Slave_Base::LIN_Slave_Base(Version, NameLIN, TimeoutRx, PinTxEN)
+  LIN_Slave_Static<LIN_Slave_NeoHWSerial_AVR>(Version, NameLIN, TimeoutRx, PinTxEN)
 {  
   // Debug serial initialized in begin() -> no debug output here
 
   // store parameters in class variables
   this->pSerial    = &Interface;          // pointer to used HW serial
+  this->idxSerial  = 0;                   // index of Serialx, is set in begin()
+  #if (LIN_SLAVE_AVR_RX_TIMES > 0) && !defined(LIN_SLAVE_HANDLER_IN_ISR)
+    this->idxTimeRxWrite = 0;             // no receive times buffered
+    this->idxTimeRxRead  = 0;
+  #endif
 
 } // LIN_Slave_NeoHWSerial_AVR::LIN_Slave_NeoHWSerial_AVR()
 
@@ -227,7 +226,7 @@ LIN_Slave_NeoHWSerial_AVR::LIN_Slave_NeoHWSerial_AVR(NeoHWSerial &Interface,
   \details    Open serial interface with specified baudrate
   \param[in]  Baudrate    communication speed [Baud] (default = 19200)
 */
-void LIN_Slave_NeoHWSerial_AVR::begin(uint16_t Baudrate)
+void LIN_Slave_NeoHWSerial_AVR::begin(uint32_t Baudrate)
 {
   // call base class method
   LIN_Slave_Base::begin(Baudrate);  
@@ -237,38 +236,54 @@ void LIN_Slave_NeoHWSerial_AVR::begin(uint16_t Baudrate)
   pSerial->begin(this->baudrate);
   while(!(*pSerial)) { }
 
-  // Attach corresponding error callback to Serialx receive handler
-  #if defined(HAVE_HWSERIAL0)
-    if (pSerial == &NeoSerial)
-    { 
-      LIN_Slave_NeoHWSerial_AVR::idxSerial = 0;
-      pSerial->attachInterrupt(LIN_Slave_NeoHWSerial_AVR::_onSerialReceive0);
-    }
-  #endif
-  #if defined(HAVE_HWSERIAL1)
-    if (pSerial == &NeoSerial1)
-    { 
-      LIN_Slave_NeoHWSerial_AVR::idxSerial = 1;
-      pSerial->attachInterrupt(LIN_Slave_NeoHWSerial_AVR::_onSerialReceive1);
-    }
-  #endif
-  #if defined(HAVE_HWSERIAL2)
-    if (pSerial == &NeoSerial2)
-    { 
-      LIN_Slave_NeoHWSerial_AVR::idxSerial = 2;
-      pSerial->attachInterrupt(LIN_Slave_NeoHWSerial_AVR::_onSerialReceive2);
-    }
-  #endif
-  #if defined(HAVE_HWSERIAL3)
-    if (pSerial == &NeoSerial3)
-    { 
-      LIN_Slave_NeoHWSerial_AVR::idxSerial = 3;
-      pSerial->attachInterrupt(LIN_Slave_NeoHWSerial_AVR::_onSerialReceive3);
+  // table of Serialx and corresponding receive callbacks. Index = Serialx, missing ports below max. index are empty placeholders
+  static const struct
+  {
+    NeoHWSerial   *pSerial;
+    bool          (*fct)(uint8_t, uint8_t);
+  } tablePort[LIN_SLAVE_AVR_MAX_SERIAL] =
+  {
+    #if defined(HAVE_HWSERIAL0)
+      { &NeoSerial,  LIN_Slave_NeoHWSerial_AVR::_onSerialReceive<0, FE0> },
+    #else
+      { nullptr, nullptr },
+    #endif
+    #if defined(HAVE_HWSERIAL1)
+      { &NeoSerial1, LIN_Slave_NeoHWSerial_AVR::_onSerialReceive<1, FE1> },
+    #elif (LIN_SLAVE_AVR_MAX_SERIAL > 1)
+      { nullptr, nullptr },
+    #endif
+    #if defined(HAVE_HWSERIAL2)
+      { &NeoSerial2, LIN_Slave_NeoHWSerial_AVR::_onSerialReceive<2, FE2> },
+    #elif (LIN_SLAVE_AVR_MAX_SERIAL > 2)
+      { nullptr, nullptr },
+    #endif
+    #if defined(HAVE_HWSERIAL3)
+      { &NeoSerial3, LIN_Slave_NeoHWSerial_AVR::_onSerialReceive<3, FE3> },
+    #elif (LIN_SLAVE_AVR_MAX_SERIAL > 3)
+      { nullptr, nullptr },
+    #endif
+  };
+
+  // attach this instance and corresponding callback to Serialx receive ISR
+  for (uint8_t idx = 0; idx < LIN_SLAVE_AVR_MAX_SERIAL; idx++)
+  {
+    if ((tablePort[idx].pSerial != nullptr) && (pSerial == tablePort[idx].pSerial))
+    {
+      this->idxSerial = idx;
+      (LIN_Slave_NeoHWSerial_AVR::pInstance)[idx] = this;
+      pSerial->attachInterrupt(tablePort[idx].fct);
+      break;
     }
-  #endif
+  }
 
   // initialize variables
   this->_resetBreakFlag();
+  #if (LIN_SLAVE_AVR_RX_TIMES > 0) && !defined(LIN_SLAVE_HANDLER_IN_ISR)
+    noInterrupts();
+    this->idxTimeRxRead = this->idxTimeRxWrite;
+    interrupts();
+  #endif
 
   // optional debug output (debug level 2)
   #if defined(LIN_SLAVE_DEBUG_SERIAL) && (LIN_SLAVE_DEBUG_LEVEL >= 2)
@@ -292,6 +307,10 @@ void LIN_Slave_NeoHWSerial_AVR::end()
   // close serial interface
   pSerial->end();
 
+  // detach instance from receive ISR
+  if ((LIN_Slave_NeoHWSerial_AVR::pInstance)[LIN_Slave_NeoHWSerial_AVR::idxSerial] == this)
+    (LIN_Slave_NeoHWSerial_AVR::pInstance)[LIN_Slave_NeoHWSerial_AVR::idxSerial] = nullptr;
+
   // optional debug output (debug level 2)
   #if defined(LIN_SLAVE_DEBUG_SERIAL) && (LIN_SLAVE_DEBUG_LEVEL >= 2)
     LIN_SLAVE_DEBUG_SERIAL.print(this->nameLIN);
@@ -10,6 +10,9 @@
 // comment out to use HardwareSerial (sync on inter-frame pause) instead of NeoHWSerial (sync on BREAK)
 #define USE_NEOSERIAL
 
+// uncomment to run LIN state machine inside the UART receive ISR -> minimal response latency. Note: all callbacks then run in ISR context
+//#define LIN_SLAVE_HANDLER_IN_ISR
+
 // for AVR platform use NeoHWSerial or comment out USE_NEOSERIAL above
 #if defined(ARDUINO_ARCH_AVR) && defined (USE_NEOSERIAL) && !defined(ARDUINO_AVR_TRINKET3) && !defined(ARDUINO_AVR_TRINKET5)
 
@@ -27,7 +30,33 @@
 
 // include required libraries
 #include <NeoHWSerial.h>
-#include <LIN_slave_Base.h>
+#include <LIN_slave_Static.h>
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL MACROS
+-----------------------------------------------------------------------------*/
+
+/// Number of AVR Serial interfaces, i.e. highest index + 1
+#if defined(HAVE_HWSERIAL3)
+  #define LIN_SLAVE_AVR_MAX_SERIAL   4
+#elif defined(HAVE_HWSERIAL2)
+  #define LIN_SLAVE_AVR_MAX_SERIAL   3
+#elif defined(HAVE_HWSERIAL1)
+  #define LIN_SLAVE_AVR_MAX_SERIAL   2
+#elif defined(HAVE_HWSERIAL0)
+  #define LIN_SLAVE_AVR_MAX_SERIAL   1
+#else
+  #error no HardwareSerial available for this board
+#endif
+
+// number of receive times [us] captured in Rx ISR per instance, parallel to Rx buffer. Each requires 4B RAM. Use 0 for poll time in handler()
+#if !defined(LIN_SLAVE_AVR_RX_TIMES)
+  #define LIN_SLAVE_AVR_RX_TIMES    16        //!< number of buffered receive times (0 or power of 2 up to 128)
+#endif
+#if (LIN_SLAVE_AVR_RX_TIMES > 128) || ((LIN_SLAVE_AVR_RX_TIMES & (LIN_SLAVE_AVR_RX_TIMES-1)) != 0)
+  #error LIN_SLAVE_AVR_RX_TIMES must be 0 or a power of 2 up to 128
+#endif
 
 
 /*-----------------------------------------------------------------------------
@@ -39,48 +68,41 @@
 
   \details LIN slave node class via AVR NeoHWSerial.
 */
-class LIN_Slave_NeoHWSerial_AVR : public LIN_Slave_Base
+class LIN_Slave_NeoHWSerial_AVR : public LIN_Slave_Static<LIN_Slave_NeoHWSerial_AVR>
 {
+  // static binding of serial interface methods in handler()
+  friend class LIN_Slave_Static<LIN_Slave_NeoHWSerial_AVR>;
+
   // PRIVATE VARIABLES
   private:
 
     NeoHWSerial           *pSerial;                             //!< pointer to serial interface used for LIN
-    uint8_t               idxSerial;                            //!< index to flagBreak[] of this instance
-    #if defined(HAVE_HWSERIAL3)
-      static bool           flagBreak[4];                       //!< break flags for Serial0..3
-    #elif defined(HAVE_HWSERIAL2)
-      static bool           flagBreak[3];                       //!< break flags for Serial0..2
-    #elif defined(HAVE_HWSERIAL1)
-      static bool           flagBreak[2];                       //!< break flags for Serial0..1
-    #elif defined(HAVE_HWSERIAL0)
-      static bool           flagBreak[1];                       //!< break flags for Serial0
+    uint8_t               idxSerial;                            //!< index of Serialx used by this instance
+    static LIN_Slave_NeoHWSerial_AVR *pInstance[LIN_SLAVE_AVR_MAX_SERIAL];  //!< LIN instances attached to Serial0..N, for receive ISR
+
+    #if (LIN_SLAVE_AVR_RX_TIMES > 0) && !defined(LIN_SLAVE_HANDLER_IN_ISR)
+      volatile uint32_t   timeRx[LIN_SLAVE_AVR_RX_TIMES];       //!< receive times [us] of bytes in Rx buffer, captured in receive ISR
+      volatile uint8_t    idxTimeRxWrite;                       //!< free running write index of timeRx[], is incremented in receive ISR
+      uint8_t             idxTimeRxRead;                        //!< free running read index of timeRx[], is incremented by _serialRead()
+    #endif
+
+
+  // PROTECTED VARIABLES
+  protected:
+
+    /// LIN state machine runs in receive ISR -> handler() must not check timeout, see LIN_Slave_Static::handler()
+    #if defined(LIN_SLAVE_HANDLER_IN_ISR)
+      static const bool   flagHandlerISR = true;
     #else
-      #error no HardwareSerial available for this board
+      static const bool   flagHandlerISR = false;
     #endif
 
 
   // PRIVATE METHODS
   private:
 
-    #if defined(HAVE_HWSERIAL0)
-      /// @brief Static callback function for AVR Serial0 receive ISR
-      static bool _onSerialReceive0(uint8_t byte, uint8_t status);
-    #endif
-  
-    #if defined(HAVE_HWSERIAL1)
-      /// @brief Static callback function for AVR Serial1 receive ISR
-      static bool _onSerialReceive1(uint8_t byte, uint8_t status);
-    #endif
-  
-    #if defined(HAVE_HWSERIAL2)
-      /// @brief Static callback function for AVR Serial2 receive ISR
-      static bool _onSerialReceive2(uint8_t byte, uint8_t status);
-    #endif
-  
-    #if defined(HAVE_HWSERIAL3)
-      /// @brief Static callback function for AVR Serial3 receive ISR
-      static bool _onSerialReceive3(uint8_t byte, uint8_t status);
-    #endif
+    /// @brief Static callback function for AVR Serialx receive ISR. Is generated per Serialx index IDX and framing error bit FE
+    template <uint8_t IDX, uint8_t FE> static bool _onSerialReceive(uint8_t byte, uint8_t status);
   
 
   // PROTECTED METHODS
@@ -97,11 +119,17 @@ class LIN_Slave_NeoHWSerial_AVR : public LIN_Slave_Base
     inline uint8_t _serialPeek(void) { return pSerial->peek(); }
 
     /// @brief read next byte from Rx buffer
-    inline uint8_t _serialRead(void) { return pSerial->read(); }
+    uint8_t _serialRead(void);
+
+    /// @brief receive time [us] of next byte in Rx buffer, as captured in receive ISR
+    uint32_t _getReceiveTime(void);
 
     /// @brief write bytes to Tx buffer
     inline void _serialWrite(uint8_t buf[], uint8_t num) { pSerial->write(buf, num); }
 
+    /// @brief Change baudrate of open serial interface, e.g. for auto-baud
+    virtual void _setBaudrate(uint32_t Baudrate);
+
 
   // PUBLIC METHODS
   public:
@@ -111,7 +139,7 @@ class LIN_Slave_NeoHWSerial_AVR : public LIN_Slave_Base
       LIN_Slave_Base::version_t Version = LIN_Slave_Base::LIN_V2, const char NameLIN[] = "Slave", uint32_t TimeoutRx = 1500L, const int8_t PinTxEN = INT8_MIN);
      
     /// @brief Open serial interface
-    void begin(uint16_t Baudrate = 19200);
+    void begin(uint32_t Baudrate = 19200);
     
     /// @brief Close serial interface
     void end(void);
@@ -0,0 +1,200 @@
+/**
+  \file     LIN_slave_Protocol.h
+  \brief    LIN protocol kernel for PID and checksum
+  \details  Header-only, hardware independent helpers for LIN protected ID (PID) and frame checksum.
+            PID and seed tables are hand-written literals, which checkTables() verifies via static_assert
+            against the parity equations of the LIN spec, so no bit shuffling is required at runtime.
+            Only requires <stdint.h> and C++11, i.e. can also be used on a host PC.
+  \author   Georg Icking-Konert
+*/
+
+/*-----------------------------------------------------------------------------
+  MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _LIN_SLAVE_PROTOCOL_H_
+#define _LIN_SLAVE_PROTOCOL_H_
+
+
+/*-----------------------------------------------------------------------------
+  INCLUDE FILES
+-----------------------------------------------------------------------------*/
+
+#include <stdint.h>
+
+// on AVR store tables in flash to save RAM
+#if defined(__AVR__)
+  #include <avr/pgmspace.h>
+  #define LIN_SLAVE_PROTOCOL_FLASH          PROGMEM                       //!< attribute for constant tables
+  #define LIN_SLAVE_PROTOCOL_READ(addr)     pgm_read_byte(addr)           //!< read byte from constant table
+  #define LIN_SLAVE_PROTOCOL_COPY(dst,src,n)  memcpy_P(dst,src,n)         //!< copy bytes from constant table
+#else
+  #include <string.h>
+  #define LIN_SLAVE_PROTOCOL_FLASH                                        //!< attribute for constant tables
+  #define LIN_SLAVE_PROTOCOL_READ(addr)     (*(const uint8_t*)(addr))     //!< read byte from constant table
+  #define LIN_SLAVE_PROTOCOL_COPY(dst,src,n)  memcpy(dst,src,n)           //!< copy bytes from constant table
+#endif
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL NAMESPACE
+-----------------------------------------------------------------------------*/
+
+/**
+  \brief  LIN protocol kernel
+
+  \details LIN protocol kernel for PID and checksum. Shared by all LIN slave backends.
+*/
+namespace LIN_Slave_Protocol
+{
+
+  /**
+    \brief      Calculate protected ID (compile time)
+    \details    Calculate protected ID by adding parity bits PI0 (bit 6) and PI1 (bit 7), see LIN spec "2.3.1.3 Protected identifier field".
+                Only used for checking tables, at runtime use getPID()
+    \param[in]  ID    frame ID (only bits 0..5 are used)
+    \return     protected frame ID
+  */
+  constexpr uint8_t calculatePID(uint8_t ID)
+  {
+    return (uint8_t) ((ID & 0x3F) |
+      ((((ID) ^ (ID>>1) ^ (ID>>2) ^ (ID>>4)) & 0x01) << 6) |       // PI0 = ID0^ID1^ID2^ID4
+      ((~((ID>>1) ^ (ID>>3) ^ (ID>>4) ^ (ID>>5)) & 0x01) << 7));   // PI1 = ~(ID1^ID3^ID4^ID5)
+  }
+
+
+  /// protected ID for frame ID 0x00..0x3F
+  constexpr uint8_t tablePID[64] LIN_SLAVE_PROTOCOL_FLASH =
+  {
+    0x80, 0xC1, 0x42, 0x03, 0xC4, 0x85, 0x06, 0x47,
+    0x08, 0x49, 0xCA, 0x8B, 0x4C, 0x0D, 0x8E, 0xCF,
+    0x50, 0x11, 0x92, 0xD3, 0x14, 0x55, 0xD6, 0x97,
+    0xD8, 0x99, 0x1A, 0x5B, 0x9C, 0xDD, 0x5E, 0x1F,
+    0x20, 0x61, 0xE2, 0xA3, 0x64, 0x25, 0xA6, 0xE7,
+    0xA8, 0xE9, 0x6A, 0x2B, 0xEC, 0xAD, 0x2E, 0x6F,
+    0xF0, 0xB1, 0x32, 0x73, 0xB4, 0xF5, 0x76, 0x37,
+    0x78, 0x39, 0xBA, 0xFB, 0x3C, 0x7D, 0xFE, 0xBF
+  };
+
+
+  /// LIN2.x checksum seed for frame ID 0x00..0x3F. Is PID, except diagnostic frames 0x3C/0x3D which use classic checksum
+  constexpr uint8_t tableSeed[64] LIN_SLAVE_PROTOCOL_FLASH =
+  {
+    0x80, 0xC1, 0x42, 0x03, 0xC4, 0x85, 0x06, 0x47,
+    0x08, 0x49, 0xCA, 0x8B, 0x4C, 0x0D, 0x8E, 0xCF,
+    0x50, 0x11, 0x92, 0xD3, 0x14, 0x55, 0xD6, 0x97,
+    0xD8, 0x99, 0x1A, 0x5B, 0x9C, 0xDD, 0x5E, 0x1F,
+    0x20, 0x61, 0xE2, 0xA3, 0x64, 0x25, 0xA6, 0xE7,
+    0xA8, 0xE9, 0x6A, 0x2B, 0xEC, 0xAD, 0x2E, 0x6F,
+    0xF0, 0xB1, 0x32, 0x73, 0xB4, 0xF5, 0x76, 0x37,
+    0x78, 0x39, 0xBA, 0xFB, 0x00, 0x00, 0xFE, 0xBF
+  };
+
+
+  /**
+    \brief      Calculate LIN2.x checksum seed (compile time)
+    \details    Calculate LIN2.x checksum seed. Diagnostic frames 0x3C and 0x3D always use classic checksum (see LIN spec "2.3.1.5 Checksum").
+                Only used for checking tables, at runtime use getSeed()
+    \param[in]  ID    frame ID (only bits 0..5 are used)
+    \return     initial checksum value
+  */
+  constexpr uint8_t calculateSeed(uint8_t ID)
+  {
+    return (((ID & 0x3F) == 0x3C) || ((ID & 0x3F) == 0x3D)) ? 0x00 : calculatePID(ID);
+  }
+
+
+  /**
+    \brief      Check tables against parity equations (compile time)
+    \details    Recursively check tablePID[] and tableSeed[] against calculatePID() and calculateSeed()
+    \param[in]  ID    first frame ID to check
+    \return     true if all entries from ID up to 0x3F are correct
+  */
+  constexpr bool checkTables(uint8_t ID = 0)
+  {
+    return (ID > 0x3F) || ((tablePID[ID] == calculatePID(ID)) && (tableSeed[ID] == calculateSeed(ID)) && checkTables(ID+1));
+  }
+
+
+  /**
+    \brief      Add byte to checksum
+    \details    Add byte to checksum with end-around carry, i.e. a carry out of bit 7 is added to bit 0
+    \param[in]  Sum   current (non-inverted) checksum
+    \param[in]  Byte  byte to add
+    \return     updated checksum
+  */
+  constexpr uint8_t checksumAdd(uint8_t Sum, uint8_t Byte)
+  {
+    return (uint8_t) ((Sum + Byte) + ((Sum + Byte) >> 8));
+  }
+
+
+  /**
+    \brief      Calculate checksum over buffer
+    \details    Calculate final, i.e. inverted checksum over data buffer. Can also be evaluated at compile time
+    \param[in]  Seed      initial checksum value, see getSeed()
+    \param[in]  Data      frame data bytes
+    \param[in]  NumData   number of data bytes
+    \return     frame checksum
+  */
+  constexpr uint8_t checksum(uint8_t Seed, const uint8_t Data[], uint8_t NumData)
+  {
+    return (NumData == 0) ? (uint8_t) (~Seed) : checksum(checksumAdd(Seed, Data[0]), Data+1, NumData-1);
+  }
+
+
+  // verify tables and checksum at compile time (example frame from LIN spec)
+  constexpr uint8_t _testData[3] = { 0x55, 0x93, 0xE5 };
+  static_assert(checkTables(), "LIN PID or checksum seed table corrupt");
+  static_assert(calculatePID(0x3C) == 0x3C, "LIN PID calculation failed for 0x3C");
+  static_assert(calculatePID(0x3D) == 0x7D, "LIN PID calculation failed for 0x3D");
+  static_assert(checksumAdd(0xF0, 0x20) == 0x11, "LIN checksum carry failed");
+  static_assert(checksum(0x4A, _testData, 3) == 0xE6, "LIN checksum calculation failed");
+
+
+  /**
+    \brief      Get protected ID
+    \details    Get protected ID for frame ID via table lookup
+    \param[in]  ID    frame ID (only bits 0..5 are used)
+    \return     protected frame ID
+  */
+  inline uint8_t getPID(uint8_t ID)
+  {
+    return LIN_SLAVE_PROTOCOL_READ(&(tablePID[ID & 0x3F]));
+  }
+
+
+  /**
+    \brief      Check protected ID
+    \details    Check parity bits of received protected ID. Is a single table lookup and compare
+    \param[in]  PID   received protected frame ID
+    \return     true if parity is correct
+  */
+  inline bool isValidPID(uint8_t PID)
+  {
+    return (getPID(PID) == PID);
+  }
+
+
+  /**
+    \brief      Get checksum seed
+    \details    Get initial checksum value for a frame ID
+    \param[in]  ID        frame ID (only bits 0..5 are used)
+    \param[in]  Enhanced  true: LIN2.x enhanced checksum, false: LIN1.x classic checksum
+    \return     initial checksum value
+  */
+  inline uint8_t getSeed(uint8_t ID, bool Enhanced)
+  {
+    return Enhanced ? LIN_SLAVE_PROTOCOL_READ(&(tableSeed[ID & 0x3F])) : 0x00;
+  }
+
+} // namespace LIN_Slave_Protocol
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _LIN_SLAVE_PROTOCOL_H_
+
+/*-----------------------------------------------------------------------------
+    END OF FILE
+-----------------------------------------------------------------------------*/
@@ -45,6 +45,37 @@ void LIN_Slave_SoftwareSerial::_resetBreakFlag()
 
 
 
+/**
+  \brief      Change baudrate of open serial interface
+  \details    Change baudrate of open serial interface, e.g. for auto-baud detection or clock trim. Nominal baudrate is not changed
+  \param[in]  Baudrate   new communication baudrate [Baud]
+*/
+void LIN_Slave_SoftwareSerial::_setBaudrate(uint32_t Baudrate)
+{
+  // re-open serial interface with new baudrate, which also re-calculates the bit delays
+  this->SWSerial.end();
+  this->SWSerial.begin(Baudrate);
+
+} // LIN_Slave_SoftwareSerial::_setBaudrate()
+
+
+
+/**
+  \brief      Update timing parameters
+  \details    Update timing parameters [us] from bit times after change of nominal baudrate, incl. min. inter-frame pause
+*/
+void LIN_Slave_SoftwareSerial::_updateTiming()
+{
+  // call base class method
+  LIN_Slave_Base::_updateTiming();
+
+  // min. inter-frame pause [us] for new baudrate
+  this->minFramePause = this->_bitsToTime(this->bitsFramePause);
+
+} // LIN_Slave_SoftwareSerial::_updateTiming()
+
+
+
 /**************************
  * PUBLIC METHODS
 **************************/
@@ -55,15 +86,15 @@ void LIN_Slave_SoftwareSerial::_resetBreakFlag()
   \param[in]  PinRx         GPIO used for reception
   \param[in]  PinTx         GPIO used for transmission
   \param[in]  InverseLogic  use inverse logic (default = false)
-  \param[in]  MinFramePause min. inter-frame pause [us] to detect new frame (default = 1000)
+  \param[in]  MinFramePause min. inter-frame pause [us] to detect new frame at 19200 Baud, scales with baudrate (default = 1000)
   \param[in]  Version       LIN protocol version (default = v2)
   \param[in]  NameLIN       LIN node name (default = "Slave")
-  \param[in]  TimeoutRx     timeout [us] for bytes in frame (default = 1500)
+  \param[in]  TimeoutRx     timeout [us] for bytes in frame at 19200 Baud, scales with baudrate (default = 1500)
   \param[in]  PinTxEN       optional Tx enable pin (high active) e.g. for LIN via RS485 (default = -127/none)
 */
 LIN_Slave_SoftwareSerial::LIN_Slave_SoftwareSerial(uint8_t PinRx, uint8_t PinTx, bool InverseLogic, uint16_t MinFramePause, 
   LIN_Slave_Base::version_t Version, const char NameLIN[], uint32_t TimeoutRx, const int8_t PinTxEN):
-  LIN_Slave_Base(Version, NameLIN, TimeoutRx, PinTxEN), SWSerial(PinRx, PinTx, InverseLogic)
+  LIN_Slave_Static<LIN_Slave_SoftwareSerial>(Version, NameLIN, TimeoutRx, PinTxEN), SWSerial(PinRx, PinTx, InverseLogic)
 {  
   // Debug serial initialized in begin() -> no debug output here
 
@@ -72,6 +103,8 @@ LIN_Slave_SoftwareSerial::LIN_Slave_SoftwareSerial(uint8_t PinRx, uint8_t PinTx,
   this->pinTx = PinTx;
   this->inverseLogic = InverseLogic;
   this->minFramePause = MinFramePause;
+  this->bitsFramePause = LIN_Slave_Base::_timeToBits(MinFramePause);
+  this->timeLastByte = 0;
 
 } // LIN_Slave_SoftwareSerial::LIN_Slave_SoftwareSerial()
 
@@ -82,7 +115,7 @@ LIN_Slave_SoftwareSerial::LIN_Slave_SoftwareSerial(uint8_t PinRx, uint8_t PinTx,
   \details    Open serial interface with specified baudrate
   \param[in]  Baudrate    communication speed [Baud] (default = 19200)
 */
-void LIN_Slave_SoftwareSerial::begin(uint16_t Baudrate)
+void LIN_Slave_SoftwareSerial::begin(uint32_t Baudrate)
 {
   // call base class method
   LIN_Slave_Base::begin(Baudrate);  
@@ -136,45 +169,51 @@ void LIN_Slave_SoftwareSerial::end()
 */
 void LIN_Slave_SoftwareSerial::handler()
 {
-  // sync frames based on inter-frame pause (not standard compliant!) 
-  static uint32_t   usLastByte = 0;
-  
+  // sync frames based on inter-frame pause (not standard compliant!). No Rx-ISR hook -> time is captured when polled
+  uint32_t  timeNow;
+
   // byte received -> check it
   if (this->available())
   {
+    timeNow = micros();
+
     // ESP32 & ESP8266 (BREAK is dropped due to missing stop bit): if SYNC=0x55 received and long time since last byte, start new frame  
     #if defined(ARDUINO_ARCH_ESP32) || defined(ARDUINO_ARCH_ESP8266)
-      if ((this->_serialPeek() == 0x55) && ((micros() - usLastByte) > this->minFramePause))
+      if ((this->_serialPeek() == 0x55) && ((timeNow - this->timeLastByte) > this->minFramePause))
       {
+        this->timeBreak = timeNow;
         this->flagBreak = true;
       }
 
     // other architectures (BREAK is received): if BREAK=0x00 received and long time since last byte, start new frame and remove 0x00 from queue
     #else
-      if ((this->_serialPeek() == 0x00) && ((micros() - usLastByte) > this->minFramePause))
+      if ((this->_serialPeek() == 0x00) && ((timeNow - this->timeLastByte) > this->minFramePause))
       {
+        this->timeBreak = timeNow;
         this->flagBreak = true;
         this->_serialRead();
       }
     #endif
 
     // store time of this receive
-    usLastByte = micros();
-
-    // call base-class handler
-    LIN_Slave_Base::handler();
+    this->timeLastByte = timeNow;
 
-    // SoftwareSerial is blocking while sending -> skip reading echo
-    if (this->state == LIN_Slave_Base::STATE_RECEIVING_ECHO)
-    {
-      // propagate to DONE immediately
-      this->state = LIN_Slave_Base::STATE_DONE;
+  } // if byte received
 
-      // optionally disable RS485 transmitter
-      _disableTransmitter();
-    }
+  // call base-class handler. Also without received byte for timeout check
+  LIN_Slave_Static<LIN_Slave_SoftwareSerial>::handler();
 
-  } // if byte received
+  // SoftwareSerial is blocking while sending -> skip reading echo
+  if (this->state == LIN_Slave_Base::STATE_RECEIVING_ECHO)
+  {
+    // propagate to DONE immediately. Store and log frame like after last echo byte, see _handleByte()
+    this->state = LIN_Slave_Base::STATE_DONE;
+    this->_pushFrame();
+    this->_log(LIN_Slave_Base::LOG_FRAME_OK, this->numData, micros());
+
+    // optionally disable RS485 transmitter
+    _disableTransmitter();
+  }
 
 } // LIN_Slave_SoftwareSerial::handler()
 
@@ -22,7 +22,7 @@
 -----------------------------------------------------------------------------*/
 
 // include required libraries
-#include <LIN_slave_Base.h>
+#include <LIN_slave_Static.h>
 #include <SoftwareSerial.h>
 
 
@@ -35,8 +35,11 @@
 
   \details LIN slave node class via generic SoftwareSerial.
 */
-class LIN_Slave_SoftwareSerial : public LIN_Slave_Base
+class LIN_Slave_SoftwareSerial : public LIN_Slave_Static<LIN_Slave_SoftwareSerial>
 {
+  // static binding of serial interface methods in handler()
+  friend class LIN_Slave_Static<LIN_Slave_SoftwareSerial>;
+
   // PRIVATE VARIABLES
   private:
 
@@ -44,8 +47,9 @@ class LIN_Slave_SoftwareSerial : public LIN_Slave_Base
     uint8_t               pinRx;              //!< pin used for receive
     uint8_t               pinTx;              //!< pin used for transmit
     bool                  inverseLogic;       //!< use inverse logic
-    bool                  flagBreak;          //!< a break was detected, is set in handle
-    uint16_t              minFramePause;      //!< min. inter-frame pause [us] to start new frame (not standard compliant!)
+    uint16_t              bitsFramePause;     //!< min. inter-frame pause [bit times] to start new frame (not standard compliant!)
+    uint32_t              minFramePause;      //!< min. inter-frame pause [us], derived from bitsFramePause and baudrate
+    uint32_t              timeLastByte;     //!< time [us] of last received byte, for inter-frame pause detection
 
 
   // PROTECTED METHODS
@@ -73,6 +77,12 @@ class LIN_Slave_SoftwareSerial : public LIN_Slave_Base
       SWSerial.listen();
     }
 
+    /// @brief Change baudrate of open serial interface, e.g. for auto-baud
+    virtual void _setBaudrate(uint32_t Baudrate);
+
+    /// @brief Update timing parameters [us] after change of nominal baudrate
+    virtual void _updateTiming(void);
+
 
   // PUBLIC METHODS
   public:
@@ -82,7 +92,7 @@ class LIN_Slave_SoftwareSerial : public LIN_Slave_Base
       LIN_Slave_Base::version_t Version = LIN_Slave_Base::LIN_V2, const char NameLIN[] = "Slave", uint32_t TimeoutRx = 1500L, const int8_t PinTxEN = INT8_MIN);
 
     /// @brief Open serial interface
-    void begin(uint16_t Baudrate = 19200);
+    void begin(uint32_t Baudrate = 19200);
     
     /// @brief Close serial interface
     void end(void);
@@ -0,0 +1,308 @@
+/**
+  \file     LIN_slave_Termios.cpp
+  \brief    LIN slave emulation library using a serial device via POSIX termios on Linux
+  \details  This library provides a slave node emulation for a LIN bus via a serial device on Linux, e.g. a USB-UART with LIN transceiver.
+            For an explanation of the LIN bus and protocol e.g. see https://en.wikipedia.org/wiki/Local_Interconnect_Network
+  \note     BREAK is detected via framing error marking of the tty driver (PARMRK), i.e. like the NeoHWSerial and ESP32 backends
+  \author   Georg Icking-Konert
+*/
+
+// assert Linux platform
+#if defined(__linux__)
+
+// include files
+#include <LIN_slave_Termios.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <asm/termbits.h>     // termios2 for arbitrary baudrates. Note: conflicts with <termios.h>
+
+
+
+/**************************
+ * PROTECTED METHODS
+**************************/
+
+/**
+  \brief      Get break detection flag
+  \details    Get break detection flag. Is hardware dependent
+  \return status of break detection
+*/
+bool LIN_Slave_Termios::_getBreakFlag()
+{
+  // return BREAK detection flag, is set in _decodeByte()
+  return this->flagBreak;
+
+} // LIN_Slave_Termios::_getBreakFlag()
+
+
+
+/**
+  \brief      Clear break detection flag. Is hardware dependent
+  \details    Clear break detection flag. Is hardware dependent
+*/
+void LIN_Slave_Termios::_resetBreakFlag()
+{
+  // clear BREAK detection flag
+  this->flagBreak = false;
+
+} // LIN_Slave_Termios::_resetBreakFlag()
+
+
+
+/**
+  \brief      Decode next data byte or BREAK from raw receive buffer
+  \details    Decode next data byte or BREAK from raw receive buffer. If buffer is empty, fetch all pending bytes with a single
+              non-blocking read(). With PARMRK the tty driver escapes a data byte 0xFF as 0xFF 0xFF and marks a byte x with
+              framing or parity error as 0xFF 0x00 x. A marked 0x00 is a BREAK.
+              Decoding stops at a BREAK, which keeps the order of BREAK and following bytes.
+              Note: tty driver provides no receive timestamps -> all bytes of a read() are assigned the time of the read() call
+  \return     true if a data byte is pending in bytePending
+*/
+bool LIN_Slave_Termios::_decodeByte()
+{
+  ssize_t   numRead;
+  uint8_t   byteRaw;
+
+  // decode raw bytes until a data byte or BREAK is found
+  while (true)
+  {
+    // raw buffer is empty -> fetch all pending bytes with a single non-blocking read()
+    if (this->idxRaw >= this->numRaw)
+    {
+      if (this->fd < 0)
+        return false;
+      numRead = read(this->fd, this->bufRaw, LIN_SLAVE_TERMIOS_BUFLEN);
+      if (numRead <= 0)
+        return false;
+      this->timeRead = micros();
+      this->idxRaw   = 0;
+      this->numRaw   = (uint8_t) numRead;
+    }
+
+    // get next raw byte
+    byteRaw = this->bufRaw[(this->idxRaw)++];
+
+    // handle error marks
+    switch (this->stateMark)
+    {
+      // no mark pending: 0xFF starts a mark, else data byte
+      case 0:
+        if (byteRaw == 0xFF)
+        {
+          this->stateMark = 1;
+          break;
+        }
+        this->bytePending = byteRaw;
+        return true;
+
+      // after 0xFF: 0x00 starts an error mark, else escaped data byte 0xFF
+      case 1:
+        if (byteRaw == 0x00)
+        {
+          this->stateMark = 2;
+          break;
+        }
+        this->stateMark = 0;
+        this->bytePending = byteRaw;
+        return true;
+
+      // after 0xFF 0x00: 0x00 is a BREAK, else data byte with framing or parity error (detected by checksum)
+      default:
+        this->stateMark = 0;
+        if (byteRaw == 0x00)
+        {
+          this->timeBreak = this->timeRead;
+          this->flagBreak = true;
+          return false;
+        }
+        this->bytePending = byteRaw;
+        return true;
+
+    } // switch (stateMark)
+
+  } // while (true)
+
+} // LIN_Slave_Termios::_decodeByte()
+
+
+
+/**
+  \brief      Write bytes to Tx buffer
+  \details    Write bytes to Tx buffer with a single write() call. Only repeat for the remainder if tty buffer is full
+  \param[in]  buf   bytes to send
+  \param[in]  num   number of bytes to send
+*/
+void LIN_Slave_Termios::_serialWrite(uint8_t buf[], uint8_t num)
+{
+  ssize_t   numWritten;
+
+  // write all bytes. Abort on error to not block handler()
+  while (num > 0)
+  {
+    numWritten = write(this->fd, buf, num);
+    if (numWritten <= 0)
+      return;
+    buf += numWritten;
+    num -= (uint8_t) numWritten;
+  }
+
+} // LIN_Slave_Termios::_serialWrite()
+
+
+
+/**
+  \brief      Change baudrate of open serial interface
+  \details    Change baudrate of open serial interface, e.g. for auto-baud detection or clock trim. Nominal baudrate is not changed
+  \param[in]  Baudrate   new communication baudrate [Baud]
+*/
+void LIN_Slave_Termios::_setBaudrate(uint32_t Baudrate)
+{
+  struct termios2   tio;
+
+  // interface not open -> do nothing
+  if (this->fd < 0)
+    return;
+
+  // set arbitrary input and output baudrate via termios2, e.g. 10417 Baud
+  if (ioctl(this->fd, TCGETS2, &tio) < 0)
+    return;
+  tio.c_cflag &= ~(CBAUD | (CBAUD << IBSHIFT));
+  tio.c_cflag |= (BOTHER | (BOTHER << IBSHIFT));
+  tio.c_ispeed = Baudrate;
+  tio.c_ospeed = Baudrate;
+  ioctl(this->fd, TCSETS2, &tio);
+
+} // LIN_Slave_Termios::_setBaudrate()
+
+
+
+/**************************
+ * PUBLIC METHODS
+**************************/
+
+/**
+  \brief      Constructor for LIN node class using a Linux serial device
+  \details    Constructor for LIN node class for using a Linux serial device. Inherit all methods from LIN_Slave_Base, only different constructor
+  \param[in]  Device      name of serial device, e.g. "/dev/ttyUSB0". Must remain valid until end()
+  \param[in]  Version     LIN protocol version (default = v2)
+  \param[in]  NameLIN     LIN node name (default = "Slave")
+  \param[in]  TimeoutRx   timeout [us] for bytes in frame at 19200 Baud, scales with baudrate (default = 1500)
+  \param[in]  PinTxEN     optional Tx enable pin (high active) e.g. for LIN via RS485 (default = -127/none)
+*/
+LIN_Slave_Termios::LIN_Slave_Termios(const char Device[], LIN_Slave_Base::version_t Version, const char NameLIN[],
+  uint32_t TimeoutRx, const int8_t PinTxEN) :
+  LIN_Slave_Static<LIN_Slave_Termios>(Version, NameLIN, TimeoutRx, PinTxEN)
+{
+  // Debug serial initialized in begin() -> no debug output here
+
+  // store parameters in class variables
+  this->nameDevice  = Device;             // name of serial device
+  this->fd          = -1;                 // device is opened in begin()
+
+  // initialize variables
+  this->idxRaw      = 0;
+  this->numRaw      = 0;
+  this->stateMark   = 0;
+  this->bytePending = -1;
+  this->timeRead    = 0;
+
+} // LIN_Slave_Termios::LIN_Slave_Termios()
+
+
+
+/**
+  \brief      Open serial interface
+  \details    Open serial interface with specified baudrate in raw 8N1 mode. Framing and parity errors incl. BREAK are marked
+              in the Rx stream (PARMRK). Device is opened non-blocking, i.e. handler() polls. On error state is set to STATE_OFF
+  \param[in]  Baudrate    communication speed [Baud] (default = 19200)
+*/
+void LIN_Slave_Termios::begin(uint32_t Baudrate)
+{
+  struct termios2   tio;
+
+  // call base class method
+  LIN_Slave_Base::begin(Baudrate);
+
+  // open serial device non-blocking
+  if (this->fd >= 0)
+    close(this->fd);
+  this->fd = open(this->nameDevice, O_RDWR | O_NOCTTY | O_NONBLOCK);
+  if ((this->fd < 0) || (ioctl(this->fd, TCGETS2, &tio) < 0))
+  {
+    // optional debug output (debug level 1)
+    #if defined(LIN_SLAVE_DEBUG_SERIAL) && (LIN_SLAVE_DEBUG_LEVEL >= 1)
+      LIN_SLAVE_DEBUG_SERIAL.print(this->nameLIN);
+      LIN_SLAVE_DEBUG_SERIAL.print(": LIN_Slave_Termios::begin(): cannot open ");
+      LIN_SLAVE_DEBUG_SERIAL.println(this->nameDevice);
+    #endif
+
+    // close device and disable node
+    if (this->fd >= 0)
+      close(this->fd);
+    this->fd = -1;
+    this->state = LIN_Slave_Base::STATE_OFF;
+    return;
+  }
+
+  // raw 8N1 mode. Mark bytes with framing or parity error incl. BREAK as 0xFF 0x00 x, escape data 0xFF as 0xFF 0xFF
+  tio.c_iflag &= ~(IGNBRK | BRKINT | IGNPAR | ISTRIP | INLCR | IGNCR | ICRNL | IXON | IXOFF | IXANY);
+  tio.c_iflag |= (PARMRK | INPCK);
+  tio.c_oflag &= ~OPOST;
+  tio.c_lflag &= ~(ECHO | ECHONL | ICANON | ISIG | IEXTEN);
+  tio.c_cflag &= ~(CSIZE | PARENB | CSTOPB | CRTSCTS);
+  tio.c_cflag |= (CS8 | CREAD | CLOCAL);
+
+  // read() returns all pending bytes without waiting. Note: VTIME granularity (100ms) is too coarse for LIN timing
+  tio.c_cc[VMIN]  = 0;
+  tio.c_cc[VTIME] = 0;
+  ioctl(this->fd, TCSETS2, &tio);
+
+  // set baudrate and discard stale data
+  this->_setBaudrate(this->baudrate);
+  ioctl(this->fd, TCFLSH, TCIOFLUSH);
+
+  // initialize variables
+  this->_resetBreakFlag();
+  this->idxRaw      = 0;
+  this->numRaw      = 0;
+  this->stateMark   = 0;
+  this->bytePending = -1;
+
+  // optional debug output (debug level 2)
+  #if defined(LIN_SLAVE_DEBUG_SERIAL) && (LIN_SLAVE_DEBUG_LEVEL >= 2)
+    LIN_SLAVE_DEBUG_SERIAL.print(this->nameLIN);
+    LIN_SLAVE_DEBUG_SERIAL.println(": LIN_Slave_Termios::begin()");
+  #endif
+
+} // LIN_Slave_Termios::begin()
+
+
+
+/**
+  \brief      Close serial interface
+  \details    Close serial device
+*/
+void LIN_Slave_Termios::end()
+{
+  // call base class method
+  LIN_Slave_Base::end();
+
+  // close serial device
+  if (this->fd >= 0)
+    close(this->fd);
+  this->fd = -1;
+
+  // optional debug output (debug level 2)
+  #if defined(LIN_SLAVE_DEBUG_SERIAL) && (LIN_SLAVE_DEBUG_LEVEL >= 2)
+    LIN_SLAVE_DEBUG_SERIAL.print(this->nameLIN);
+    LIN_SLAVE_DEBUG_SERIAL.println(": LIN_Slave_Termios::end()");
+  #endif
+
+} // LIN_Slave_Termios::end()
+
+#endif // __linux__
+
+/*-----------------------------------------------------------------------------
+    END OF FILE
+-----------------------------------------------------------------------------*/
@@ -0,0 +1,128 @@
+/**
+  \file     LIN_slave_Termios.h
+  \brief    LIN slave emulation library using a serial device via POSIX termios on Linux
+  \details  This library provides a slave node emulation for a LIN bus via a serial device on Linux, e.g. a USB-UART with LIN transceiver.
+            For an explanation of the LIN bus and protocol e.g. see https://en.wikipedia.org/wiki/Local_Interconnect_Network
+  \note     BREAK is detected via framing error marking of the tty driver (PARMRK), i.e. like the NeoHWSerial and ESP32 backends
+  \note     Requires an Arduino API layer for Linux which provides Arduino.h, e.g. the host shim in extras/host
+  \author   Georg Icking-Konert
+*/
+
+// assert Linux platform
+#if defined(__linux__)
+
+/*-----------------------------------------------------------------------------
+  MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _LIN_SLAVE_TERMIOS_H_
+#define _LIN_SLAVE_TERMIOS_H_
+
+
+/*-----------------------------------------------------------------------------
+  INCLUDE FILES
+-----------------------------------------------------------------------------*/
+
+// include required libraries
+#include <LIN_slave_Static.h>
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL MACROS
+-----------------------------------------------------------------------------*/
+
+/// Size of raw receive buffer, i.e. max. number of bytes fetched per read() call
+#if !defined(LIN_SLAVE_TERMIOS_BUFLEN)
+  #define LIN_SLAVE_TERMIOS_BUFLEN   64
+#endif
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL CLASS
+-----------------------------------------------------------------------------*/
+
+/**
+  \brief  LIN slave node class via Linux serial device
+
+  \details LIN slave node class via Linux serial device using POSIX termios.
+*/
+class LIN_Slave_Termios : public LIN_Slave_Static<LIN_Slave_Termios>
+{
+  // static binding of serial interface methods in handler()
+  friend class LIN_Slave_Static<LIN_Slave_Termios>;
+
+  // PROTECTED VARIABLES
+  protected:
+
+    const char            *nameDevice;                      //!< name of serial device, e.g. "/dev/ttyUSB0"
+    int                   fd;                               //!< file descriptor of serial device (-1 = closed)
+    uint8_t               bufRaw[LIN_SLAVE_TERMIOS_BUFLEN]; //!< raw received bytes incl. error marks (0xFF 0x00 x)
+    uint8_t               idxRaw;                           //!< index of next raw byte in bufRaw
+    uint8_t               numRaw;                           //!< number of raw bytes in bufRaw
+    uint8_t               stateMark;                        //!< decoder state for error marks (0=none, 1=0xFF, 2=0xFF 0x00)
+    int16_t               bytePending;                      //!< decoded data byte (-1 = none)
+    uint32_t              timeRead;                         //!< time [us] of last read(), i.e. receive time of buffered bytes
+
+
+  // PROTECTED METHODS
+  protected:
+
+    /// @brief Get break detection flag
+    bool _getBreakFlag(void);
+
+    /// @brief Clear break detection flag
+    void _resetBreakFlag(void);
+
+    /// @brief Decode next data byte or BREAK from raw receive buffer
+    bool _decodeByte(void);
+
+
+    /// @brief peek next byte from Rx buffer
+    inline uint8_t _serialPeek(void) { return (this->available()) ? (uint8_t) this->bytePending : 0x00; }
+
+    /// @brief read next byte from Rx buffer
+    inline uint8_t _serialRead(void)
+    {
+      uint8_t byteRx = this->_serialPeek();
+      this->bytePending = -1;
+      return byteRx;
+    }
+
+    /// @brief receive time [us] of next byte, i.e. time of read() which fetched it
+    inline uint32_t _getReceiveTime(void) { return this->timeRead; }
+
+    /// @brief write bytes to Tx buffer
+    void _serialWrite(uint8_t buf[], uint8_t num);
+
+    /// @brief Change baudrate of open serial interface, e.g. for auto-baud
+    virtual void _setBaudrate(uint32_t Baudrate);
+
+
+  // PUBLIC METHODS
+  public:
+
+    /// @brief Class constructor
+    LIN_Slave_Termios(const char Device[], LIN_Slave_Base::version_t Version = LIN_Slave_Base::LIN_V2, const char NameLIN[] = "Slave",
+      uint32_t TimeoutRx = 1500L, const int8_t PinTxEN = INT8_MIN);
+
+    /// @brief Open serial interface
+    void begin(uint32_t Baudrate = 19200);
+
+    /// @brief Close serial interface
+    void end(void);
+
+    /// @brief check if a byte is available in Rx buffer
+    inline bool available(void) { return (this->bytePending >= 0) || (this->_decodeByte()); }
+
+}; // class LIN_Slave_Termios
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _LIN_SLAVE_TERMIOS_H_
+
+#endif // __linux__
+
+/*-----------------------------------------------------------------------------
+    END OF FILE
+-----------------------------------------------------------------------------*/